@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <csignal>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "core/backtest_engine/backtest_daemon.h"
+#include "utils/config/config_reader.h"
+#include "utils/thread/thread_placement.h"
+
+namespace {
+core::backtest::BacktestDaemon *daemon_instance = nullptr;
+void signal_handler(int) {
+    if (daemon_instance != nullptr) daemon_instance->stop();
+}
+
+int usage() {
+    std::cerr << "Usage: backtest_daemon serve <socket> [cache_mb=1024] "
+                 "[thread_placement_config.txt]\n"
+                 "       backtest_daemon submit <socket> <job.txt> "
+                 "[key=value ...]\n";
+    return 2;
+}
+} // namespace
+
+// Keeps decoded tapes of recently used datasets in memory and runs grid
+// trading backtests sent over a Unix socket; `submit` sends one job and
+// prints the daemon's reply as it streams in.
+int main(int argc, char *argv[]) {
+    if (argc < 3) return usage();
+    const std::string mode = argv[1];
+    try {
+        if (mode == "serve") {
+            core::backtest::BacktestDaemonConfig config;
+            config.socket_path_ = argv[2];
+            if (argc > 3) {
+                config.cache_bytes_ = std::stoull(argv[3]) << 20;
+            }
+            if (argc > 4) {
+                utils::config::ConfigReader config_reader;
+                utils::thread::set_thread_placement_config(
+                    config_reader.get_thread_placement_config(argv[4]));
+            }
+            core::backtest::BacktestDaemon daemon(config);
+            daemon_instance = &daemon;
+            std::signal(SIGINT, signal_handler);
+            std::signal(SIGTERM, signal_handler);
+            std::cout << "Serving backtests on " << config.socket_path_
+                      << " with a " << (config.cache_bytes_ >> 20)
+                      << " MB tape cache" << std::endl;
+            daemon.serve();
+            std::cout << "Stopping; waiting for running jobs" << std::endl;
+            return 0;
+        }
+        if (mode == "submit" && argc > 3) {
+            std::ifstream file(argv[3]);
+            if (!file.is_open()) {
+                std::cerr << "Failed to open job file: " << argv[3] << "\n";
+                return 2;
+            }
+            std::ostringstream job;
+            job << file.rdbuf() << '\n';
+            for (int i = 4; i < argc; ++i) job << argv[i] << '\n';
+            bool failed = false;
+            core::backtest::submit_backtest_job(
+                argv[2], job.str(), [&](const std::string &line) {
+                    failed = failed || line.rfind("error ", 0) == 0;
+                    std::cout << line << std::endl;
+                });
+            return failed ? 1 : 0;
+        }
+        return usage();
+    } catch (const std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 2;
+    }
+}
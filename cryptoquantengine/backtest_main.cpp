@@ -18,6 +18,8 @@
 #include "utils/config/config_reader.h"
 #include "utils/logger/log_level.h"
 #include "utils/logger/logger.h"
+#include "utils/thread/thread_placement.h"
+#include "utils/trace/tracer.h"
 
 int main(int argc, char *argv[]) {
     try {
@@ -32,6 +34,8 @@ int main(int argc, char *argv[]) {
             (argc > 4) ? argv[4] : "../config/recorder_config.txt";
         std::string bt_cfg =
             (argc > 5) ? argv[5] : "../config/backtest_config.txt";
+        // optional: pins the engine's threads (see thread_placement_config.txt)
+        std::string thread_cfg = (argc > 6) ? argv[6] : "";
 
         // Initialize logger
         /* auto logger = std::make_shared<utils::logger::Logger>(
@@ -48,6 +52,12 @@ int main(int argc, char *argv[]) {
         const auto recorder_config =
             config_reader.get_recorder_config(recorder_cfg);
         const auto backtest_config = config_reader.get_backtest_config(bt_cfg);
+        if (!thread_cfg.empty()) {
+            utils::thread::set_thread_placement_config(
+                config_reader.get_thread_placement_config(thread_cfg));
+        }
+        utils::thread::place_current_thread(utils::thread::ThreadRole::Sim,
+                                            "sim");
 
         // Asset setup (single asset example)
         const int asset_id = 1;
@@ -66,13 +76,20 @@ int main(int argc, char *argv[]) {
         std::uint64_t iter = backtest_config.iterations;
         while (engine.elapse(backtest_config.elapse_us) && iter-- > 0) {
             engine.clear_inactive_orders();
-            grid_trading.on_elapse(engine);
+            {
+                utils::trace::TraceScope scope(
+                    utils::trace::TraceEventType::StrategyCallback,
+                    engine.current_time());
+                grid_trading.on_elapse(engine);
+            }
             recorder.record(engine, asset_id);
         }
         const auto end = std::chrono::high_resolution_clock::now();
         const std::chrono::duration<double> elapsed = end - start;
 
         // Results
+        std::cout << "Thread layout:\n"
+                  << utils::thread::format_thread_layout();
         std::cout << "Backtest wall time: " << elapsed.count() << " seconds\n";
         std::cout << "Final equity: " << std::fixed << std::setprecision(2)
                   << engine.equity() << "\n";
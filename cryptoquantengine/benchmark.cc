@@ -6,16 +6,79 @@
  */
 
 #include <chrono>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "core/backtest_engine/backtest_engine.h"
 #include "core/recorder/recorder.h"
+#include "core/strategy/grid_trading/grid_trading.h"
+#include "core/strategy/grid_trading/rebuild_grid_trading.h"
+#include "core/strategy/strategy.h"
 #include "utils/config/config_reader.h"
 #include "utils/logger/log_level.h"
 #include "utils/logger/logger.h"
+#include "utils/memory/huge_page_resource.h"
+#include "utils/memory/run_arena.h"
+#include "utils/thread/thread_placement.h"
+#include "utils/trace/tracer.h"
+
+namespace {
+// counts data-TLB load misses of this process while alive (Linux perf events)
+class DtlbMissCounter {
+  public:
+    DtlbMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    ~DtlbMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    // nullopt when the counter is unavailable (no PMU access, non-Linux)
+    std::optional<std::uint64_t> read() const {
+#if defined(__linux__)
+        std::uint64_t count = 0;
+        if (fd_ >= 0 && ::read(fd_, &count, sizeof(count)) == sizeof(count)) {
+            return count;
+        }
+#endif
+        return std::nullopt;
+    }
+
+  private:
+    int fd_ = -1;
+};
+} // namespace
 
 int main(int argc, char **argv) {
     std::string asset_cfg = (argc > 1) ? argv[1] : "../config/asset_config.txt";
@@ -26,6 +89,16 @@ int main(int argc, char **argv) {
     std::string recorder_cfg =
         (argc > 4) ? argv[4] : "../config/recorder_config.txt";
     std::string bt_cfg = (argc > 5) ? argv[5] : "../config/backtest_config.txt";
+    // engine: engine + recorder only
+    // runtime: grid trading through the virtual Strategy interface
+    // rebuild: runtime with the previous, grid-rebuilding GridTrading
+    std::string mode = (argc > 6) ? argv[6] : "engine";
+    // default: engine containers use the global heap
+    // arena: engine containers use a RunArena
+    // hugepage: the RunArena is backed by 2 MB huge pages
+    std::string alloc = (argc > 7) ? argv[7] : "default";
+    // optional thread placement config, for low-jitter runs
+    std::string thread_cfg = (argc > 8) ? argv[8] : "";
 
     auto logger = nullptr;
 
@@ -37,24 +110,85 @@ int main(int argc, char **argv) {
     const auto recorder_config =
         config_reader.get_recorder_config(recorder_cfg);
     const auto backtest_config = config_reader.get_backtest_config(bt_cfg);
-    
+    const auto grid_trading_config =
+        config_reader.get_grid_trading_config(grid_cfg);
+    if (!thread_cfg.empty()) {
+        utils::thread::set_thread_placement_config(
+            config_reader.get_thread_placement_config(thread_cfg));
+    }
+    utils::thread::place_current_thread(utils::thread::ThreadRole::Sim, "sim");
+
     const int asset_id{1};
     const std::unordered_map<int, core::trading::AssetConfig> asset_configs = {{asset_id, asset_config}};
-    
-    core::backtest::BacktestEngine engine(asset_configs, backtest_engine_config,
-                                          logger);
-    core::recorder::Recorder recorder(recorder_config.interval_us, logger);
+
+    utils::memory::HugePageResource huge_pages;
+    std::optional<utils::memory::RunArena> arena;
+    if (alloc == "arena") {
+        arena.emplace(std::size_t{64} << 20);
+    } else if (alloc == "hugepage") {
+        arena.emplace(std::size_t{64} << 20, &huge_pages);
+    }
+    std::pmr::memory_resource *resource =
+        arena ? arena->resource() : std::pmr::get_default_resource();
+
+    core::recorder::Recorder recorder(recorder_config.interval_us, logger,
+                                      resource);
+    DtlbMissCounter dtlb_misses;
+    core::backtest::BacktestEngine engine(
+        asset_configs, backtest_engine_config, logger, resource);
+    std::unique_ptr<core::strategy::Strategy> strategy;
+    if (mode == "runtime") {
+        strategy = std::make_unique<core::strategy::GridTrading>(
+            asset_id, grid_trading_config);
+    } else if (mode == "rebuild") {
+        strategy = std::make_unique<core::strategy::RebuildGridTrading>(
+            asset_id, grid_trading_config);
+    }
     // backtest loop
+    std::chrono::duration<double> strategy_time{};
     const auto start = std::chrono::high_resolution_clock::now();
     std::uint64_t iter = backtest_config.iterations;
     while (engine.elapse(backtest_config.elapse_us) && iter-- > 0) {
         engine.clear_inactive_orders();
+        if (strategy) {
+            utils::trace::TraceScope scope(
+                utils::trace::TraceEventType::StrategyCallback,
+                engine.current_time());
+            const auto callback_start =
+                std::chrono::high_resolution_clock::now();
+            strategy->on_elapse(engine);
+            strategy_time +=
+                std::chrono::high_resolution_clock::now() - callback_start;
+        }
         recorder.record(engine, asset_id);
     }
-    const auto end = std::chrono::high_resolution_clock::now();
-    const std::chrono::duration<double> elapsed = end - start;
+    const std::chrono::duration<double> elapsed =
+        std::chrono::high_resolution_clock::now() - start;
 
-    std::cout << "Benchmark wall time: " << elapsed.count() << " seconds\n";
+    const auto misses = dtlb_misses.read();
+    std::cout << "Thread layout:\n" << utils::thread::format_thread_layout();
+    std::cout << "Benchmark (" << mode << ", " << alloc
+              << ") wall time: " << elapsed.count() << " seconds\n";
+    if (mode == "runtime" || mode == "rebuild") {
+        std::cout << "Strategy callback time: " << strategy_time.count()
+                  << " seconds\n";
+    }
+    if (misses) {
+        std::cout << "dTLB load misses: " << *misses << "\n";
+    } else {
+        std::cout << "dTLB load misses: unavailable\n";
+    }
+    if (alloc == "hugepage") {
+        std::cout << "Huge page backing: "
+                  << (huge_pages.last_backing() ==
+                              utils::memory::PageBacking::Explicit
+                          ? "explicit (MAP_HUGETLB)"
+                          : huge_pages.last_backing() ==
+                                    utils::memory::PageBacking::Transparent
+                                ? "transparent (MADV_HUGEPAGE)"
+                                : "none")
+                  << "\n";
+    }
 
     return 0;
 }
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "core/market_data/book_checkpoint.h"
+#include "utils/config/config_reader.h"
+
+// Replays an asset's book file once and writes a side-car of reconstructed
+// book checkpoints; set book_checkpoint_file in the asset config and
+// start_time_us in the engine config to start a backtest mid-day from them.
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: book_checkpoint <asset_config.txt> "
+                     "<interval_minutes> [output_file]\n";
+        return 2;
+    }
+    try {
+        utils::config::ConfigReader config_reader;
+        const auto asset_config = config_reader.get_asset_config(argv[1]);
+        const Microseconds interval_us =
+            std::stoull(argv[2]) * 60ull * 1'000'000ull;
+        const std::string output =
+            (argc > 3) ? argv[3] : asset_config.book_update_file_ + ".ckpt";
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto written = core::market_data::write_book_checkpoints(
+            asset_config.book_update_file_, asset_config.trade_file_,
+            asset_config.tick_size_, asset_config.lot_size_, interval_us,
+            output);
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::cout << "Wrote " << written << " checkpoints to " << output
+                  << " in " << elapsed.count() << " seconds\n";
+        return 0;
+    } catch (const std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 2;
+    }
+}
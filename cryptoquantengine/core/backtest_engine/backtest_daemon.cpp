@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../../utils/config/config_reader.h"
+#include "../../utils/thread/task_pool.h"
+#include "../recorder/recorder.h"
+#include "../strategy/grid_trading/grid_trading.h"
+#include "backtest_daemon.h"
+#include "backtest_engine.h"
+
+namespace core::backtest {
+namespace {
+constexpr std::size_t kMaxJobBytes = 64 * 1024;
+
+std::runtime_error socket_error(const std::string &what,
+                                const std::string &path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+sockaddr_un socket_address(const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Invalid socket path: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+void send_line(int fd, const std::string &line) {
+    const std::string data = line + '\n';
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n =
+            send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw std::runtime_error("Client disconnected");
+        sent += static_cast<std::size_t>(n);
+    }
+}
+
+// a connection whose job has not fully arrived yet
+struct PendingJob {
+    int fd_;
+    std::chrono::steady_clock::time_point deadline_;
+    std::string text_;
+};
+
+// reads what the client has sent so far without blocking; true once the job
+// is complete, i.e. at a blank line or when the client shuts down writing
+bool receive_job(PendingJob &pending) {
+    char buffer[4096];
+    while (pending.text_.find("\n\n") == std::string::npos) {
+        const ssize_t n =
+            recv(pending.fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return false;
+        if (n < 0) throw std::runtime_error("Client disconnected");
+        if (n == 0) break;
+        pending.text_.append(buffer, static_cast<std::size_t>(n));
+        if (pending.text_.size() > kMaxJobBytes) {
+            throw std::invalid_argument("Job exceeds " +
+                                        std::to_string(kMaxJobBytes) +
+                                        " bytes");
+        }
+    }
+    pending.text_ = pending.text_.substr(0, pending.text_.find("\n\n"));
+    return true;
+}
+
+void send_error(int fd, const std::exception &e) {
+    try {
+        send_line(fd, std::string("error ") + e.what());
+    } catch (const std::exception &) {
+        // the client is gone
+    }
+}
+
+std::string take(const BacktestJob &job, const std::string &key) {
+    const auto it = job.find(key);
+    if (it == job.end()) {
+        throw std::invalid_argument("Job lacks required key: " + key);
+    }
+    return it->second;
+}
+
+// applies one override to the configs; false if the key is not one
+bool apply_override(const std::string &key, const std::string &value,
+                    core::strategy::GridTradingConfig &grid,
+                    BacktestConfig &backtest) {
+    if (key == "grid_num") {
+        grid.grid_num_ = std::stoi(value);
+    } else if (key == "grid_interval") {
+        grid.grid_interval_ = static_cast<Ticks>(std::stoull(value));
+    } else if (key == "half_spread") {
+        grid.half_spread_ = static_cast<Ticks>(std::stoull(value));
+    } else if (key == "position_limit") {
+        grid.position_limit_ = std::stod(value);
+    } else if (key == "notional_order_qty") {
+        grid.notional_order_qty_ = std::stod(value);
+    } else if (key == "elapse_us") {
+        backtest.elapse_us = std::stoull(value);
+    } else if (key == "iterations") {
+        backtest.iterations = std::stoull(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// a recorder metric, or nan when there are too few records for it
+template <typename Metric> double metric_or_nan(Metric &&metric) {
+    try {
+        return metric();
+    } catch (const std::exception &) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+} // namespace
+
+/**
+ * @brief Binds and listens on the configured socket path, replacing a stale
+ * socket file left there by an earlier daemon.
+ *
+ * @throws std::invalid_argument if the path does not fit a Unix socket
+ * address.
+ * @throws std::runtime_error if the socket cannot be created or bound.
+ */
+BacktestDaemon::BacktestDaemon(BacktestDaemonConfig config)
+    : config_(std::move(config)),
+      cache_(config_.cache_bytes_, config_.compress_tape_) {
+    const sockaddr_un address = socket_address(config_.socket_path_);
+    if (pipe(stop_pipe_) != 0) {
+        throw socket_error("Failed to create stop pipe for",
+                           config_.socket_path_);
+    }
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        throw socket_error("Failed to create socket", config_.socket_path_);
+    }
+    unlink(config_.socket_path_.c_str());
+    if (bind(listen_fd_, reinterpret_cast<const sockaddr *>(&address),
+             sizeof(address)) != 0 ||
+        listen(listen_fd_, 16) != 0) {
+        const auto error = socket_error("Failed to listen on",
+                                        config_.socket_path_);
+        close(listen_fd_);
+        close(stop_pipe_[0]);
+        close(stop_pipe_[1]);
+        throw error;
+    }
+}
+
+/**
+ * @brief Waits for accepted jobs to finish, then closes and removes the
+ * socket.
+ */
+BacktestDaemon::~BacktestDaemon() {
+    {
+        std::unique_lock<std::mutex> lock(jobs_mutex_);
+        jobs_done_.wait(lock, [this] { return running_jobs_ == 0; });
+    }
+    close(listen_fd_);
+    unlink(config_.socket_path_.c_str());
+    close(stop_pipe_[0]);
+    close(stop_pipe_[1]);
+}
+
+/**
+ * @brief Accepts connections until stop() is called.
+ *
+ * Connections whose job has not fully arrived are polled together with the
+ * listening socket, so a slow client never delays another one. A client has
+ * `request_timeout_ms_` from its connection to send its job; a complete job
+ * is handed to the shared task pool as a low-priority task, and with no pool
+ * workers it runs on the calling thread before the next poll. Connections
+ * still sending their job when the daemon stops get an error.
+ */
+void BacktestDaemon::serve() {
+    using Clock = std::chrono::steady_clock;
+    std::vector<PendingJob> pending;
+    std::vector<pollfd> fds;
+    auto drop = [](const PendingJob &job, const std::exception &e) {
+        send_error(job.fd_, e);
+        close(job.fd_);
+    };
+    while (true) {
+        fds.assign({{listen_fd_, POLLIN, 0}, {stop_pipe_[0], POLLIN, 0}});
+        int timeout_ms = -1;
+        const auto now = Clock::now();
+        for (const auto &job : pending) {
+            fds.push_back({job.fd_, POLLIN, 0});
+            const auto left =
+                std::chrono::ceil<std::chrono::milliseconds>(job.deadline_ -
+                                                             now);
+            const int left_ms =
+                static_cast<int>(std::max<std::int64_t>(left.count(), 0));
+            timeout_ms = timeout_ms < 0 ? left_ms : std::min(timeout_ms,
+                                                             left_ms);
+        }
+        if (poll(fds.data(), fds.size(), timeout_ms) < 0) {
+            if (errno == EINTR) continue;
+            throw socket_error("Failed to poll", config_.socket_path_);
+        }
+        if (fds[1].revents != 0) {
+            for (const auto &job : pending) {
+                drop(job, std::runtime_error("Daemon is stopping"));
+            }
+            return;
+        }
+
+        // pending[i] is fds[i + 2]; walk back so erasing keeps that pairing
+        for (std::size_t i = pending.size(); i-- > 0;) {
+            auto &job = pending[i];
+            try {
+                if (fds[i + 2].revents == 0) {
+                    if (Clock::now() < job.deadline_) continue;
+                    throw std::runtime_error("Timed out waiting for the job");
+                }
+                if (!receive_job(job)) continue;
+                start_job(job.fd_, parse_backtest_job(job.text_));
+            } catch (const std::exception &e) {
+                drop(job, e);
+            }
+            pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+
+        if ((fds[0].revents & POLLIN) != 0) {
+            const int fd = accept(listen_fd_, nullptr, nullptr);
+            if (fd >= 0) {
+                pending.push_back(PendingJob{
+                    fd,
+                    Clock::now() +
+                        std::chrono::milliseconds(config_.request_timeout_ms_),
+                    {}});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Queues a received job on the shared task pool; the connection is
+ * closed once the job has finished.
+ */
+void BacktestDaemon::start_job(int fd, BacktestJob job) {
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        ++running_jobs_;
+    }
+    utils::thread::TaskPool::instance().submit(
+        [this, fd, job = std::move(job)] {
+            handle_connection(fd, job);
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            if (--running_jobs_ == 0) jobs_done_.notify_all();
+        },
+        utils::thread::TaskPriority::Low);
+}
+
+/**
+ * @brief Makes serve() return; jobs already accepted still run to the end.
+ */
+void BacktestDaemon::stop() {
+    const char byte = 0;
+    [[maybe_unused]] const ssize_t n = write(stop_pipe_[1], &byte, 1);
+}
+
+void BacktestDaemon::handle_connection(int fd, const BacktestJob &job) {
+    try {
+        run_job(job, [fd](const std::string &line) { send_line(fd, line); });
+        send_line(fd, "done");
+    } catch (const std::exception &e) {
+        send_error(fd, e);
+    }
+    close(fd);
+}
+
+/**
+ * @brief Runs one grid trading backtest, as backtest_main does, replaying
+ * the asset's data from the tape cache.
+ *
+ * Required keys name the config files: asset_config, grid_trading_config,
+ * backtest_engine_config and backtest_config; recorder_config is optional.
+ * grid_num, grid_interval, half_spread, position_limit, notional_order_qty,
+ * elapse_us and iterations override the files' values, and
+ * progress_iterations sets how often a progress line is written (default:
+ * every tenth of the run, 0 = never).
+ *
+ * Writes an `accepted` line once the tape is loaded, `progress` lines while
+ * running, then `result` and `elapsed` lines, each as space-separated
+ * key=value pairs.
+ *
+ * @throws std::invalid_argument for a missing or unknown key, or an engine
+ * config that traces events or hashes state (concurrent jobs would share
+ * the output files).
+ */
+void BacktestDaemon::run_job(const BacktestJob &job, const JobOutput &out) {
+    const auto start = std::chrono::steady_clock::now();
+    utils::config::ConfigReader config_reader;
+    const auto asset_config =
+        config_reader.get_asset_config(take(job, "asset_config"));
+    auto grid_config =
+        config_reader.get_grid_trading_config(take(job, "grid_trading_config"));
+    const auto engine_config = config_reader.get_backtest_engine_config(
+        take(job, "backtest_engine_config"));
+    auto backtest_config =
+        config_reader.get_backtest_config(take(job, "backtest_config"));
+    RecorderConfig recorder_config;
+    if (job.count("recorder_config") != 0) {
+        recorder_config =
+            config_reader.get_recorder_config(job.at("recorder_config"));
+    }
+    std::optional<std::uint64_t> progress;
+    for (const auto &[key, value] : job) {
+        if (key == "asset_config" || key == "grid_trading_config" ||
+            key == "backtest_engine_config" || key == "backtest_config" ||
+            key == "recorder_config") {
+            continue;
+        }
+        if (key == "progress_iterations") {
+            progress = std::stoull(value);
+        } else if (!apply_override(key, value, grid_config,
+                                   backtest_config)) {
+            throw std::invalid_argument("Unknown job key: " + key);
+        }
+    }
+    const std::uint64_t progress_iterations =
+        progress.value_or(backtest_config.iterations / 10);
+    if (!engine_config.trace_file_.empty() ||
+        engine_config.state_hash_interval_ > 0) {
+        throw std::invalid_argument(
+            "Daemon jobs cannot trace events or hash state: concurrent jobs "
+            "would share the output files");
+    }
+
+    const int asset_id = 1;
+    bool hit = false;
+    const auto tape = cache_.get(asset_id, asset_config,
+                                 engine_config.aggregate_trades_, &hit);
+    const auto stats = cache_.stats();
+    std::ostringstream line;
+    line << "accepted cache=" << (hit ? "hit" : "miss")
+         << " tape_bytes=" << (tape ? tape->bytes() : 0)
+         << " cache_bytes=" << stats.bytes_
+         << " cache_entries=" << stats.entries_;
+    out(line.str());
+    const auto loaded = std::chrono::steady_clock::now();
+
+    const std::unordered_map<int, core::trading::AssetConfig> asset_configs =
+        {{asset_id, asset_config}};
+    BacktestEngine engine(asset_configs, engine_config, nullptr,
+                          std::pmr::get_default_resource(), tape.get());
+    core::recorder::Recorder recorder(recorder_config.interval_us);
+    core::strategy::GridTrading grid_trading(asset_id, grid_config);
+    std::uint64_t iteration = 0;
+    while (iteration < backtest_config.iterations &&
+           engine.elapse(backtest_config.elapse_us)) {
+        engine.clear_inactive_orders();
+        grid_trading.on_elapse(engine);
+        recorder.record(engine, asset_id);
+        ++iteration;
+        if (progress_iterations > 0 && iteration % progress_iterations == 0) {
+            line.str("");
+            line << "progress iteration=" << iteration
+                 << " time=" << engine.current_time()
+                 << " equity=" << engine.equity()
+                 << " position=" << engine.position(asset_id);
+            out(line.str());
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    line.str("");
+    line << "result iterations=" << iteration
+         << " equity=" << engine.equity()
+         << " position=" << engine.position(asset_id) << " sharpe="
+         << metric_or_nan([&] { return recorder.sharpe(); }) << " sortino="
+         << metric_or_nan([&] { return recorder.sortino(); })
+         << " max_drawdown="
+         << metric_or_nan([&] { return recorder.max_drawdown(); });
+    out(line.str());
+    line.str("");
+    line << "elapsed load_seconds="
+         << std::chrono::duration<double>(loaded - start).count()
+         << " run_seconds="
+         << std::chrono::duration<double>(end - loaded).count();
+    out(line.str());
+}
+
+/**
+ * @brief Parses a job's key=value lines; blank lines and lines starting with
+ * `#` are skipped, and a later key overrides an earlier one.
+ *
+ * @throws std::invalid_argument for a line without `=`.
+ */
+BacktestJob parse_backtest_job(const std::string &text) {
+    BacktestJob job;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        const std::size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            throw std::invalid_argument("Job line is not key=value: " + line);
+        }
+        job[line.substr(0, equals)] = line.substr(equals + 1);
+    }
+    return job;
+}
+
+/**
+ * @brief Sends @p job (key=value lines) to the daemon at @p socket_path and
+ * passes each line of its reply to @p out until the daemon closes the
+ * connection. The last line is `done`, or `error <reason>`.
+ *
+ * @throws std::runtime_error if the daemon cannot be reached.
+ */
+void submit_backtest_job(const std::string &socket_path,
+                         const std::string &job, const JobOutput &out) {
+    const sockaddr_un address = socket_address(socket_path);
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw socket_error("Failed to create socket", socket_path);
+    if (connect(fd, reinterpret_cast<const sockaddr *>(&address),
+                sizeof(address)) != 0) {
+        const auto error = socket_error("Failed to connect to", socket_path);
+        close(fd);
+        throw error;
+    }
+    // blank lines would end the job early
+    std::string request;
+    std::istringstream in(job);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line != "\r") request += line + '\n';
+    }
+    try {
+        send_line(fd, request);
+        shutdown(fd, SHUT_WR);
+    } catch (const std::exception &) {
+        close(fd);
+        throw std::runtime_error("Daemon closed the connection: " +
+                                 socket_path);
+    }
+
+    std::string pending;
+    char buffer[4096];
+    while (true) {
+        const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        pending.append(buffer, static_cast<std::size_t>(n));
+        std::size_t newline;
+        while ((newline = pending.find('\n')) != std::string::npos) {
+            out(pending.substr(0, newline));
+            pending.erase(0, newline + 1);
+        }
+    }
+    close(fd);
+    if (!pending.empty()) out(pending);
+}
+} // namespace core::backtest
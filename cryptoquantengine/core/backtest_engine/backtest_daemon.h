@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "tape_cache.h"
+
+namespace core::backtest {
+struct BacktestDaemonConfig {
+    std::string socket_path_;
+    std::size_t cache_bytes_ = std::size_t{1} << 30; // TapeCache budget
+    bool compress_tape_ = true;
+    int request_timeout_ms_ = 5000; // for a client to send its whole job
+};
+
+// a job: key=value pairs, as in the config files (see backtest_daemon.cpp)
+using BacktestJob = std::unordered_map<std::string, std::string>;
+// receives the job's output one line at a time, without the newline
+using JobOutput = std::function<void(const std::string &line)>;
+
+/**
+ * @brief Serves backtest jobs over a local Unix socket, replaying datasets
+ * from a shared TapeCache so repeated jobs skip parsing the data files.
+ *
+ * Each connection carries one job. Jobs still arriving are polled together on
+ * the accepting thread, each within its own deadline, and only a complete
+ * job runs as a low-priority task on the shared task pool. Jobs run
+ * concurrently up to the pool's size, and a slow or idle client neither
+ * holds a pool worker nor delays other clients.
+ */
+class BacktestDaemon {
+  public:
+    explicit BacktestDaemon(BacktestDaemonConfig config);
+    ~BacktestDaemon();
+    BacktestDaemon(const BacktestDaemon &) = delete;
+    BacktestDaemon &operator=(const BacktestDaemon &) = delete;
+
+    void serve();
+    void stop(); // async-signal-safe
+
+    void run_job(const BacktestJob &job, const JobOutput &out);
+
+    const TapeCache &cache() const { return cache_; }
+
+  private:
+    void start_job(int fd, BacktestJob job);
+    void handle_connection(int fd, const BacktestJob &job);
+
+    BacktestDaemonConfig config_;
+    TapeCache cache_;
+    int listen_fd_ = -1;
+    int stop_pipe_[2] = {-1, -1};
+    std::mutex jobs_mutex_;
+    std::condition_variable jobs_done_;
+    int running_jobs_ = 0; // connections queued or running on the pool
+};
+
+BacktestJob parse_backtest_job(const std::string &text);
+void submit_backtest_job(const std::string &socket_path,
+                         const std::string &job, const JobOutput &out);
+} // namespace core::backtest
@@ -5,16 +5,22 @@
  * associated with this software.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <map>
 #include <optional>
 #include <unordered_map>
 
+#include "../../utils/hash/hash_utils.h"
 #include "../../utils/logger/log_level.h"
 #include "../../utils/logger/logger.h"
 #include "../../utils/math/math_utils.h"
+#include "../../utils/trace/trace_export.h"
+#include "../../utils/trace/tracer.h"
+#include "../market_data/book_checkpoint.h"
 #include "../market_data/market_data_feed.h"
+#include "../strategy/strategy.h"
 #include "../trading/asset_config.h"
 #include "../trading/depth.h"
 #include "../types/enums/action_type.h"
@@ -38,6 +44,13 @@ namespace core::backtest {
  * events.
  * @param asset_configs A map from asset ID to AssetConfig objects defining tick
  * size, lot size, etc.
+ * @param resource Memory resource for the engine's books, order lookups and
+ * delayed action queue. Sweep workers pass a per-run arena (see
+ * utils::memory::RunArena) so everything the run allocated is released in
+ * one step once the engine is destroyed.
+ * @param tape Decoded market data to replay instead of reading the book and
+ * trade files of L2 assets it covers (see SweepRunner). Must outlive the
+ * engine; book checkpoints are not used for tape-backed assets.
  *
  * @note All assets in @p asset_configs are expected to have corresponding
  * entries in @p book_files. Trade file entries are optional but recommended.
@@ -45,29 +58,79 @@ namespace core::backtest {
 BacktestEngine::BacktestEngine(
     const std::unordered_map<int, core::trading::AssetConfig> &asset_configs,
     const core::backtest::BacktestEngineConfig &engine_config,
-    std::shared_ptr<utils::logger::Logger> logger)
-    : current_time_us_(0), local_cash_balance_(engine_config.initial_cash_),
-      logger_(logger) {
+    std::shared_ptr<utils::logger::Logger> logger,
+    std::pmr::memory_resource *resource,
+    const core::market_data::EventTape *tape)
+    : current_time_us_(0), execution_engine_(logger, resource),
+      local_cash_balance_(engine_config.initial_cash_),
+      delayed_actions_(resource), logger_(logger),
+      trace_file_(engine_config.trace_file_) {
     using namespace core::market_data;
     using namespace core::backtest;
     order_entry_latency_us = engine_config.order_entry_latency_us_;
     order_response_latency_us = engine_config.order_response_latency_us_;
     market_feed_latency_us = engine_config.market_feed_latency_us_;
 
-    execution_engine_ = core::execution_engine::ExecutionEngine(logger_);
     execution_engine_.set_order_entry_latency_us(order_entry_latency_us);
     execution_engine_.set_order_response_latency_us(order_response_latency_us);
+    market_data_feed_.set_trade_aggregation(engine_config.aggregate_trades_);
+    if (engine_config.state_hash_interval_ > 0) {
+        state_hasher_ = std::make_unique<StateHasher>(
+            engine_config.state_hash_interval_, engine_config.state_hash_file_);
+    }
+    if (!trace_file_.empty()) utils::trace::Tracer::instance().start();
 
     for (const auto &[asset_id, config] : asset_configs) {
         using namespace core::orderbook;
 
         assets_.emplace(asset_id, BacktestAsset(config));
-        execution_engine_.add_asset(asset_id, config.tick_size_,
-                                    config.lot_size_);
-        market_data_feed_.add_stream(asset_id, config.book_update_file_,
-                                     config.trade_file_);
-        local_orderbooks_.emplace(
-            asset_id, OrderBook(config.tick_size_, config.lot_size_, logger_));
+        if (!config.quote_file_.empty()) {
+            execution_engine_.add_bbo_asset(asset_id, config.tick_size_,
+                                            config.lot_size_);
+            market_data_feed_.add_quote_stream(asset_id, config.quote_file_,
+                                               config.trade_file_);
+            local_tops_.emplace(
+                asset_id,
+                LocalTopOfBook{
+                    .book_ = TopOfBook(config.tick_size_, config.lot_size_),
+                    .pending_ = {}});
+        } else {
+            if (config.order_file_.empty()) {
+                execution_engine_.add_asset(asset_id, config.tick_size_,
+                                            config.lot_size_);
+                const AssetTape *asset_tape =
+                    tape ? tape->asset(asset_id) : nullptr;
+                std::optional<BookCheckpoint> checkpoint;
+                if (!asset_tape && !config.book_checkpoint_file_.empty() &&
+                    engine_config.start_time_us_ > 0) {
+                    checkpoint = find_book_checkpoint(
+                        config.book_checkpoint_file_,
+                        engine_config.start_time_us_);
+                }
+                if (asset_tape) {
+                    market_data_feed_.add_tape_stream(asset_id, *asset_tape);
+                } else if (checkpoint) {
+                    market_data_feed_.add_stream(asset_id,
+                                                 config.book_update_file_,
+                                                 config.trade_file_,
+                                                 *checkpoint);
+                } else {
+                    market_data_feed_.add_stream(
+                        asset_id, config.book_update_file_, config.trade_file_);
+                }
+                if (market_data_feed_.verified(asset_id)) {
+                    execution_engine_.orderbook(asset_id).set_row_checks(false);
+                }
+            } else {
+                execution_engine_.add_mbo_asset(asset_id, config.tick_size_,
+                                                config.lot_size_);
+                market_data_feed_.add_mbo_stream(asset_id, config.order_file_,
+                                                 config.trade_file_);
+            }
+            local_orderbooks_.emplace(
+                asset_id,
+                LaggedBookView(execution_engine_.orderbook(asset_id)));
+        }
 
         num_trades_[asset_id] = 0;
         trading_volume_[asset_id] = 0.0;
@@ -99,6 +162,25 @@ BacktestEngine::BacktestEngine(
     }
 }
 
+/**
+ * @brief Writes a final state hash checkpoint covering the events processed
+ * since the last one, and dumps the event trace if one was requested.
+ */
+BacktestEngine::~BacktestEngine() {
+    if (state_hasher_ && state_hasher_->has_pending_events()) {
+        state_hasher_->checkpoint(current_time_us_, state_digest());
+    }
+    if (!trace_file_.empty()) {
+        auto &tracer = utils::trace::Tracer::instance();
+        tracer.stop();
+        try {
+            utils::trace::write_trace(tracer.records(), trace_file_);
+        } catch (const std::exception &e) {
+            std::cerr << "[BacktestEngine] - " << e.what() << std::endl;
+        }
+    }
+}
+
 /**
  * @brief Advances the simulated clock and processes all events and delayed
  * actions.
@@ -120,10 +202,10 @@ BacktestEngine::BacktestEngine(
  */
 bool BacktestEngine::elapse(std::uint64_t microseconds) {
     using namespace core::market_data;
-    EventType event_type;
-    BookUpdate book_update;
-    Trade trade;
-    int asset_id;
+    using utils::trace::TraceEventType;
+    utils::trace::TraceScope trace_scope(TraceEventType::Elapse,
+                                         current_time_us_);
+    auto &event = market_event_;
     auto next_interval_us = current_time_us_ + microseconds;
     while (current_time_us_ < next_interval_us) {
         auto next_event_us_opt = market_data_feed_.peek_timestamp();
@@ -139,29 +221,53 @@ bool BacktestEngine::elapse(std::uint64_t microseconds) {
             switch (action.type_) {
             // exchange events
             case ActionType::SubmitBuy:
+                utils::trace::trace_event(TraceEventType::ExchangeReceive,
+                                          current_time_us_, action.asset_id_,
+                                          action.order_->orderId_);
                 execution_engine_.execute_order(action.asset_id_,
                                                 TradeSide::Buy, *action.order_);
                 break;
             case ActionType::SubmitSell:
+                utils::trace::trace_event(TraceEventType::ExchangeReceive,
+                                          current_time_us_, action.asset_id_,
+                                          action.order_->orderId_);
                 execution_engine_.execute_order(
                     action.asset_id_, TradeSide::Sell, *action.order_);
                 break;
             case ActionType::Cancel:
+                utils::trace::trace_event(TraceEventType::ExchangeReceive,
+                                          current_time_us_, action.asset_id_,
+                                          *action.orderId_);
                 execution_engine_.cancel_order(
                     action.asset_id_, *action.orderId_, current_time_us_);
                 break;
+            case ActionType::Expire:
+                execution_engine_.expire_order(
+                    action.asset_id_, *action.orderId_, current_time_us_);
+                break;
             // local events
             case ActionType::LocalProcessFill:
+                utils::trace::trace_event(TraceEventType::LocalDelivery,
+                                          current_time_us_, action.asset_id_,
+                                          action.fill_->orderId_);
                 process_fill_local(action.asset_id_, *action.fill_);
                 break;
-            case ActionType::LocalBookUpdate:
-                process_book_update_local(action.asset_id_,
-                                          *action.book_update_);
-                break;
             case ActionType::LocalOrderUpdate:
+                utils::trace::trace_event(TraceEventType::LocalDelivery,
+                                          current_time_us_, action.asset_id_,
+                                          *action.orderId_);
                 process_order_update_local(*action.order_update_type_,
                                            *action.orderId_, *action.order_);
                 break;
+            // strategy events
+            case ActionType::Timer: {
+                // the callback sees the local books as of its own time
+                advance_local_views(action.execute_time_);
+                utils::trace::TraceScope scope(
+                    TraceEventType::StrategyCallback, current_time_us_);
+                action.strategy_->on_timer(*this, action.timer_tag_);
+                break;
+            }
             default:
                 throw std::invalid_argument(
                     "Unknown ActionType in DelayedAction");
@@ -169,32 +275,42 @@ bool BacktestEngine::elapse(std::uint64_t microseconds) {
             // process any fills or order updates in the exchange events
             process_exchange_fills();
             process_exchange_order_updates();
+            if (state_hasher_) {
+                state_hasher_->fold(static_cast<std::uint64_t>(action.type_));
+                state_hasher_->fold(
+                    static_cast<std::uint64_t>(action.asset_id_));
+                state_hasher_->fold(action.execute_time_);
+                end_hashed_event();
+            }
             ++it;
         }
         // process another event before interval ends
         if (next_event_us < next_interval_us) {
-            market_data_feed_.next_event(asset_id, event_type, book_update,
-                                         trade);
-            if (event_type == EventType::Trade) {
-                execution_engine_.handle_trade(asset_id, trade);
+            market_data_feed_.next_event(event);
+            const int asset_id = event.asset_id_;
+            if (event.event_type_ == EventType::Trade) {
+                execution_engine_.handle_trade(asset_id, event.trade_);
                 process_exchange_fills();
                 process_exchange_order_updates();
-            } else if (event_type == EventType::BookUpdate) {
-                execution_engine_.handle_book_update(asset_id, book_update);
-                // update local books with feed latency
-                delayed_actions_.insert(
-                    {book_update.local_timestamp_,
-                     DelayedAction{.type_ = ActionType::LocalBookUpdate,
-                                   .asset_id_ = asset_id,
-                                   .order_ = std::nullopt,
-                                   .orderId_ = std::nullopt,
-                                   .order_update_type_ = std::nullopt,
-                                   .fill_ = std::nullopt,
-                                   .book_update_ = book_update,
-                                   .execute_time_ =
-                                       book_update.local_timestamp_}});
+            } else if (event.event_type_ == EventType::BookUpdateBatch) {
+                execution_engine_.handle_book_update_batch(asset_id,
+                                                           event.book_batch_);
+            } else if (event.event_type_ == EventType::MboUpdate) {
+                execution_engine_.handle_mbo_update(asset_id,
+                                                    event.mbo_update_);
+            } else if (event.event_type_ == EventType::Quote) {
+                execution_engine_.handle_quote(asset_id, event.quote_);
+                local_tops_.at(asset_id).pending_.push_back(event.quote_);
             } else {
-                std::invalid_argument("Incorrect EventType");
+                throw std::invalid_argument("Incorrect EventType");
+            }
+            if (state_hasher_) {
+                // offset keeps market events apart from delayed actions
+                state_hasher_->fold(
+                    0x100 + static_cast<std::uint64_t>(event.event_type_));
+                state_hasher_->fold(static_cast<std::uint64_t>(asset_id));
+                state_hasher_->fold(next_event_us);
+                end_hashed_event();
             }
             current_time_us_ = next_event_us;
         } else {
@@ -202,6 +318,7 @@ bool BacktestEngine::elapse(std::uint64_t microseconds) {
         }
     }
     current_time_us_ = next_interval_us;
+    advance_local_views(current_time_us_);
     if (logger_) {
         logger_->log("[BacktestEngine] - " + std::to_string(current_time_us_) +
                          "us - elapse complete",
@@ -210,6 +327,23 @@ bool BacktestEngine::elapse(std::uint64_t microseconds) {
     return std::isfinite(current_time_us_);
 }
 
+/**
+ * @brief Delivers to the local books and tops of book every market change
+ * whose local timestamp is before @p now.
+ */
+void BacktestEngine::advance_local_views(Timestamp now) {
+    for (auto &[_, local_book] : local_orderbooks_) {
+        local_book.advance(now);
+    }
+    for (auto &[_, local_top] : local_tops_) {
+        while (!local_top.pending_.empty() &&
+               local_top.pending_.front().local_timestamp_ < now) {
+            local_top.book_.apply_quote(local_top.pending_.front());
+            local_top.pending_.pop_front();
+        }
+    }
+}
+
 bool BacktestEngine::order_inactive(const core::trading::Order &order) {
     if (order.orderStatus_ == OrderStatus::FILLED ||
         order.orderStatus_ == OrderStatus::CANCELLED ||
@@ -262,16 +396,30 @@ void BacktestEngine::clear_inactive_orders() {
  * @param price The price at which the buy order is placed.
  * @param quantity The quantity of the asset to buy.
  * @param tif The time-in-force policy for the order (e.g., FOK, IOC, GTX).
- * @param orderType The type of the order (e.g., LIMIT, MARKET).
+ * @param orderType The type of the order (e.g., LIMIT, MARKET, STOP_MARKET).
+ * @param stop_price Trigger price of STOP_MARKET and STOP_LIMIT orders.
+ * @param expire_time Simulated time at which the exchange expires a GTD
+ * order.
  * @return The unique order ID assigned to the submitted order.
+ * @throws std::invalid_argument on a non-positive quantity, a missing
+ * limit or stop price, or a GTD order's expire time not in the future.
  */
 OrderId BacktestEngine::submit_buy_order(int asset_id, Price price,
                                          Quantity quantity, TimeInForce tif,
-                                         OrderType orderType) {
+                                         OrderType orderType,
+                                         Price stop_price,
+                                         Timestamp expire_time) {
     using namespace core::trading;
     if (quantity <= 0.0) throw std::invalid_argument("Insufficient quantity");
-    if (orderType == OrderType::LIMIT && price <= 0.0)
+    if ((orderType == OrderType::LIMIT || orderType == OrderType::STOP_LIMIT) &&
+        price <= 0.0)
         throw std::invalid_argument("Invalid price for limit order");
+    if ((orderType == OrderType::STOP_MARKET ||
+         orderType == OrderType::STOP_LIMIT) &&
+        stop_price <= 0.0)
+        throw std::invalid_argument("Invalid stop price for stop order");
+    if (tif == TimeInForce::GTD && expire_time <= current_time_us_)
+        throw std::invalid_argument("Expire time of GTD order has passed");
     Order buy_order{.local_timestamp_ = current_time_us_,
                     .exch_timestamp_ =
                         current_time_us_ + order_entry_latency_us,
@@ -283,7 +431,9 @@ OrderId BacktestEngine::submit_buy_order(int asset_id, Price price,
                     .tif_ = tif,
                     .orderType_ = orderType,
                     .queueEst_ = 0.0,
-                    .orderStatus_ = OrderStatus::NEW};
+                    .orderStatus_ = OrderStatus::NEW,
+                    .stop_price_ = stop_price,
+                    .expire_time_ = expire_time};
     if (logger_) {
         logger_->log("[BacktestEngine] - " + std::to_string(current_time_us_) +
                          "us - buy order (" +
@@ -291,6 +441,8 @@ OrderId BacktestEngine::submit_buy_order(int asset_id, Price price,
                          ") submitted to exchange",
                      utils::logger::LogLevel::Debug);
     }
+    utils::trace::trace_event(utils::trace::TraceEventType::Submit,
+                              current_time_us_, asset_id, buy_order.orderId_);
     delayed_actions_.insert(
         {buy_order.exch_timestamp_,
          DelayedAction{.type_ = ActionType::SubmitBuy,
@@ -299,8 +451,8 @@ OrderId BacktestEngine::submit_buy_order(int asset_id, Price price,
                        .orderId_ = std::nullopt,
                        .order_update_type_ = std::nullopt,
                        .fill_ = std::nullopt,
-                       .book_update_ = std::nullopt,
                        .execute_time_ = buy_order.exch_timestamp_}});
+    if (tif == TimeInForce::GTD) schedule_expiry(asset_id, buy_order);
     return buy_order.orderId_;
 }
 
@@ -315,16 +467,30 @@ OrderId BacktestEngine::submit_buy_order(int asset_id, Price price,
  * @param price The price at which the sell order is placed.
  * @param quantity The quantity of the asset to sell.
  * @param tif The time-in-force policy for the order (e.g., FOK, IOC, GTX).
- * @param orderType The type of the order (e.g., LIMIT, MARKET).
+ * @param orderType The type of the order (e.g., LIMIT, MARKET, STOP_MARKET).
+ * @param stop_price Trigger price of STOP_MARKET and STOP_LIMIT orders.
+ * @param expire_time Simulated time at which the exchange expires a GTD
+ * order.
  * @return The unique order ID assigned to the submitted order.
+ * @throws std::invalid_argument on a non-positive quantity, a missing
+ * limit or stop price, or a GTD order's expire time not in the future.
  */
 OrderId BacktestEngine::submit_sell_order(int asset_id, Price price,
                                           Quantity quantity, TimeInForce tif,
-                                          OrderType orderType) {
+                                          OrderType orderType,
+                                          Price stop_price,
+                                          Timestamp expire_time) {
     using namespace core::trading;
     if (quantity <= 0.0) throw std::invalid_argument("Insufficient quantity");
-    if (orderType == OrderType::LIMIT && price <= 0.0)
+    if ((orderType == OrderType::LIMIT || orderType == OrderType::STOP_LIMIT) &&
+        price <= 0.0)
         throw std::invalid_argument("Invalid price for limit order");
+    if ((orderType == OrderType::STOP_MARKET ||
+         orderType == OrderType::STOP_LIMIT) &&
+        stop_price <= 0.0)
+        throw std::invalid_argument("Invalid stop price for stop order");
+    if (tif == TimeInForce::GTD && expire_time <= current_time_us_)
+        throw std::invalid_argument("Expire time of GTD order has passed");
     Order sell_order{.local_timestamp_ = current_time_us_,
                      .exch_timestamp_ =
                          current_time_us_ + order_entry_latency_us,
@@ -336,7 +502,9 @@ OrderId BacktestEngine::submit_sell_order(int asset_id, Price price,
                      .tif_ = tif,
                      .orderType_ = orderType,
                      .queueEst_ = 0.0,
-                     .orderStatus_ = OrderStatus::NEW};
+                     .orderStatus_ = OrderStatus::NEW,
+                     .stop_price_ = stop_price,
+                     .expire_time_ = expire_time};
     if (logger_) {
         logger_->log("[BacktestEngine] - " + std::to_string(current_time_us_) +
                          "us - sell order (" +
@@ -344,6 +512,8 @@ OrderId BacktestEngine::submit_sell_order(int asset_id, Price price,
                          ") submitted to exchange",
                      utils::logger::LogLevel::Debug);
     }
+    utils::trace::trace_event(utils::trace::TraceEventType::Submit,
+                              current_time_us_, asset_id, sell_order.orderId_);
     delayed_actions_.insert(
         {sell_order.exch_timestamp_,
          DelayedAction{.type_ = ActionType::SubmitSell,
@@ -352,8 +522,8 @@ OrderId BacktestEngine::submit_sell_order(int asset_id, Price price,
                        .orderId_ = std::nullopt,
                        .order_update_type_ = std::nullopt,
                        .fill_ = std::nullopt,
-                       .book_update_ = std::nullopt,
                        .execute_time_ = sell_order.exch_timestamp_}});
+    if (tif == TimeInForce::GTD) schedule_expiry(asset_id, sell_order);
 
     return sell_order.orderId_;
 }
@@ -364,6 +534,8 @@ OrderId BacktestEngine::submit_sell_order(int asset_id, Price price,
  * Local originated, received by the exchange with order entry latency.
  */
 void BacktestEngine::cancel_order(int asset_id, OrderId orderId) {
+    utils::trace::trace_event(utils::trace::TraceEventType::Submit,
+                              current_time_us_, asset_id, orderId);
     delayed_actions_.insert(
         {current_time_us_ + order_response_latency_us,
          DelayedAction{.type_ = ActionType::Cancel,
@@ -372,11 +544,62 @@ void BacktestEngine::cancel_order(int asset_id, OrderId orderId) {
                        .orderId_ = orderId,
                        .order_update_type_ = std::nullopt,
                        .fill_ = std::nullopt,
-                       .book_update_ = std::nullopt,
                        .execute_time_ =
                            current_time_us_ + order_entry_latency_us}});
 }
 
+/**
+ * @brief Schedules the exchange-side expiry of a GTD order at its expire
+ * time.
+ *
+ * The expiry is a delayed action like any other, so it runs in time order
+ * with market events and order traffic without the strategy's involvement.
+ * If the order has finished by then, the expiry does nothing.
+ */
+void BacktestEngine::schedule_expiry(int asset_id,
+                                     const core::trading::Order &order) {
+    delayed_actions_.insert(
+        {order.expire_time_,
+         DelayedAction{.type_ = ActionType::Expire,
+                       .asset_id_ = asset_id,
+                       .order_ = std::nullopt,
+                       .orderId_ = order.orderId_,
+                       .order_update_type_ = std::nullopt,
+                       .fill_ = std::nullopt,
+                       .execute_time_ = order.expire_time_}});
+}
+
+/**
+ * @brief Schedules a strategy callback at a simulated time.
+ *
+ * The timer is a delayed action, so it fires in time order with market
+ * events and order traffic during elapse(): `strategy.on_timer(engine, tag)`
+ * runs with the clock at @p at_us. A strategy may schedule further timers,
+ * including from on_timer itself, to run at its own cadence independently of
+ * the elapse step. The strategy must outlive its pending timers.
+ *
+ * @param strategy The strategy to call back.
+ * @param at_us Simulated time of the callback; not earlier than now.
+ * @param tag Passed back to on_timer to tell a strategy's timers apart.
+ * @throws std::invalid_argument if @p at_us is in the past.
+ */
+void BacktestEngine::schedule_timer(core::strategy::Strategy &strategy,
+                                    Timestamp at_us, std::uint64_t tag) {
+    if (at_us < current_time_us_) {
+        throw std::invalid_argument("Timer scheduled in the past");
+    }
+    delayed_actions_.insert(
+        {at_us, DelayedAction{.type_ = ActionType::Timer,
+                              .asset_id_ = -1,
+                              .order_ = std::nullopt,
+                              .orderId_ = std::nullopt,
+                              .order_update_type_ = std::nullopt,
+                              .fill_ = std::nullopt,
+                              .execute_time_ = at_us,
+                              .strategy_ = &strategy,
+                              .timer_tag_ = tag}});
+}
+
 /**
  * @brief Order response latency for order updates to local.
  *
@@ -389,6 +612,10 @@ void BacktestEngine::process_exchange_order_updates() {
     using namespace core::execution_engine;
     std::vector<OrderUpdate> order_updates = execution_engine_.order_updates();
     for (const auto &order_update : order_updates) {
+        utils::trace::trace_event(utils::trace::TraceEventType::Ack,
+                                  order_update.exch_timestamp_,
+                                  order_update.asset_id_,
+                                  order_update.orderId_);
         delayed_actions_.insert(
             {order_update.local_timestamp_,
              DelayedAction{.type_ = ActionType::LocalOrderUpdate,
@@ -397,7 +624,6 @@ void BacktestEngine::process_exchange_order_updates() {
                            .orderId_ = order_update.orderId_,
                            .order_update_type_ = order_update.event_type_,
                            .fill_ = std::nullopt,
-                           .book_update_ = std::nullopt,
                            .execute_time_ = order_update.local_timestamp_}});
     }
     execution_engine_.clear_order_updates();
@@ -440,7 +666,18 @@ void BacktestEngine::process_order_update_local(
                              std::to_string(orderId) + ") update",
                          utils::logger::LogLevel::Debug);
         }
+    } else if (event_type == OrderEventType::EXPIRED) {
+        local_active_orders_[orderId] = order;
+        if (logger_) {
+            logger_->log("[BacktestEngine] - " +
+                             std::to_string(current_time_us_) +
+                             "us - EXPIRED recieved locally (" +
+                             std::to_string(orderId) + ") update",
+                         utils::logger::LogLevel::Debug);
+        }
     } else if (event_type == OrderEventType::REJECTED) {
+        // only triggered stops are reported rejected after being accepted
+        local_active_orders_.erase(orderId);
         if (logger_) {
             logger_->log("[BacktestEngine] - " +
                              std::to_string(current_time_us_) +
@@ -475,6 +712,15 @@ void BacktestEngine::process_exchange_fills() {
     using namespace core::execution_engine;
     std::vector<core::trading::Fill> fills = execution_engine_.fills();
     for (const auto &fill : fills) {
+        utils::trace::trace_event(utils::trace::TraceEventType::Fill,
+                                  fill.exch_timestamp_, fill.asset_id_,
+                                  fill.orderId_);
+        if (state_hasher_) {
+            state_hasher_->fold(fill.orderId_);
+            state_hasher_->fold_double(fill.price_);
+            state_hasher_->fold_double(fill.quantity_);
+            state_hasher_->fold(fill.is_maker ? 1 : 0);
+        }
         delayed_actions_.insert(
             {fill.local_timestamp_,
              DelayedAction{.type_ = ActionType::LocalProcessFill,
@@ -483,7 +729,6 @@ void BacktestEngine::process_exchange_fills() {
                            .orderId_ = std::nullopt,
                            .order_update_type_ = std::nullopt,
                            .fill_ = fill,
-                           .book_update_ = std::nullopt,
                            .execute_time_ = fill.local_timestamp_}});
     }
     execution_engine_.clear_fills();
@@ -531,12 +776,6 @@ void BacktestEngine::process_fill_local(int asset_id,
     local_cash_balance_ += -signed_qty * fill.price_ - fee;
 }
 
-void BacktestEngine::process_book_update_local(
-    int asset_id, const core::market_data::BookUpdate &book_update) {
-    using namespace core::orderbook;
-    local_orderbooks_.at(asset_id).apply_book_update(book_update);
-}
-
 /**
  * @brief Returns a vector of active orders for the specified asset.
  *
@@ -592,14 +831,18 @@ double BacktestEngine::equity() const {
     double value = local_cash_balance_;
     for (auto &[asset_id, pos] : local_position_) {
         using namespace core::orderbook;
-        value += pos * local_orderbooks_.at(asset_id).mid_price();
+        auto top_it = local_tops_.find(asset_id);
+        Price mid = (top_it != local_tops_.end())
+                        ? top_it->second.book_.mid_price()
+                        : local_orderbooks_.at(asset_id).mid_price();
+        value += pos * mid;
         if (logger_) {
-            logger_->log(
-                "[BacktestEngine] - " + std::to_string(current_time_us_) +
-                    "us - asset " + std::to_string(asset_id) +
-                    " position: " + std::to_string(pos) + ", mid price: " +
-                    std::to_string(local_orderbooks_.at(asset_id).mid_price()),
-                utils::logger::LogLevel::Debug);
+            logger_->log("[BacktestEngine] - " +
+                             std::to_string(current_time_us_) + "us - asset " +
+                             std::to_string(asset_id) +
+                             " position: " + std::to_string(pos) +
+                             ", mid price: " + std::to_string(mid),
+                         utils::logger::LogLevel::Debug);
         }
     }
     return value;
@@ -623,6 +866,22 @@ Quantity BacktestEngine::position(int asset_id) const {
 const core::trading::Depth BacktestEngine::depth(int asset_id) const {
     using namespace core::orderbook;
     using namespace core::trading;
+    if (auto top_it = local_tops_.find(asset_id); top_it != local_tops_.end()) {
+        const TopOfBook &top = top_it->second.book_;
+        Depth depth{.best_bid_ = top.price_at_level(BookSide::Bid, 0),
+                    .bid_qty_ = top.depth_at_level(BookSide::Bid, 0),
+                    .best_ask_ = top.price_at_level(BookSide::Ask, 0),
+                    .ask_qty_ = top.depth_at_level(BookSide::Ask, 0),
+                    .bid_depth_ = {},
+                    .ask_depth_ = {},
+                    .tick_size_ = tick_sizes_.at(asset_id),
+                    .lot_size_ = lot_sizes_.at(asset_id)};
+        if (depth.best_bid_ != 0)
+            depth.bid_depth_.emplace(depth.best_bid_, depth.bid_qty_);
+        if (depth.best_ask_ != 0)
+            depth.ask_depth_.emplace(depth.best_ask_, depth.ask_qty_);
+        return depth;
+    }
     Ticks best_ask =
         local_orderbooks_.at(asset_id).price_at_level(BookSide::Ask, 0);
     Ticks best_bid =
@@ -647,6 +906,77 @@ const core::trading::Depth BacktestEngine::depth(int asset_id) const {
                  .lot_size_ = lot_sizes_.at(asset_id)};
 }
 
+/**
+ * @brief Returns the best bid and ask of the local order book for an asset.
+ *
+ * Like depth(), but the depth maps are left empty, so the call does not copy
+ * the book and allocates nothing.
+ *
+ * @param asset_id The identifier of the asset.
+ */
+const core::trading::Depth BacktestEngine::top_depth(int asset_id) const {
+    using namespace core::trading;
+    if (auto top_it = local_tops_.find(asset_id); top_it != local_tops_.end()) {
+        const auto &top = top_it->second.book_;
+        return Depth{.best_bid_ = top.price_at_level(BookSide::Bid, 0),
+                     .bid_qty_ = top.depth_at_level(BookSide::Bid, 0),
+                     .best_ask_ = top.price_at_level(BookSide::Ask, 0),
+                     .ask_qty_ = top.depth_at_level(BookSide::Ask, 0),
+                     .bid_depth_ = {},
+                     .ask_depth_ = {},
+                     .tick_size_ = tick_sizes_.at(asset_id),
+                     .lot_size_ = lot_sizes_.at(asset_id)};
+    }
+    const auto &book = local_orderbooks_.at(asset_id);
+    return Depth{.best_bid_ = book.price_at_level(BookSide::Bid, 0),
+                 .bid_qty_ = book.depth_at_level(BookSide::Bid, 0),
+                 .best_ask_ = book.price_at_level(BookSide::Ask, 0),
+                 .ask_qty_ = book.depth_at_level(BookSide::Ask, 0),
+                 .bid_depth_ = {},
+                 .ask_depth_ = {},
+                 .tick_size_ = tick_sizes_.at(asset_id),
+                 .lot_size_ = lot_sizes_.at(asset_id)};
+}
+
+/**
+ * @brief Returns the local view of an order, or nullptr if it is not known
+ * locally.
+ *
+ * An order is known once its acknowledgement has arrived locally and until it
+ * is cancelled or removed by clear_inactive_orders(); filled orders stay
+ * visible (as FILLED) until then. Unlike orders(), nothing is copied.
+ */
+const core::trading::Order *BacktestEngine::order(OrderId orderId) const {
+    const auto it = local_active_orders_.find(orderId);
+    return it == local_active_orders_.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Returns an immutable snapshot of the local order book for an asset.
+ *
+ * The snapshot reflects the book as seen locally at the current time (i.e.
+ * delayed by the market feed latency). Taking a snapshot is O(1) and it
+ * remains valid after the book changes, so strategies may keep a history of
+ * them for lookback.
+ *
+ * @param asset_id The identifier of the asset.
+ * @return The snapshot, labelled with the current simulation time.
+ */
+core::orderbook::BookSnapshot BacktestEngine::book_snapshot(int asset_id) {
+    using namespace core::orderbook;
+    if (auto top_it = local_tops_.find(asset_id); top_it != local_tops_.end()) {
+        const TopOfBook &top = top_it->second.book_;
+        PagedLevels bids, asks;
+        bids.set(top.price_at_level(BookSide::Bid, 0),
+                 top.depth_at_level(BookSide::Bid, 0));
+        asks.set(top.price_at_level(BookSide::Ask, 0),
+                 top.depth_at_level(BookSide::Ask, 0));
+        return BookSnapshot(current_time_us_, tick_sizes_.at(asset_id),
+                            std::move(bids), std::move(asks));
+    }
+    return local_orderbooks_.at(asset_id).snapshot(current_time_us_);
+}
+
 /**
  * @brief Prints trading statistics for the specified asset.
  *
@@ -682,6 +1012,47 @@ void BacktestEngine::print_trading_stats(int asset_id) const {
     std::cout << "=============================================\n";
 }
 
+/**
+ * @brief Hashes the full simulation state for replay verification.
+ *
+ * Covers, per asset in id order, the exchange book and our resting orders
+ * (ExecutionEngine::state_hash()), then the local position and trade count,
+ * the local order view and the cash balance.
+ */
+std::uint64_t BacktestEngine::state_digest() const {
+    using utils::hash::combine;
+    using utils::hash::combine_double;
+    std::vector<int> asset_ids;
+    asset_ids.reserve(assets_.size());
+    for (const auto &[asset_id, _] : assets_) asset_ids.push_back(asset_id);
+    std::sort(asset_ids.begin(), asset_ids.end());
+
+    std::uint64_t h = combine(0, current_time_us_);
+    for (int asset_id : asset_ids) {
+        h = combine(h, execution_engine_.state_hash(asset_id));
+        h = combine_double(h, local_position_.at(asset_id));
+        h = combine(h, static_cast<std::uint64_t>(num_trades_.at(asset_id)));
+    }
+    // local orders live in a hash map, so fold them order-independently
+    std::uint64_t orders = 0;
+    for (const auto &[orderId, order] : local_active_orders_) {
+        std::uint64_t o = combine(0, order.orderId_);
+        o = combine_double(o, order.price_);
+        o = combine_double(o, order.quantity_);
+        o = combine_double(o, order.filled_quantity_);
+        o = combine(o, static_cast<std::uint64_t>(order.orderStatus_));
+        orders += o;
+    }
+    h = combine(h, orders);
+    return combine_double(h, local_cash_balance_);
+}
+
+void BacktestEngine::end_hashed_event() {
+    if (state_hasher_->end_event()) {
+        state_hasher_->checkpoint(current_time_us_, state_digest());
+    }
+}
+
 /**
  * @brief Returns the current simulation time in microseconds.
  *
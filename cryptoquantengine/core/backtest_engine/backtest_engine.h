@@ -8,14 +8,21 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <memory_resource>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "../../utils/logger/logger.h"
 #include "../execution_engine/execution_engine.h"
 #include "../market_data/market_data_feed.h"
+#include "../market_data/market_event.h"
+#include "../orderbook/book_snapshot.h"
+#include "../orderbook/lagged_book_view.h"
 #include "../orderbook/orderbook.h"
+#include "../orderbook/top_of_book.h"
 #include "../trading/depth.h"
 #include "../trading/fill.h"
 #include "../trading/order.h"
@@ -27,6 +34,11 @@
 #include "../types/aliases/usings.h"
 #include "backtest_asset.h"
 #include "backtest_engine_config.h"
+#include "state_hasher.h"
+
+namespace core::strategy {
+class Strategy;
+}
 
 namespace core::backtest {
 class BacktestEngine {
@@ -35,7 +47,10 @@ class BacktestEngine {
         const std::unordered_map<int, core::trading::AssetConfig>
             &asset_configs,
         const core::backtest::BacktestEngineConfig &engine_config,
-        std::shared_ptr<utils::logger::Logger> logger = nullptr);
+        std::shared_ptr<utils::logger::Logger> logger = nullptr,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource(),
+        const core::market_data::EventTape *tape = nullptr);
+    ~BacktestEngine();
 
     // global methods
     bool elapse(std::uint64_t microseconds);
@@ -45,10 +60,16 @@ class BacktestEngine {
 
     // local origin methods
     OrderId submit_buy_order(int asset_id, Price price, Quantity quantity,
-                             TimeInForce tif, OrderType orderType);
+                             TimeInForce tif, OrderType orderType,
+                             Price stop_price = 0.0,
+                             Timestamp expire_time = 0);
     OrderId submit_sell_order(int asset_id, Price price, Quantity quantity,
-                              TimeInForce tif, OrderType orderType);
+                              TimeInForce tif, OrderType orderType,
+                              Price stop_price = 0.0,
+                              Timestamp expire_time = 0);
     void cancel_order(int asset_id, OrderId orderId);
+    void schedule_timer(core::strategy::Strategy &strategy, Timestamp at_us,
+                        std::uint64_t tag);
 
     // local state access methods
     const std::vector<core::trading::Order> orders(int asset_id) const;
@@ -56,9 +77,13 @@ class BacktestEngine {
     double equity() const;
     Quantity position(int asset_id) const;
     const core::trading::Depth depth(int asset_id) const;
+    const core::trading::Depth top_depth(int asset_id) const;
+    const core::trading::Order *order(OrderId orderId) const;
+    core::orderbook::BookSnapshot book_snapshot(int asset_id);
     Timestamp current_time() const;
 
     void print_trading_stats(int asset_id) const;
+    std::uint64_t state_digest() const;
 
     void set_cash(double cash);
 
@@ -76,19 +101,20 @@ class BacktestEngine {
     Microseconds market_feed_latency_us = 50000;
 
     // backtest simulation methods
+    void advance_local_views(Timestamp now);
     void process_exchange_order_updates();
     void process_exchange_fills();
 
+    void schedule_expiry(int asset_id, const core::trading::Order &order);
     void process_order_update_local(OrderEventType event_type, OrderId orderId,
                                     const core::trading::Order order);
     void process_fill_local(int asset_id, const core::trading::Fill &fill);
-    void
-    process_book_update_local(int asset_id,
-                              const core::market_data::BookUpdate &book_update);
     // internal state
     Timestamp current_time_us_;
     core::execution_engine::ExecutionEngine execution_engine_;
     core::market_data::MarketDataFeed market_data_feed_;
+    // refilled by every market event; kept so its batch rows are reused
+    core::market_data::MarketEvent market_event_;
     core::trading::OrderIdGenerator orderId_gen_;
     // asset configurations
     std::unordered_map<int, core::backtest::BacktestAsset> assets_;
@@ -97,7 +123,14 @@ class BacktestEngine {
     // local state (updated with latency simulation)
     double local_cash_balance_;
     std::unordered_map<int, double> local_position_;
-    std::unordered_map<int, core::orderbook::OrderBook> local_orderbooks_;
+    std::unordered_map<int, core::orderbook::LaggedBookView> local_orderbooks_;
+    // top-of-book-only assets: quotes wait in pending_ until their local
+    // timestamp has passed
+    struct LocalTopOfBook {
+        core::orderbook::TopOfBook book_;
+        std::deque<core::market_data::Quote> pending_;
+    };
+    std::unordered_map<int, LocalTopOfBook> local_tops_;
     std::unordered_map<int, core::trading::Order> local_active_orders_;
     // trading statistics
     std::unordered_map<int, int> num_trades_;
@@ -112,12 +145,20 @@ class BacktestEngine {
         std::optional<OrderId> orderId_;
         std::optional<OrderEventType> order_update_type_;
         std::optional<core::trading::Fill> fill_;
-        std::optional<core::market_data::BookUpdate> book_update_;
         Timestamp execute_time_;
+        // Timer actions only
+        core::strategy::Strategy *strategy_ = nullptr;
+        std::uint64_t timer_tag_ = 0;
     };
 
-    std::multimap<Timestamp, DelayedAction> delayed_actions_;
+    std::pmr::multimap<Timestamp, DelayedAction> delayed_actions_;
+
+    // null unless state hashing is enabled in the engine config
+    std::unique_ptr<StateHasher> state_hasher_;
+    void end_hashed_event();
 
     std::shared_ptr<utils::logger::Logger> logger_;
+    // empty unless event tracing is enabled in the engine config
+    std::string trace_file_;
 };
 } // namespace core::backtest
\ No newline at end of file
@@ -8,6 +8,9 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+
+#include "../types/aliases/usings.h"
 
 namespace core::backtest {
 struct BacktestEngineConfig {
@@ -15,5 +18,15 @@ struct BacktestEngineConfig {
     std::uint64_t order_entry_latency_us_ = 25000;
     std::uint64_t order_response_latency_us_ = 25000;
     std::uint64_t market_feed_latency_us_ = 50000;
+    bool aggregate_trades_ = false;
+    // replay verification: checkpoint a rolling state hash every N events
+    // (0 = off)
+    std::uint64_t state_hash_interval_ = 0;
+    std::string state_hash_file_ = "state_hashes.csv";
+    // replay from the nearest book checkpoint at or before this time, for
+    // assets with a book_checkpoint_file (0 = from the start of the files)
+    Timestamp start_time_us_ = 0;
+    // binary event trace written when the engine is destroyed (empty = off)
+    std::string trace_file_;
 };
 } 
\ No newline at end of file
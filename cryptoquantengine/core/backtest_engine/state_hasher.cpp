@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "../../utils/hash/hash_utils.h"
+#include "state_hasher.h"
+
+namespace core::backtest {
+/**
+ * @brief Opens the checkpoint file and writes its header.
+ *
+ * @param interval_events Events between checkpoints (must be positive).
+ * @param output_file Path of the checkpoint CSV file.
+ * @throws std::invalid_argument if @p interval_events is 0.
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+StateHasher::StateHasher(std::uint64_t interval_events,
+                         const std::string &output_file)
+    : interval_events_(interval_events), out_(output_file) {
+    if (interval_events == 0) {
+        throw std::invalid_argument("State hash interval must be positive");
+    }
+    if (!out_.is_open()) {
+        throw std::runtime_error("Failed to open state hash file: " +
+                                 output_file);
+    }
+    out_ << "event,timestamp,hash\n";
+}
+
+void StateHasher::fold(std::uint64_t value) {
+    hash_ = utils::hash::combine(hash_, value);
+}
+
+void StateHasher::fold_double(double value) {
+    hash_ = utils::hash::combine_double(hash_, value);
+}
+
+/**
+ * @brief Marks the end of one processed event.
+ * @return true if a checkpoint is due.
+ */
+bool StateHasher::end_event() { return ++events_ % interval_events_ == 0; }
+
+/**
+ * @brief Folds a digest of the full state and writes a checkpoint line.
+ */
+void StateHasher::checkpoint(Timestamp timestamp, std::uint64_t state_digest) {
+    fold(state_digest);
+    last_checkpoint_event_ = events_;
+    out_ << events_ << ',' << timestamp << ',' << std::hex << std::setw(16)
+         << std::setfill('0') << hash_ << std::dec << '\n';
+}
+
+/**
+ * @brief Returns true if events were folded since the last checkpoint.
+ */
+bool StateHasher::has_pending_events() const {
+    return events_ != last_checkpoint_event_;
+}
+
+std::uint64_t StateHasher::hash() const { return hash_; }
+
+std::uint64_t StateHasher::events() const { return events_; }
+
+/**
+ * @brief Reads a checkpoint file written by a StateHasher.
+ * @throws std::runtime_error if the file cannot be opened or a line is
+ * malformed.
+ */
+std::vector<StateHashCheckpoint> StateHasher::read(const std::string &file) {
+    std::ifstream in(file);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open state hash file: " + file);
+    }
+    std::vector<StateHashCheckpoint> checkpoints;
+    std::string line;
+    std::getline(in, line); // header
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        std::istringstream fields(line);
+        std::string event, timestamp, hash;
+        if (!std::getline(fields, event, ',') ||
+            !std::getline(fields, timestamp, ',') ||
+            !std::getline(fields, hash)) {
+            throw std::runtime_error("Malformed state hash line: " + line);
+        }
+        try {
+            checkpoints.push_back(
+                StateHashCheckpoint{.event_ = std::stoull(event),
+                                    .timestamp_ = std::stoull(timestamp),
+                                    .hash_ = std::stoull(hash, nullptr, 16)});
+        } catch (const std::exception &) {
+            throw std::runtime_error("Malformed state hash line: " + line);
+        }
+    }
+    return checkpoints;
+}
+
+/**
+ * @brief Finds the first checkpoint at which two runs differ.
+ *
+ * The first diverging event lies in (last_matching_event_, event_]; rerunning
+ * both sides with an interval of 1 pinpoints it.
+ *
+ * @return The divergence, or std::nullopt if both runs match throughout.
+ */
+std::optional<StateHashDivergence>
+StateHasher::first_divergence(const std::vector<StateHashCheckpoint> &a,
+                              const std::vector<StateHashCheckpoint> &b) {
+    const std::size_t common = std::min(a.size(), b.size());
+    std::uint64_t last_matching = 0;
+    for (std::size_t i = 0; i < common; ++i) {
+        if (a[i].event_ != b[i].event_ || a[i].hash_ != b[i].hash_) {
+            return StateHashDivergence{
+                .last_matching_event_ = last_matching,
+                .event_ = std::min(a[i].event_, b[i].event_),
+                .timestamp_ = std::min(a[i].timestamp_, b[i].timestamp_)};
+        }
+        last_matching = a[i].event_;
+    }
+    if (a.size() == b.size()) return std::nullopt;
+    // one run processed more events than the other
+    const auto &extra = (a.size() > b.size()) ? a[common] : b[common];
+    return StateHashDivergence{.last_matching_event_ = last_matching,
+                               .event_ = extra.event_,
+                               .timestamp_ = extra.timestamp_};
+}
+} // namespace core::backtest
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../types/aliases/usings.h"
+
+namespace core::backtest {
+struct StateHashCheckpoint {
+    std::uint64_t event_; // events processed when the checkpoint was taken
+    Timestamp timestamp_;
+    std::uint64_t hash_;
+};
+
+struct StateHashDivergence {
+    std::uint64_t last_matching_event_; // 0 = diverged in the first interval
+    std::uint64_t event_;               // first checkpoint that differs
+    Timestamp timestamp_;
+};
+
+/**
+ * @brief Rolling hash of a backtest's event stream and state, written as
+ * periodic checkpoints for replay verification.
+ *
+ * The engine folds every processed event into the hash, and every
+ * @p interval_events events also folds a digest of the full simulation state
+ * and writes a checkpoint line (event,timestamp,hash). Two runs that
+ * processed the same events into the same states write identical files; the
+ * first differing line brackets the first diverging event.
+ */
+class StateHasher {
+  public:
+    StateHasher(std::uint64_t interval_events, const std::string &output_file);
+
+    void fold(std::uint64_t value);
+    void fold_double(double value);
+    bool end_event();
+    void checkpoint(Timestamp timestamp, std::uint64_t state_digest);
+    bool has_pending_events() const;
+
+    std::uint64_t hash() const;
+    std::uint64_t events() const;
+
+    static std::vector<StateHashCheckpoint> read(const std::string &file);
+    static std::optional<StateHashDivergence>
+    first_divergence(const std::vector<StateHashCheckpoint> &a,
+                     const std::vector<StateHashCheckpoint> &b);
+
+  private:
+    std::uint64_t interval_events_;
+    std::uint64_t events_ = 0;
+    std::uint64_t last_checkpoint_event_ = 0;
+    std::uint64_t hash_ = 0;
+    std::ofstream out_;
+};
+} // namespace core::backtest
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../utils/memory/run_arena.h"
+#include "../../utils/thread/numa_topology.h"
+#include "../../utils/thread/task_pool.h"
+#include "../../utils/thread/thread_placement.h"
+#include "../market_data/event_tape.h"
+#include "sweep_runner.h"
+
+namespace core::backtest {
+namespace {
+// pins the calling thread to a node's CPUs, restoring its affinity on exit
+class NodePinning {
+  public:
+    explicit NodePinning(const std::vector<int> &cpus)
+        : previous_(utils::thread::current_thread_cpus()),
+          pinned_(utils::thread::set_current_thread_cpus(cpus)) {}
+    ~NodePinning() {
+        if (pinned_) utils::thread::set_current_thread_cpus(previous_);
+    }
+    NodePinning(const NodePinning &) = delete;
+    NodePinning &operator=(const NodePinning &) = delete;
+
+    bool pinned() const { return pinned_; }
+
+  private:
+    std::vector<int> previous_;
+    bool pinned_;
+};
+} // namespace
+
+/**
+ * @brief Decodes the assets' market data once and replicates it on every NUMA
+ * node.
+ *
+ * L2 book assets are decoded into an EventTape on the shared task pool, with
+ * book rows compressed on the asset's tick and lot grids unless
+ * compress_tape_ is off; each node then gets its own copy, made by a pool
+ * thread temporarily pinned to that node's CPUs so the kernel's first-touch
+ * policy places the replica in the node's local memory. Assets read from
+ * order-level or quote files are not taped and are read from their files by
+ * every run.
+ *
+ * @throws std::invalid_argument if the engine config enables event tracing or
+ * state hashing, whose output files concurrent runs would share.
+ */
+SweepRunner::SweepRunner(
+    const std::unordered_map<int, core::trading::AssetConfig> &asset_configs,
+    const BacktestEngineConfig &engine_config, SweepConfig config)
+    : asset_configs_(asset_configs), engine_config_(engine_config),
+      config_(config) {
+    if (!engine_config.trace_file_.empty() ||
+        engine_config.state_hash_interval_ > 0) {
+        throw std::invalid_argument(
+            "Sweeps cannot trace events or hash state: concurrent runs would "
+            "share the output files");
+    }
+    nodes_ = utils::thread::numa_topology();
+    if (!config_.numa_ && nodes_.size() > 1) {
+        utils::thread::NumaNode all{0, {}};
+        for (const auto &node : nodes_) {
+            all.cpus_.insert(all.cpus_.end(), node.cpus_.begin(),
+                             node.cpus_.end());
+        }
+        nodes_ = {std::move(all)};
+    }
+
+    // assets decode in parallel, then every node copies the tape in parallel
+    std::vector<int> taped;
+    for (const auto &[asset_id, asset_config] : asset_configs_) {
+        if (asset_config.quote_file_.empty() &&
+            asset_config.order_file_.empty()) {
+            taped.push_back(asset_id);
+        }
+    }
+    std::vector<core::market_data::AssetTape> decoded(taped.size());
+    utils::thread::parallel_for(0, taped.size(), [&](std::size_t i) {
+        const auto &asset_config = asset_configs_.at(taped[i]);
+        std::optional<core::market_data::TapeCompression> compression;
+        if (config_.compress_tape_) {
+            compression = core::market_data::TapeCompression{
+                .tick_size_ = asset_config.tick_size_,
+                .lot_size_ = asset_config.lot_size_};
+        }
+        decoded[i] = core::market_data::EventTape::decode(
+            asset_config.book_update_file_, asset_config.trade_file_,
+            engine_config_.aggregate_trades_, compression);
+    });
+    auto tape = std::make_unique<core::market_data::EventTape>();
+    for (std::size_t i = 0; i < taped.size(); ++i) {
+        tape->add_asset(taped[i], std::move(decoded[i]));
+    }
+    if (!config_.numa_ || nodes_.size() == 1) {
+        replicas_.push_back(std::move(tape));
+        return;
+    }
+    replicas_.resize(nodes_.size());
+    utils::thread::parallel_for(0, nodes_.size(), [&](std::size_t n) {
+        NodePinning pinning(nodes_[n].cpus_);
+        replicas_[n] = std::make_unique<core::market_data::EventTape>(*tape);
+    });
+}
+
+/**
+ * @brief Runs @p runs backtests across every node's workers and returns each
+ * run's result, indexed by run.
+ *
+ * Workers are low-priority tasks on the shared task pool, so a sweep never
+ * runs more threads than the pool has (plus the caller); workers beyond that
+ * find the runs already taken. Each worker pins its thread to its node's
+ * CPUs for the sweep, replays its node's tape replica and allocates from its
+ * own RunArena, reset between runs. Runs are handed out one at a time, so
+ * faster nodes take more of them. Per-node throughput is available from
+ * node_stats() afterwards.
+ *
+ * @param job Called once per run on a worker thread with a fresh engine.
+ * @throws The first exception thrown by @p job, after all workers stop.
+ */
+std::vector<double> SweepRunner::run(std::size_t runs, const SweepJob &job) {
+    struct WorkerStats {
+        std::size_t node_index_;
+        bool pinned_ = false;
+        std::size_t runs_ = 0;
+        double finished_seconds_ = 0.0;
+    };
+
+    std::vector<double> results(runs, 0.0);
+    std::vector<WorkerStats> workers;
+    for (std::size_t n = 0; n < nodes_.size(); ++n) {
+        const int count = config_.workers_per_node_ > 0
+                              ? config_.workers_per_node_
+                              : static_cast<int>(nodes_[n].cpus_.size());
+        for (int w = 0; w < count; ++w) workers.push_back(WorkerStats{n});
+    }
+
+    std::atomic<std::size_t> next_run{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto start = std::chrono::steady_clock::now();
+    // each slot occupies one pool thread (or the caller) for the whole sweep
+    utils::thread::parallel_for(
+        0, workers.size(),
+        [&](std::size_t w) {
+            WorkerStats &stats = workers[w];
+            const auto &node = nodes_[stats.node_index_];
+            std::optional<NodePinning> pinning;
+            if (config_.numa_) {
+                pinning.emplace(node.cpus_);
+                stats.pinned_ = pinning->pinned();
+            }
+            const auto &tape = *replicas_[stats.node_index_];
+            utils::memory::RunArena arena(config_.arena_bytes_);
+            for (std::size_t i = next_run++; i < runs; i = next_run++) {
+                try {
+                    {
+                        BacktestEngine engine(asset_configs_, engine_config_,
+                                              nullptr, arena.resource(),
+                                              &tape);
+                        results[i] = job(engine, i);
+                    }
+                    arena.reset();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    next_run = runs;
+                    break;
+                }
+                ++stats.runs_;
+            }
+            stats.finished_seconds_ = std::chrono::duration<double>(
+                                          std::chrono::steady_clock::now() -
+                                          start)
+                                          .count();
+        },
+        utils::thread::TaskPriority::Low);
+    if (error) std::rethrow_exception(error);
+
+    node_stats_.clear();
+    for (std::size_t n = 0; n < nodes_.size(); ++n) {
+        SweepNodeStats node{nodes_[n].id_, 0, 0, 0, 0.0, 0.0, 0.0};
+        for (const auto &stats : workers) {
+            if (stats.node_index_ != n) continue;
+            ++node.workers_;
+            node.pinned_workers_ += stats.pinned_ ? 1 : 0;
+            node.runs_ += stats.runs_;
+            node.seconds_ = std::max(node.seconds_, stats.finished_seconds_);
+        }
+        if (node.seconds_ > 0.0) {
+            node.runs_per_second_ = node.runs_ / node.seconds_;
+            node.events_per_second_ =
+                node.runs_per_second_ * replicas_[n]->events();
+        }
+        node_stats_.push_back(node);
+    }
+    return results;
+}
+
+/**
+ * @brief Returns the NUMA nodes the sweep runs on (a single node when NUMA
+ * placement is disabled).
+ */
+const std::vector<utils::thread::NumaNode> &SweepRunner::nodes() const {
+    return nodes_;
+}
+
+/**
+ * @brief Returns per-node throughput of the last run(). Events per second
+ * assume every run replays its whole tape.
+ */
+const std::vector<SweepNodeStats> &SweepRunner::node_stats() const {
+    return node_stats_;
+}
+
+/**
+ * @brief Returns the memory held by one node's tape replica.
+ */
+std::size_t SweepRunner::tape_bytes() const { return replicas_[0]->bytes(); }
+
+/**
+ * @brief Formats node_stats() as one line per node, for logging.
+ */
+std::string SweepRunner::format_node_stats() const {
+    std::ostringstream out;
+    for (const auto &node : node_stats_) {
+        out << "node " << node.node_ << ": workers=" << node.workers_
+            << " pinned=" << node.pinned_workers_ << " runs=" << node.runs_
+            << " seconds=" << node.seconds_
+            << " runs/s=" << node.runs_per_second_
+            << " events/s=" << node.events_per_second_ << "\n";
+    }
+    return out.str();
+}
+} // namespace core::backtest
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../utils/thread/numa_topology.h"
+#include "../market_data/event_tape.h"
+#include "../trading/asset_config.h"
+#include "backtest_engine.h"
+#include "backtest_engine_config.h"
+
+namespace core::backtest {
+struct SweepConfig {
+    // 0 = one per CPU of the node; capped in effect by the task pool's size
+    int workers_per_node_ = 0;
+    bool numa_ = true;         // false = one node, one tape, no pinning
+    std::size_t arena_bytes_ = std::size_t{64} << 20; // per-worker RunArena
+    bool compress_tape_ = true; // book rows as a CompressedBookTape
+};
+
+struct SweepNodeStats {
+    int node_;
+    int workers_;
+    int pinned_workers_; // workers whose affinity could be applied
+    std::size_t runs_;
+    double seconds_; // wall time from sweep start to the node's last run
+    double runs_per_second_;
+    double events_per_second_; // tape events replayed by the node's runs
+};
+
+// runs one backtest on a fresh engine and returns its result, e.g. equity
+using SweepJob = std::function<double(BacktestEngine &engine, std::size_t run)>;
+
+class SweepRunner {
+  public:
+    SweepRunner(
+        const std::unordered_map<int, core::trading::AssetConfig>
+            &asset_configs,
+        const BacktestEngineConfig &engine_config,
+        SweepConfig config = SweepConfig{});
+
+    std::vector<double> run(std::size_t runs, const SweepJob &job);
+
+    const std::vector<utils::thread::NumaNode> &nodes() const;
+    const std::vector<SweepNodeStats> &node_stats() const;
+    std::string format_node_stats() const;
+    std::size_t tape_bytes() const;
+
+  private:
+    std::unordered_map<int, core::trading::AssetConfig> asset_configs_;
+    BacktestEngineConfig engine_config_;
+    SweepConfig config_;
+    std::vector<utils::thread::NumaNode> nodes_;
+    // one replica per node, first touched by a thread pinned to that node
+    std::vector<std::unique_ptr<core::market_data::EventTape>> replicas_;
+    std::vector<SweepNodeStats> node_stats_;
+};
+} // namespace core::backtest
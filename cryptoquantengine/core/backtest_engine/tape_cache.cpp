@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "../market_data/event_tape.h"
+#include "tape_cache.h"
+
+namespace core::backtest {
+/**
+ * @brief Creates an empty cache holding at most @p max_bytes of tapes, with
+ * book rows compressed on the asset's grids unless @p compress_tape is off.
+ */
+TapeCache::TapeCache(std::size_t max_bytes, bool compress_tape)
+    : max_bytes_(max_bytes), compress_tape_(compress_tape) {}
+
+TapeCache::FileStamp TapeCache::stamp(const std::string &file) {
+    FileStamp result;
+    std::error_code error;
+    result.size_ = std::filesystem::file_size(file, error);
+    if (error) return FileStamp{};
+    result.time_ = std::filesystem::last_write_time(file, error);
+    return error ? FileStamp{} : result;
+}
+
+/**
+ * @brief Returns a tape holding the asset's data under @p asset_id, decoding
+ * it on a miss.
+ *
+ * Assets read from order-level or quote files are not taped; for them the
+ * result is nullptr and the engine reads the files itself. Decoding evicts
+ * least recently used tapes until the cache fits its budget again; a tape
+ * larger than the whole budget is kept until the next decode.
+ *
+ * @param hit Set to whether the tape was already cached (or being decoded).
+ * @throws Whatever decoding the files throws; the failed entry is dropped.
+ */
+std::shared_ptr<const core::market_data::EventTape>
+TapeCache::get(int asset_id, const core::trading::AssetConfig &asset_config,
+               bool aggregate_trades, bool *hit) {
+    if (hit != nullptr) *hit = false;
+    if (!asset_config.quote_file_.empty() ||
+        !asset_config.order_file_.empty()) {
+        return nullptr;
+    }
+    std::ostringstream key;
+    key.precision(17);
+    key << asset_id << '\n'
+        << asset_config.book_update_file_ << '\n'
+        << asset_config.trade_file_ << '\n'
+        << aggregate_trades << '\n'
+        << asset_config.tick_size_ << '\n'
+        << asset_config.lot_size_;
+    const FileStamp book_stamp = stamp(asset_config.book_update_file_);
+    const FileStamp trade_stamp = stamp(asset_config.trade_file_);
+
+    std::promise<TapePtr> promise;
+    std::optional<std::shared_future<TapePtr>> cached;
+    std::uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto found = index_.find(key.str());
+        if (found != index_.end() && found->second->book_stamp_ == book_stamp &&
+            found->second->trade_stamp_ == trade_stamp) {
+            entries_.splice(entries_.begin(), entries_, found->second);
+            ++stats_.hits_;
+            cached = found->second->tape_;
+        } else {
+            // a new dataset, or a file changed since the tape was decoded
+            if (found != index_.end()) erase(found->second);
+            ++stats_.misses_;
+            id = next_id_++;
+            entries_.push_front(Entry{key.str(), id, book_stamp, trade_stamp,
+                                      promise.get_future().share(), 0});
+            index_[key.str()] = entries_.begin();
+        }
+    }
+    if (cached) {
+        if (hit != nullptr) *hit = true;
+        return cached->get(); // waits for a decode still in progress
+    }
+
+    // looks the entry up again: it may have been replaced while decoding
+    auto find_entry = [&]() -> std::list<Entry>::iterator {
+        const auto found = index_.find(key.str());
+        return found != index_.end() && found->second->id_ == id
+                   ? found->second
+                   : entries_.end();
+    };
+    try {
+        std::optional<core::market_data::TapeCompression> compression;
+        if (compress_tape_) {
+            compression = core::market_data::TapeCompression{
+                asset_config.tick_size_, asset_config.lot_size_};
+        }
+        auto tape = std::make_shared<core::market_data::EventTape>();
+        tape->add_asset(asset_id, core::market_data::EventTape::decode(
+                                      asset_config.book_update_file_,
+                                      asset_config.trade_file_,
+                                      aggregate_trades, compression));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = find_entry();
+            if (it != entries_.end()) {
+                it->bytes_ = tape->bytes();
+                stats_.bytes_ += it->bytes_;
+                evict(id);
+            }
+        }
+        promise.set_value(tape);
+        return tape;
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = find_entry();
+            if (it != entries_.end()) erase(it);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+void TapeCache::erase(std::list<Entry>::iterator it) {
+    stats_.bytes_ -= it->bytes_;
+    index_.erase(it->key_);
+    entries_.erase(it);
+}
+
+void TapeCache::evict(std::uint64_t keep_id) {
+    auto it = entries_.end();
+    while (stats_.bytes_ > max_bytes_ && it != entries_.begin()) {
+        --it;
+        // entries still decoding hold no bytes yet
+        if (it->id_ == keep_id || it->bytes_ == 0) continue;
+        erase(it++);
+        ++stats_.evictions_;
+    }
+}
+
+/**
+ * @brief Returns hit, miss and eviction counts and the current size.
+ */
+TapeCacheStats TapeCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TapeCacheStats stats = stats_;
+    stats.entries_ = entries_.size();
+    return stats;
+}
+} // namespace core::backtest
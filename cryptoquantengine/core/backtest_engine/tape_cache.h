@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "../market_data/event_tape.h"
+#include "../trading/asset_config.h"
+
+namespace core::backtest {
+struct TapeCacheStats {
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0; // including files changed since decoding
+    std::size_t evictions_ = 0;
+    std::size_t entries_ = 0;
+    std::size_t bytes_ = 0; // of decoded tapes, excluding ones still decoding
+};
+
+/**
+ * @brief Decoded event tapes of recently used datasets, evicted least
+ * recently used first once their total size exceeds a byte budget.
+ *
+ * A dataset is an asset's book and trade files together with its tick and
+ * lot grids and the trade aggregation setting. An entry is dropped when
+ * either file's size or modification time changes. Tapes are handed out as
+ * shared pointers, so an evicted tape stays alive until the last backtest
+ * replaying it ends. Concurrent requests for a dataset being decoded wait
+ * for that decode instead of starting another.
+ */
+class TapeCache {
+  public:
+    explicit TapeCache(std::size_t max_bytes, bool compress_tape = true);
+
+    std::shared_ptr<const core::market_data::EventTape>
+    get(int asset_id, const core::trading::AssetConfig &asset_config,
+        bool aggregate_trades, bool *hit = nullptr);
+
+    TapeCacheStats stats() const;
+    std::size_t max_bytes() const { return max_bytes_; }
+
+  private:
+    using TapePtr = std::shared_ptr<const core::market_data::EventTape>;
+
+    // identifies a file's contents well enough to notice it was rewritten
+    struct FileStamp {
+        std::uintmax_t size_ = 0;
+        std::filesystem::file_time_type time_{};
+        bool operator==(const FileStamp &other) const {
+            return size_ == other.size_ && time_ == other.time_;
+        }
+    };
+
+    struct Entry {
+        std::string key_;
+        std::uint64_t id_; // tells a replaced entry from its successor
+        FileStamp book_stamp_;
+        FileStamp trade_stamp_;
+        std::shared_future<TapePtr> tape_;
+        std::size_t bytes_ = 0; // 0 while decoding
+    };
+
+    static FileStamp stamp(const std::string &file);
+    void erase(std::list<Entry>::iterator it); // with mutex_ held
+    void evict(std::uint64_t keep_id);         // with mutex_ held
+
+    std::size_t max_bytes_;
+    bool compress_tape_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_; // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::uint64_t next_id_ = 0;
+    TapeCacheStats stats_;
+};
+} // namespace core::backtest
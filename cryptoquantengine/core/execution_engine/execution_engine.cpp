@@ -6,16 +6,18 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
-#include <future>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#include "../../utils/hash/hash_utils.h"
 #include "../../utils/logger/logger.h"
 #include "../../utils/math/math_utils.h"
 #include "../trading/fill.h"
@@ -28,8 +30,22 @@
 #include "execution_engine.h"
 
 namespace core::execution_engine {
-ExecutionEngine::ExecutionEngine(std::shared_ptr<utils::logger::Logger> logger)
-    : logger_(logger) {}
+/**
+ * @brief Constructs an execution engine with no assets.
+ *
+ * @param logger Optional logger.
+ * @param resource Memory resource for the orders, the per-asset books
+ * (including the order pools of order-level books), maker books and order
+ * lookups. Passing a per-run arena lets a sweep worker release all of them
+ * at once when the run is over.
+ */
+ExecutionEngine::ExecutionEngine(std::shared_ptr<utils::logger::Logger> logger,
+                                 std::pmr::memory_resource *resource)
+    : resource_(resource), tick_sizes_(resource), lot_sizes_(resource),
+      orderbooks_(resource), mbo_books_(resource), queue_sequences_(resource),
+      tob_books_(resource), maker_books_(resource), trigger_books_(resource),
+      shadow_liquidity_(resource), active_orders_(resource), orders_(resource),
+      logger_(logger) {}
 
 /**
  * @brief Registers a new asset in the execution engine.
@@ -45,17 +61,49 @@ void ExecutionEngine::add_asset(int asset_id, double tick_size,
                                 double lot_size) {
     using namespace core::orderbook;
 
+    orderbooks_.emplace(asset_id,
+                        OrderBook(tick_size, lot_size, logger_, resource_));
+    register_asset(asset_id, tick_size, lot_size);
+}
+
+/**
+ * @brief Registers an asset whose market data is best bid/offer only.
+ *
+ * The asset keeps a TopOfBook instead of a full price-level book. Market,
+ * IOC and FOK orders can only take liquidity at the touch, and maker queue
+ * positions are estimated from changes at the touch (see handle_quote()).
+ *
+ * @param asset_id The unique identifier of the asset to be tracked.
+ * @param tick_size The minimum price movement for the asset.
+ * @param lot_size The minimum quantity increment for the asset.
+ */
+void ExecutionEngine::add_bbo_asset(int asset_id, double tick_size,
+                                    double lot_size) {
+    using namespace core::orderbook;
+    tob_books_.emplace(asset_id, TopOfBook(tick_size, lot_size));
+    register_asset(asset_id, tick_size, lot_size);
+}
+
+void ExecutionEngine::register_asset(int asset_id, double tick_size,
+                                     double lot_size) {
     tick_sizes_[asset_id] = tick_size;
     lot_sizes_[asset_id] = lot_size;
-    orderbooks_.emplace(asset_id, OrderBook(tick_size, lot_size, logger_));
     active_orders_.emplace(
-        asset_id, std::vector<std::shared_ptr<core::trading::Order>>());
+        asset_id,
+        std::pmr::vector<std::shared_ptr<core::trading::Order>>(resource_));
     maker_books_.emplace(
         asset_id,
-        MakerBook{.bid_orders_ = std::unordered_map<
-                      Ticks, std::shared_ptr<core::trading::Order>>(),
-                  .ask_orders_ = std::unordered_map<
-                      Ticks, std::shared_ptr<core::trading::Order>>()});
+        MakerBook{.bid_orders_ = std::pmr::unordered_map<
+                      Ticks, std::shared_ptr<core::trading::Order>>(resource_),
+                  .ask_orders_ = std::pmr::unordered_map<
+                      Ticks, std::shared_ptr<core::trading::Order>>(
+                      resource_)});
+    trigger_books_.emplace(asset_id,
+                           TriggerBook{StopOrders(resource_),
+                                       StopOrders(resource_)});
+    shadow_liquidity_.emplace(asset_id,
+                              ShadowLiquidity{ConsumedLevels(resource_),
+                                              ConsumedLevels(resource_)});
     if (logger_) {
         logger_->log("[ExecutionEngine] - Added asset with ID: " +
                          std::to_string(asset_id) +
@@ -65,6 +113,26 @@ void ExecutionEngine::add_asset(int asset_id, double tick_size,
     }
 }
 
+/**
+ * @brief Registers an asset whose book is fed by order-level (L3) events.
+ *
+ * The asset is set up as with add_asset(), and additionally keeps a
+ * market-by-order book. The price-level book is then derived from it, and
+ * resting maker orders get their exact FIFO queue position instead of an
+ * estimate.
+ *
+ * @param asset_id The unique identifier of the asset to be tracked.
+ * @param tick_size The minimum price movement for the asset.
+ * @param lot_size The minimum quantity increment for the asset.
+ */
+void ExecutionEngine::add_mbo_asset(int asset_id, double tick_size,
+                                    double lot_size) {
+    using namespace core::orderbook;
+    add_asset(asset_id, tick_size, lot_size);
+    mbo_books_.emplace(asset_id,
+                       MboOrderBook(tick_size, lot_size, resource_));
+}
+
 /**
  * @brief Returns true if order is inactive
  *
@@ -97,9 +165,9 @@ void ExecutionEngine::clear_from_container(
     Container &container,
     const std::function<bool(const std::shared_ptr<core::trading::Order> &)>
         &order_inactive) {
-    if constexpr (std::is_same_v<
-                      Container,
-                      std::vector<std::shared_ptr<core::trading::Order>>>) {
+    using OrderVector =
+        std::pmr::vector<std::shared_ptr<core::trading::Order>>;
+    if constexpr (std::is_same_v<Container, OrderVector>) {
         container.erase(
             std::remove_if(container.begin(), container.end(), order_inactive),
             container.end());
@@ -129,27 +197,23 @@ bool ExecutionEngine::clear_inactive_orders(int asset_id) {
         [this](const std::shared_ptr<core::trading::Order> &order) {
             return order_inactive(order);
         };
-    std::vector<std::future<void>> futures;
-    futures.push_back(std::async(std::launch::async, [this, &asset_id,
-                                                      &order_inactive_fn]() {
-        clear_from_container(active_orders_.at(asset_id), order_inactive_fn);
-    }));
-    futures.push_back(
-        std::async(std::launch::async, [this, &asset_id, &order_inactive_fn]() {
-            clear_from_container(maker_books_.at(asset_id).bid_orders_,
-                                 order_inactive_fn);
-        }));
-    futures.push_back(
-        std::async(std::launch::async, [this, &asset_id, &order_inactive_fn]() {
-            clear_from_container(maker_books_.at(asset_id).ask_orders_,
-                                 order_inactive_fn);
-        }));
-    futures.push_back(
-        std::async(std::launch::async, [this, &order_inactive_fn]() {
-            clear_from_container(orders_, order_inactive_fn);
-        }));
-    for (auto &fut : futures)
-        fut.get();
+    // inline: each container is small, and handing four of them to the pool
+    // per step cost more in wake-ups than the clearing itself
+    clear_from_container(active_orders_.at(asset_id), order_inactive_fn);
+    clear_from_container(maker_books_.at(asset_id).bid_orders_,
+                         order_inactive_fn);
+    clear_from_container(maker_books_.at(asset_id).ask_orders_,
+                         order_inactive_fn);
+    clear_from_container(orders_, order_inactive_fn);
+    // cancelled stops that never triggered
+    for (auto *stops : {&trigger_books_.at(asset_id).buy_stops_,
+                        &trigger_books_.at(asset_id).sell_stops_}) {
+        clear_from_container(*stops, order_inactive_fn);
+    }
+    for (auto it = queue_sequences_.begin(); it != queue_sequences_.end();) {
+        it = orders_.contains(it->first) ? std::next(it)
+                                         : queue_sequences_.erase(it);
+    }
     return true;
 }
 
@@ -184,6 +248,43 @@ bool ExecutionEngine::cancel_order(int asset_id, const OrderId &orderId,
     return true;
 }
 
+/**
+ * @brief Expires a GTD order whose expire time has come.
+ *
+ * Resting and untriggered stop orders are marked EXPIRED and reported to
+ * local with an EXPIRED update after the order response latency; they stop
+ * filling at once and are dropped by clear_inactive_orders(). Orders that
+ * already finished (or are unknown) are left alone.
+ *
+ * @param asset_id The ID of the asset associated with the order.
+ * @param orderId The unique identifier of the order to expire.
+ * @param current_timestamp The exchange time of the expiry.
+ * @return true if the order was expired; false otherwise.
+ */
+bool ExecutionEngine::expire_order(int asset_id, const OrderId &orderId,
+                                   const Timestamp &current_timestamp) {
+    using namespace core::trading;
+    auto it = orders_.find(orderId);
+    if (it == orders_.end() || order_inactive(it->second)) return false;
+    auto order = it->second;
+    order->orderStatus_ = OrderStatus::EXPIRED;
+    if (logger_) {
+        logger_->log("[ExecutionEngine] - " +
+                         std::to_string(current_timestamp) +
+                         "us - order expired : id=" + std::to_string(orderId),
+                     utils::logger::LogLevel::Debug);
+    }
+    order_updates_.emplace_back(
+        OrderUpdate{.exch_timestamp_ = current_timestamp,
+                    .local_timestamp_ =
+                        current_timestamp + order_response_latency_us_,
+                    .asset_id_ = asset_id,
+                    .orderId_ = orderId,
+                    .event_type_ = OrderEventType::EXPIRED,
+                    .order_ = *order});
+    return true;
+}
+
 /**
  * @brief Checks if an order with the given ID exists in the execution engine.
  *
@@ -209,7 +310,9 @@ bool ExecutionEngine::order_exists(const OrderId &orderId) const {
  * At each level, the function compares the available depth with the remaining
  * unfilled quantity of the order. If sufficient liquidity is available, it
  * performs a full fill for the remaining quantity. Otherwise, it partially
- * fills and proceeds to the next price level.
+ * fills and proceeds to the next price level. The available depth excludes
+ * what earlier taker orders consumed since the level's last update (see
+ * taker_depth()).
  *
  * All generated fills are recorded in the internal `fills_` vector, and the
  * orders `filled_quantity_` is updated accordingly. The order is passed as a
@@ -226,20 +329,23 @@ void ExecutionEngine::execute_market_order(
     using namespace core::orderbook;
     using namespace core::trading;
     if (order->orderStatus_ != OrderStatus::NEW) return;
+    const BookSide book_side =
+        (side == TradeSide::Buy) ? BookSide::Ask : BookSide::Bid;
     int level = 0;
-    int levels = (side == TradeSide::Buy)
-                     ? orderbooks_.at(asset_id).ask_levels()
-                     : orderbooks_.at(asset_id).bid_levels();
+    int levels = book_levels(asset_id, book_side);
     while (order->filled_quantity_ < order->quantity_ && level < levels) {
-        Quantity level_depth =
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).depth_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).depth_at_level(BookSide::Bid, level);
         Ticks level_price_ticks =
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).price_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).price_at_level(BookSide::Bid, level);
+            book_price_at_level(asset_id, book_side, level);
+        Quantity level_depth =
+            taker_depth(asset_id, book_side, level, level_price_ticks);
         Price level_price = level_price_ticks * tick_sizes_[asset_id];
+        if (level_depth <= 0.0) { // taken by earlier orders
+            level++;
+            continue;
+        }
+        consume_liquidity(
+            asset_id, book_side, level_price_ticks,
+            std::min(level_depth, order->quantity_ - order->filled_quantity_));
         if (level_depth > (order->quantity_ - order->filled_quantity_)) {
             fills_.emplace_back(
                 Fill{.asset_id_ = asset_id,
@@ -329,23 +435,19 @@ bool ExecutionEngine::execute_fok_order(
     using namespace core::orderbook;
     using namespace core::trading;
     if (order->orderStatus_ != OrderStatus::NEW) return false;
+    const BookSide book_side =
+        (side == TradeSide::Buy) ? BookSide::Ask : BookSide::Bid;
     int level = -1;
-    int levels = (side == TradeSide::Buy)
-                     ? orderbooks_.at(asset_id).ask_levels()
-                     : orderbooks_.at(asset_id).bid_levels();
+    int levels = book_levels(asset_id, book_side);
     Quantity available_qty = 0.0;
     while (++level < levels && available_qty < order->quantity_) {
         Ticks level_price_ticks =
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).price_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).price_at_level(BookSide::Bid, level);
+            book_price_at_level(asset_id, book_side, level);
         Price level_price = level_price_ticks * tick_sizes_[asset_id];
         if (side == TradeSide::Buy && level_price > order->price_) break;
         if (side == TradeSide::Sell && level_price < order->price_) break;
         available_qty +=
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).depth_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).depth_at_level(BookSide::Bid, level);
+            taker_depth(asset_id, book_side, level, level_price_ticks);
     }
     if (available_qty < order->quantity_) {
         order->orderStatus_ = OrderStatus::REJECTED;
@@ -361,17 +463,17 @@ bool ExecutionEngine::execute_fok_order(
     }
     level = -1;
     while (++level < levels && order->filled_quantity_ < order->quantity_) {
-        Quantity level_depth =
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).depth_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).depth_at_level(BookSide::Bid, level);
         Ticks level_price_ticks =
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).price_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).price_at_level(BookSide::Bid, level);
+            book_price_at_level(asset_id, book_side, level);
+        Quantity level_depth =
+            taker_depth(asset_id, book_side, level, level_price_ticks);
         Price level_price = level_price_ticks * tick_sizes_[asset_id];
         if (side == TradeSide::Buy && level_price > order->price_) break;
         if (side == TradeSide::Sell && level_price < order->price_) break;
+        if (level_depth <= 0.0) continue; // taken by earlier orders
+        consume_liquidity(
+            asset_id, book_side, level_price_ticks,
+            std::min(level_depth, order->quantity_ - order->filled_quantity_));
         if (level_depth > (order->quantity_ - order->filled_quantity_)) {
             fills_.emplace_back(
                 Fill{.asset_id_ = asset_id,
@@ -469,22 +571,25 @@ bool ExecutionEngine::execute_ioc_order(
         }
         return false;
     }
+    const BookSide book_side =
+        (side == TradeSide::Buy) ? BookSide::Ask : BookSide::Bid;
     int level = 0;
-    int levels = (side == TradeSide::Buy)
-                     ? orderbooks_.at(asset_id).ask_levels()
-                     : orderbooks_.at(asset_id).bid_levels();
+    int levels = book_levels(asset_id, book_side);
     while (level < levels && order->filled_quantity_ < order->quantity_) {
         Ticks level_price_ticks =
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).price_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).price_at_level(BookSide::Bid, level);
+            book_price_at_level(asset_id, book_side, level);
         Price level_price = level_price_ticks * tick_sizes_[asset_id];
         if (side == TradeSide::Buy && level_price > order->price_) break;
         if (side == TradeSide::Sell && level_price < order->price_) break;
         Quantity level_depth =
-            (side == TradeSide::Buy)
-                ? orderbooks_.at(asset_id).depth_at_level(BookSide::Ask, level)
-                : orderbooks_.at(asset_id).depth_at_level(BookSide::Bid, level);
+            taker_depth(asset_id, book_side, level, level_price_ticks);
+        if (level_depth <= 0.0) { // taken by earlier orders
+            level++;
+            continue;
+        }
+        consume_liquidity(
+            asset_id, book_side, level_price_ticks,
+            std::min(level_depth, order->quantity_ - order->filled_quantity_));
         if (level_depth > (order->quantity_ - order->filled_quantity_)) {
             Fill fill = {.asset_id_ = asset_id,
                          .exch_timestamp_ = order->exch_timestamp_,
@@ -592,8 +697,8 @@ bool ExecutionEngine::place_maker_order(
     int asset_id, std::shared_ptr<core::trading::Order> order) {
     using namespace core::orderbook;
     using namespace core::trading;
-    Price best_ask = orderbooks_.at(asset_id).best_ask();
-    Price best_bid = orderbooks_.at(asset_id).best_bid();
+    Price best_ask = book_best_price(asset_id, BookSide::Ask);
+    Price best_bid = book_best_price(asset_id, BookSide::Bid);
     if ((order->side_ == BookSide::Bid && best_ask > 0.0 &&
          order->price_ >= best_ask) ||
         (order->side_ == BookSide::Ask && best_bid > 0.0 &&
@@ -611,8 +716,19 @@ bool ExecutionEngine::place_maker_order(
     }
     Ticks order_price_ticks =
         utils::math::price_to_ticks(order->price_, tick_sizes_[asset_id]);
-    order->queueEst_ =
-        orderbooks_.at(asset_id).depth_at(order->side_, order_price_ticks);
+    if (auto tob_it = tob_books_.find(asset_id); tob_it != tob_books_.end()) {
+        const auto estimate = touch_queue_estimate(
+            tob_it->second, order->side_, order_price_ticks);
+        order->queue_known_ = estimate.has_value();
+        order->queueEst_ = estimate.value_or(0.0);
+    } else {
+        order->queueEst_ =
+            orderbooks_.at(asset_id).depth_at(order->side_, order_price_ticks);
+    }
+    if (auto mbo_it = mbo_books_.find(asset_id); mbo_it != mbo_books_.end()) {
+        // joins the back of the queue: everything resting now is ahead
+        queue_sequences_[order->orderId_] = mbo_it->second.next_sequence();
+    }
     if (order->side_ == BookSide::Bid)
         maker_books_.at(asset_id).bid_orders_[order_price_ticks] = order;
     else
@@ -640,13 +756,162 @@ bool ExecutionEngine::place_maker_order(
     return true;
 }
 
+/**
+ * @brief Rests a stop order in the asset's trigger book until the market
+ * reaches its stop price.
+ *
+ * A buy stop triggers once a trade prints, or the best ask is, at or above
+ * its stop price; a sell stop once a trade prints, or the best bid is, at
+ * or below it. A stop whose price has already been reached when it arrives
+ * triggers at once. On triggering, a STOP_MARKET order executes as a market
+ * order and a STOP_LIMIT order as a limit order with its time in force (so
+ * a GTC stop-limit is post-only, as other GTC orders are). A taker stop that
+ * does not fill completely reports the rest as cancelled, or the whole order
+ * as rejected if nothing filled.
+ *
+ * @param asset_id Identifier of the traded asset.
+ * @param side Direction of the order once triggered.
+ * @param order The stop order; `stop_price_` must be positive.
+ * @return true if the order was accepted; false if it was rejected.
+ */
+bool ExecutionEngine::place_stop_order(
+    int asset_id, TradeSide side, std::shared_ptr<core::trading::Order> order) {
+    using namespace core::trading;
+    if (order->orderStatus_ != OrderStatus::NEW) return false;
+    if (order->stop_price_ <= 0.0) {
+        order->orderStatus_ = OrderStatus::REJECTED;
+        return false;
+    }
+    const Ticks stop_ticks =
+        utils::math::price_to_ticks(order->stop_price_, tick_sizes_[asset_id]);
+    auto &trigger_book = trigger_books_.at(asset_id);
+    if (side == TradeSide::Buy)
+        trigger_book.buy_stops_.emplace(stop_ticks, order);
+    else
+        trigger_book.sell_stops_.emplace(stop_ticks, order);
+    orders_[order->orderId_] = order;
+    order->orderStatus_ = OrderStatus::ACTIVE;
+    if (logger_) {
+        logger_->log(
+            "[ExecutionEngine] - " + std::to_string(order->exch_timestamp_) +
+                "us - stop " + ((side == TradeSide::Buy) ? "buy" : "sell") +
+                " order placed : id=" + std::to_string(order->orderId_) +
+                ", stop=" + std::to_string(order->stop_price_) +
+                ", qty=" + std::to_string(order->quantity_),
+            utils::logger::LogLevel::Debug);
+    }
+    order_updates_.emplace_back(OrderUpdate{
+        .exch_timestamp_ = order->exch_timestamp_,
+        .local_timestamp_ = order->exch_timestamp_ + order_response_latency_us_,
+        .asset_id_ = asset_id,
+        .orderId_ = order->orderId_,
+        .event_type_ = OrderEventType::ACKNOWLEDGED,
+        .order_ = *order});
+    check_book_triggers(asset_id, order->exch_timestamp_);
+    return true;
+}
+
+/**
+ * @brief Returns the number of stop orders of an asset that have not
+ * triggered yet (including cancelled ones not cleared yet).
+ */
+std::size_t ExecutionEngine::pending_stops(int asset_id) const {
+    const auto &trigger_book = trigger_books_.at(asset_id);
+    return trigger_book.buy_stops_.size() + trigger_book.sell_stops_.size();
+}
+
+/**
+ * @brief Fires the stops that the current best bid and offer have reached.
+ */
+void ExecutionEngine::check_book_triggers(int asset_id, Timestamp timestamp) {
+    const auto &trigger_book = trigger_books_.at(asset_id);
+    if (trigger_book.buy_stops_.empty() && trigger_book.sell_stops_.empty())
+        return;
+    const Ticks best_ask = book_levels(asset_id, BookSide::Ask) > 0
+                               ? book_price_at_level(asset_id, BookSide::Ask, 0)
+                               : 0;
+    const Ticks best_bid = book_levels(asset_id, BookSide::Bid) > 0
+                               ? book_price_at_level(asset_id, BookSide::Bid, 0)
+                               : 0;
+    fire_triggers(asset_id, best_ask, best_bid, timestamp);
+}
+
+/**
+ * @brief Triggers every buy stop at or below @p buy_reference and every sell
+ * stop at or above @p sell_reference (0 meaning no price), in the order a
+ * moving market reaches them: lowest buy stops and highest sell stops first.
+ *
+ * Both trigger books are sorted by stop price, so only the fired stops are
+ * visited: O(log n + k) for n resting and k fired stops.
+ */
+void ExecutionEngine::fire_triggers(int asset_id, Ticks buy_reference,
+                                    Ticks sell_reference,
+                                    Timestamp timestamp) {
+    using namespace core::trading;
+    auto &trigger_book = trigger_books_.at(asset_id);
+    std::vector<std::shared_ptr<Order>> fired;
+    if (buy_reference != 0 && !trigger_book.buy_stops_.empty()) {
+        auto &stops = trigger_book.buy_stops_;
+        const auto last = stops.upper_bound(buy_reference);
+        for (auto it = stops.begin(); it != last; ++it)
+            fired.push_back(it->second);
+        stops.erase(stops.begin(), last);
+    }
+    if (sell_reference != 0 && !trigger_book.sell_stops_.empty()) {
+        auto &stops = trigger_book.sell_stops_;
+        const auto first = stops.lower_bound(sell_reference);
+        for (auto it = stops.end(); it != first;)
+            fired.push_back((--it)->second);
+        stops.erase(first, stops.end());
+    }
+    for (const auto &order : fired) {
+        if (order->orderStatus_ != OrderStatus::ACTIVE) continue; // cancelled
+        const TradeSide side =
+            (order->side_ == BookSide::Bid) ? TradeSide::Buy : TradeSide::Sell;
+        order->exch_timestamp_ = timestamp;
+        order->orderStatus_ = OrderStatus::NEW;
+        if (logger_) {
+            logger_->log("[ExecutionEngine] - " + std::to_string(timestamp) +
+                             "us - stop order triggered : id=" +
+                             std::to_string(order->orderId_),
+                         utils::logger::LogLevel::Debug);
+        }
+        bool resting = false;
+        if (order->orderType_ == OrderType::STOP_MARKET) {
+            execute_market_order(asset_id, side, order);
+        } else if (order->tif_ == TimeInForce::FOK) {
+            execute_fok_order(asset_id, side, order);
+        } else if (order->tif_ == TimeInForce::IOC) {
+            execute_ioc_order(asset_id, side, order);
+        } else {
+            resting = place_maker_order(asset_id, order);
+        }
+        if (resting || order->orderStatus_ == OrderStatus::FILLED) continue;
+        // takers do not rest: report what is left of the order
+        const bool none_filled = order->filled_quantity_ == 0.0;
+        order->orderStatus_ =
+            none_filled ? OrderStatus::REJECTED : OrderStatus::CANCELLED;
+        order_updates_.emplace_back(
+            OrderUpdate{.exch_timestamp_ = timestamp,
+                        .local_timestamp_ =
+                            timestamp + order_response_latency_us_,
+                        .asset_id_ = asset_id,
+                        .orderId_ = order->orderId_,
+                        .event_type_ = none_filled ? OrderEventType::REJECTED
+                                                   : OrderEventType::CANCELLED,
+                        .order_ = *order});
+    }
+}
+
 /**
  * @brief Submits a new order to the execution engine.
  *
  * This function routes the submitted order to the appropriate execution path
  * based on its order type (e.g., MARKET, LIMIT) and time-in-force (TIF)
  * directive (e.g., FOK, IOC, GTC). Market orders are executed immediately,
- * while limit orders are processed according to their TIF policy.
+ * while limit orders are processed according to their TIF policy. GTD limit
+ * orders rest as GTC ones do; one arriving at or after its expire time is
+ * expired on arrival.
  *
  * @param asset_id The unique identifier for the asset this order applies to.
  * @param side The side of the trade (Buy or Sell).
@@ -666,9 +931,27 @@ bool ExecutionEngine::execute_order(int asset_id, TradeSide side,
                 ", qty=" + std::to_string(order.quantity_),
             utils::logger::LogLevel::Debug);
     }
-    auto order_ptr = std::make_shared<core::trading::Order>(order);
+    auto order_ptr = std::allocate_shared<core::trading::Order>(
+        std::pmr::polymorphic_allocator<core::trading::Order>(resource_),
+        order);
+    if (order.tif_ == TimeInForce::GTD &&
+        order.expire_time_ <= order.exch_timestamp_) {
+        order_ptr->orderStatus_ = OrderStatus::EXPIRED;
+        order_updates_.emplace_back(OrderUpdate{
+            .exch_timestamp_ = order.exch_timestamp_,
+            .local_timestamp_ =
+                order.exch_timestamp_ + order_response_latency_us_,
+            .asset_id_ = asset_id,
+            .orderId_ = order.orderId_,
+            .event_type_ = OrderEventType::EXPIRED,
+            .order_ = *order_ptr});
+        return false;
+    }
     if (order.orderType_ == OrderType::MARKET) {
         execute_market_order(asset_id, side, order_ptr);
+    } else if (order.orderType_ == OrderType::STOP_MARKET ||
+               order.orderType_ == OrderType::STOP_LIMIT) {
+        return place_stop_order(asset_id, side, order_ptr);
     } else if (order.orderType_ == OrderType::LIMIT) {
         switch (order.tif_) {
         case TimeInForce::FOK:
@@ -678,6 +961,7 @@ bool ExecutionEngine::execute_order(int asset_id, TradeSide side,
             return execute_ioc_order(asset_id, side, order_ptr);
             break;
         case TimeInForce::GTC:
+        case TimeInForce::GTD:
             return place_maker_order(asset_id, order_ptr);
             break;
         default:
@@ -713,6 +997,12 @@ bool ExecutionEngine::execute_order(int asset_id, TradeSide side,
  * @param book_update The update event (side, price, new quantity).
  */
 void ExecutionEngine::handle_book_update(
+    int asset_id, const core::market_data::BookUpdate &book_update) {
+    apply_book_update(asset_id, book_update);
+    check_book_triggers(asset_id, book_update.exch_timestamp_);
+}
+
+void ExecutionEngine::apply_book_update(
     int asset_id, const core::market_data::BookUpdate &book_update) {
     using namespace core::orderbook;
     using namespace core::market_data;
@@ -721,40 +1011,345 @@ void ExecutionEngine::handle_book_update(
     // update queue position estimationsO
     Quantity Q_n = orderbooks_.at(asset_id).depth_at(book_update.side_,
                                                      book_update_price_ticks);
-    Quantity deltaQ_n = book_update.quantity_ - Q_n;
-    if (deltaQ_n < 0) {
-        if (book_update.side_ == BookSide::Bid) {
-            auto it = maker_books_.at(asset_id).bid_orders_.find(
-                book_update_price_ticks);
-            if (it != maker_books_.at(asset_id).bid_orders_.end()) {
-                Quantity S =
-                    it->second->quantity_ - it->second->filled_quantity_;
-                Quantity V_n = it->second->queueEst_;
-                double p_n =
-                    (f(V_n) > 0.0)
-                        ? (f(V_n) / (f(V_n) + f(std::max(Q_n - S - V_n, 0.0))))
-                        : 0.0;
-                Quantity V_nplus1 = std::max(V_n + p_n * deltaQ_n, 0.0);
-                it->second->queueEst_ = V_nplus1;
+    auto &maker_book = maker_books_.at(asset_id);
+    auto &orders = (book_update.side_ == BookSide::Bid)
+                       ? maker_book.bid_orders_
+                       : maker_book.ask_orders_;
+    if (auto it = orders.find(book_update_price_ticks); it != orders.end()) {
+        advance_queue(*it->second, Q_n, book_update.quantity_);
+    }
+    // update orderbook
+    orderbooks_.at(asset_id).apply_book_update(book_update);
+    if (book_update.update_type_ == UpdateType::Snapshot) {
+        clear_shadow_liquidity(asset_id);
+    } else {
+        reconcile_liquidity(asset_id, book_update.side_,
+                            book_update_price_ticks);
+    }
+}
+
+/**
+ * @brief Advances the queue estimate of a maker order after the depth of its
+ * level changed from @p old_depth to @p new_depth; see handle_book_update().
+ */
+void ExecutionEngine::advance_queue(core::trading::Order &order,
+                                    Quantity old_depth, Quantity new_depth) {
+    Quantity deltaQ_n = new_depth - old_depth;
+    if (deltaQ_n >= 0) return;
+    Quantity S = order.quantity_ - order.filled_quantity_;
+    Quantity V_n = order.queueEst_;
+    double p_n =
+        (f(V_n) > 0.0)
+            ? (f(V_n) / (f(V_n) + f(std::max(old_depth - S - V_n, 0.0))))
+            : 0.0;
+    order.queueEst_ = std::max(V_n + p_n * deltaQ_n, 0.0);
+}
+
+/**
+ * @brief Returns the depth at @p price on the side of row @p i just before
+ * that row applies, given that @p book has not seen any row of @p rows yet.
+ */
+Quantity ExecutionEngine::depth_before_row(
+    const core::orderbook::OrderBook &book,
+    const std::vector<core::market_data::BookUpdate> &rows, std::size_t i,
+    Ticks price, double tick_size) const {
+    const BookSide side = rows[i].side_;
+    for (std::size_t j = i; j-- > 0;) {
+        const auto &row = rows[j];
+        if (row.side_ == side &&
+            utils::math::price_to_ticks(row.price_, tick_size) == price) {
+            return row.quantity_;
+        }
+        // a snapshot row following an incremental one cleared the book
+        const UpdateType before =
+            (j == 0) ? book.last_update_type() : rows[j - 1].update_type_;
+        if (row.update_type_ == UpdateType::Snapshot &&
+            before == UpdateType::Incremental) {
+            return 0.0;
+        }
+    }
+    return book.depth_at(side, price);
+}
+
+/**
+ * @brief Processes a book update batch in one pass.
+ *
+ * The result matches handling each row with `handle_book_update()`, but the
+ * asset's books and tick size are looked up once and the price-level book
+ * applies the batch grouped by level (see OrderBook::apply_book_updates()).
+ * Queue estimates still see every row that lands on one of our maker
+ * orders, with the depth that row replaces. Shadow liquidity is cleared
+ * once if the batch holds a snapshot row, and stop orders are checked once,
+ * against the book after the whole batch.
+ *
+ * @param asset_id The ID of the asset this batch pertains to.
+ * @param book_batch The grouped book updates.
+ */
+void ExecutionEngine::handle_book_update_batch(
+    int asset_id, const core::market_data::BookUpdateBatch &book_batch) {
+    using namespace core::market_data;
+    auto &book = orderbooks_.at(asset_id);
+    auto &maker_book = maker_books_.at(asset_id);
+    auto &shadow = shadow_liquidity_.at(asset_id);
+    const double tick_size = tick_sizes_.at(asset_id);
+    const auto &rows = book_batch.updates_;
+
+    // queue estimates need the depth each row replaces, so they go first
+    bool snapshot = false;
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const auto &row = rows[i];
+        snapshot = snapshot || row.update_type_ == UpdateType::Snapshot;
+        auto &orders = (row.side_ == BookSide::Bid) ? maker_book.bid_orders_
+                                                    : maker_book.ask_orders_;
+        if (orders.empty()) continue;
+        const Ticks price = utils::math::price_to_ticks(row.price_, tick_size);
+        if (auto it = orders.find(price); it != orders.end()) {
+            advance_queue(*it->second,
+                          depth_before_row(book, rows, i, price, tick_size),
+                          row.quantity_);
+        }
+    }
+    book.apply_book_updates(book_batch);
+    if (snapshot) {
+        clear_shadow_liquidity(asset_id);
+    } else if (!shadow.bid_consumed_.empty() ||
+               !shadow.ask_consumed_.empty()) {
+        for (const auto &row : rows) {
+            reconcile_liquidity(
+                asset_id, row.side_,
+                utils::math::price_to_ticks(row.price_, tick_size));
+        }
+    }
+    check_book_triggers(asset_id, book_batch.exch_timestamp_);
+}
+
+/**
+ * @brief Processes an order-level (L3) book event.
+ *
+ * The event is applied to the asset's market-by-order book, the aggregate
+ * quantity of every touched price level is written through to the price-level
+ * book (keeping the event's local timestamp, so the local view lags as usual),
+ * and any of our maker orders resting on a touched level get their exact
+ * queue position: the quantity of orders that joined the level before them.
+ *
+ * @param asset_id The ID of the asset; must have been added with
+ * add_mbo_asset().
+ * @param mbo_update The order-level event.
+ */
+void ExecutionEngine::handle_mbo_update(
+    int asset_id, const core::market_data::MboUpdate &mbo_update) {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+    auto &mbo_book = mbo_books_.at(asset_id);
+    std::array<MboOrderBook::LevelKey, 2> touched;
+    int n = mbo_book.apply(mbo_update, touched);
+    for (int i = 0; i < n; ++i) {
+        const auto &key = touched[i];
+        orderbooks_.at(asset_id).apply_book_update(BookUpdate{
+            .exch_timestamp_ = mbo_update.exch_timestamp_,
+            .local_timestamp_ = mbo_update.local_timestamp_,
+            .update_type_ = UpdateType::Incremental,
+            .side_ = key.side_,
+            .price_ = utils::math::ticks_to_price(key.price_,
+                                                  tick_sizes_[asset_id]),
+            .quantity_ = mbo_book.depth_at(key.side_, key.price_)});
+        reconcile_liquidity(asset_id, key.side_, key.price_);
+        update_exact_queue(asset_id, key.side_, key.price_);
+    }
+    check_book_triggers(asset_id, mbo_update.exch_timestamp_);
+}
+
+/**
+ * @brief Sets the queue position of our maker order at a level, if any, to
+ * the exact quantity resting ahead of it in the market-by-order book.
+ */
+void ExecutionEngine::update_exact_queue(int asset_id, BookSide side,
+                                         Ticks price) {
+    auto &maker_book = maker_books_.at(asset_id);
+    auto &orders = (side == BookSide::Bid) ? maker_book.bid_orders_
+                                           : maker_book.ask_orders_;
+    auto it = orders.find(price);
+    if (it == orders.end()) return;
+    auto seq_it = queue_sequences_.find(it->second->orderId_);
+    if (seq_it == queue_sequences_.end()) return;
+    it->second->queueEst_ =
+        mbo_books_.at(asset_id).volume_ahead(side, price, seq_it->second);
+}
+
+/**
+ * @brief Processes a best bid/offer update for an asset added with
+ * add_bbo_asset().
+ *
+ * Only the touch is visible, so queue positions are tracked from it:
+ * - If the touch stays at the price of one of our orders and its size
+ *   shrinks, the estimate advances with the same probabilistic model as
+ *   handle_book_update().
+ * - If the touch moves behind our order (or the side empties), everything
+ *   that was ahead of us is gone and the estimate drops to 0.
+ * - If a level we rest on becomes the touch, the estimate is capped at the
+ *   visible size, since at most that much can still be ahead of us.
+ *
+ * @param asset_id The ID of the asset.
+ * @param quote The best bid/offer update.
+ */
+void ExecutionEngine::handle_quote(int asset_id,
+                                   const core::market_data::Quote &quote) {
+    auto &tob = tob_books_.at(asset_id);
+    const Ticks old_bid = tob.price_at_level(BookSide::Bid, 0);
+    const Ticks old_ask = tob.price_at_level(BookSide::Ask, 0);
+    const Quantity old_bid_qty = tob.depth_at_level(BookSide::Bid, 0);
+    const Quantity old_ask_qty = tob.depth_at_level(BookSide::Ask, 0);
+    tob.apply_quote(quote);
+    // a quote restates both touches
+    clear_shadow_liquidity(asset_id);
+    update_touch_queue(asset_id, BookSide::Bid, old_bid, old_bid_qty);
+    update_touch_queue(asset_id, BookSide::Ask, old_ask, old_ask_qty);
+    check_book_triggers(asset_id, quote.exch_timestamp_);
+}
+
+/**
+ * @brief Updates queue estimates of our maker orders on one side after the
+ * touch of that side moved from (@p old_price, @p old_quantity).
+ */
+void ExecutionEngine::update_touch_queue(int asset_id, BookSide side,
+                                         Ticks old_price,
+                                         Quantity old_quantity) {
+    const auto &tob = tob_books_.at(asset_id);
+    const Ticks new_price = tob.price_at_level(side, 0);
+    const Quantity new_quantity = tob.depth_at_level(side, 0);
+    auto &maker_book = maker_books_.at(asset_id);
+    auto &orders = (side == BookSide::Bid) ? maker_book.bid_orders_
+                                           : maker_book.ask_orders_;
+    for (auto &[price, order] : orders) {
+        // touch is strictly worse than our price (or gone): we are at front
+        bool passed = new_price == 0 || ((side == BookSide::Bid)
+                                             ? new_price < price
+                                             : new_price > price);
+        if (passed) {
+            order->queueEst_ = 0.0;
+            order->queue_known_ = true;
+        } else if (!order->queue_known_) {
+            // our level just became the touch: all of it is ahead of us
+            if (price == new_price) {
+                order->queueEst_ = new_quantity;
+                order->queue_known_ = true;
             }
-        } else if (book_update.side_ == BookSide::Ask) {
-            auto it = maker_books_.at(asset_id).ask_orders_.find(
-                book_update_price_ticks);
-            if (it != maker_books_.at(asset_id).ask_orders_.end()) {
-                Quantity S =
-                    it->second->quantity_ - it->second->filled_quantity_;
-                Quantity V_n = it->second->queueEst_;
-                double p_n =
-                    (f(V_n) > 0.0)
-                        ? (f(V_n) / (f(V_n) + f(std::max(Q_n - S - V_n, 0.0))))
-                        : 0.0;
-                Quantity V_nplus1 = std::max(V_n + p_n * deltaQ_n, 0.0);
-                it->second->queueEst_ = V_nplus1;
+        } else if (price == new_price && price == old_price) {
+            Quantity deltaQ_n = new_quantity - old_quantity;
+            if (deltaQ_n < 0) {
+                Quantity S = order->quantity_ - order->filled_quantity_;
+                Quantity V_n = order->queueEst_;
+                double p_n = (f(V_n) > 0.0)
+                                 ? (f(V_n) / (f(V_n) +
+                                              f(std::max(old_quantity - S - V_n,
+                                                         0.0))))
+                                 : 0.0;
+                order->queueEst_ = std::max(V_n + p_n * deltaQ_n, 0.0);
             }
+        } else if (price == new_price) {
+            order->queueEst_ = std::min(order->queueEst_, new_quantity);
         }
     }
-    // update orderbook
-    orderbooks_.at(asset_id).apply_book_update(book_update);
+}
+
+/**
+ * @brief Returns the initial queue estimate of a maker order on a
+ * top-of-book-only asset.
+ *
+ * At the touch everything visible is ahead; inside the spread nothing is.
+ * Behind the touch the depth is unknown and std::nullopt is returned; the
+ * order cannot fill until its level becomes the touch (see
+ * update_touch_queue()).
+ */
+std::optional<Quantity>
+ExecutionEngine::touch_queue_estimate(const core::orderbook::TopOfBook &tob,
+                                      BookSide side, Ticks price) const {
+    const Ticks touch = tob.price_at_level(side, 0);
+    if (touch == price) return tob.depth_at_level(side, 0);
+    bool behind = touch != 0 &&
+                  ((side == BookSide::Bid) ? price < touch : price > touch);
+    if (behind) return std::nullopt;
+    return 0.0;
+}
+
+int ExecutionEngine::book_levels(int asset_id, BookSide side) const {
+    if (auto it = tob_books_.find(asset_id); it != tob_books_.end()) {
+        return (side == BookSide::Bid) ? it->second.bid_levels()
+                                       : it->second.ask_levels();
+    }
+    const auto &book = orderbooks_.at(asset_id);
+    return (side == BookSide::Bid) ? book.bid_levels() : book.ask_levels();
+}
+
+Quantity ExecutionEngine::book_depth_at_level(int asset_id, BookSide side,
+                                              int level) const {
+    if (auto it = tob_books_.find(asset_id); it != tob_books_.end()) {
+        return it->second.depth_at_level(side, level);
+    }
+    return orderbooks_.at(asset_id).depth_at_level(side, level);
+}
+
+Ticks ExecutionEngine::book_price_at_level(int asset_id, BookSide side,
+                                           int level) const {
+    if (auto it = tob_books_.find(asset_id); it != tob_books_.end()) {
+        return it->second.price_at_level(side, level);
+    }
+    return orderbooks_.at(asset_id).price_at_level(side, level);
+}
+
+Price ExecutionEngine::book_best_price(int asset_id, BookSide side) const {
+    if (auto it = tob_books_.find(asset_id); it != tob_books_.end()) {
+        return (side == BookSide::Bid) ? it->second.best_bid()
+                                       : it->second.best_ask();
+    }
+    const auto &book = orderbooks_.at(asset_id);
+    return (side == BookSide::Bid) ? book.best_bid() : book.best_ask();
+}
+
+/**
+ * @brief Returns the depth a taker order can still take at a level: the
+ * displayed depth less what our earlier taker orders consumed from it since
+ * its last update.
+ *
+ * The replayed book is never modified, so repeated aggressive orders between
+ * two book updates walk deeper into the book instead of all filling against
+ * the same displayed size.
+ */
+Quantity ExecutionEngine::taker_depth(int asset_id, BookSide side, int level,
+                                      Ticks price) const {
+    const Quantity depth = book_depth_at_level(asset_id, side, level);
+    const auto &shadow = shadow_liquidity_.at(asset_id);
+    const auto &consumed = (side == BookSide::Bid) ? shadow.bid_consumed_
+                                                   : shadow.ask_consumed_;
+    if (consumed.empty()) return depth;
+    const auto it = consumed.find(price);
+    return (it == consumed.end()) ? depth : std::max(depth - it->second, 0.0);
+}
+
+void ExecutionEngine::consume_liquidity(int asset_id, BookSide side,
+                                        Ticks price, Quantity quantity) {
+    auto &shadow = shadow_liquidity_.at(asset_id);
+    auto &consumed = (side == BookSide::Bid) ? shadow.bid_consumed_
+                                             : shadow.ask_consumed_;
+    consumed[price] += quantity;
+}
+
+/**
+ * @brief Forgets what was consumed from a level once a real update for it
+ * arrives, since the update states the level's quantity afresh.
+ */
+void ExecutionEngine::reconcile_liquidity(int asset_id, BookSide side,
+                                          Ticks price) {
+    auto &shadow = shadow_liquidity_.at(asset_id);
+    auto &consumed = (side == BookSide::Bid) ? shadow.bid_consumed_
+                                             : shadow.ask_consumed_;
+    if (!consumed.empty()) consumed.erase(price);
+}
+
+void ExecutionEngine::clear_shadow_liquidity(int asset_id) {
+    auto &shadow = shadow_liquidity_.at(asset_id);
+    shadow.bid_consumed_.clear();
+    shadow.ask_consumed_.clear();
 }
 
 /**
@@ -775,7 +1370,8 @@ void ExecutionEngine::handle_book_update(
  *   portion of the resting order.
  *
  * If all conditions are met, a fill is created and stored in the internal
- * `fills_` list.
+ * `fills_` list. Afterwards the trade price triggers any stop orders it has
+ * reached.
  *
  * @param asset_id Identifier for the asset being traded.
  * @param trade Incoming trade information (price, quantity, side, timestamp,
@@ -783,6 +1379,18 @@ void ExecutionEngine::handle_book_update(
  */
 void ExecutionEngine::handle_trade(int asset_id,
                                    const core::market_data::Trade &trade) {
+    fill_maker_order(asset_id, trade);
+    const auto &trigger_book = trigger_books_.at(asset_id);
+    if (!trigger_book.buy_stops_.empty() || !trigger_book.sell_stops_.empty()) {
+        const Ticks trade_price_ticks =
+            utils::math::price_to_ticks(trade.price_, tick_sizes_[asset_id]);
+        fire_triggers(asset_id, trade_price_ticks, trade_price_ticks,
+                      trade.exch_timestamp_);
+    }
+}
+
+void ExecutionEngine::fill_maker_order(int asset_id,
+                                       const core::market_data::Trade &trade) {
     using namespace core::trading;
     using namespace core::market_data;
     const auto trade_price_ticks =
@@ -835,6 +1443,8 @@ void ExecutionEngine::handle_trade(int asset_id,
     auto order = it->second;
 
     if (order->exch_timestamp_ >= trade.exch_timestamp_) return;
+    // cancelled or expired, but not cleared yet
+    if (order_inactive(order)) return;
     if (logger_) {
         logger_->log(
             "[ExecutionEngine] - " + std::to_string(trade.exch_timestamp_) +
@@ -842,7 +1452,8 @@ void ExecutionEngine::handle_trade(int asset_id,
                 ") found at trade price " + std::to_string(order->price_),
             utils::logger::LogLevel::Debug);
     }
-    if (order->queueEst_ == 0.0 && order->filled_quantity_ < order->quantity_) {
+    if (order->queue_known_ && order->queueEst_ == 0.0 &&
+        order->filled_quantity_ < order->quantity_) {
         Quantity fill_qty = std::min(
             trade.quantity_, order->quantity_ - order->filled_quantity_);
         order->filled_quantity_ += fill_qty;
@@ -895,6 +1506,28 @@ void ExecutionEngine::handle_trade(int asset_id,
     }
 }
 
+/**
+ * @brief Returns the exchange-side order book of an asset.
+ *
+ * @param asset_id The ID of the asset.
+ * @return A reference to the asset's order book.
+ * @throws std::out_of_range if the asset has not been added.
+ */
+core::orderbook::OrderBook &ExecutionEngine::orderbook(int asset_id) {
+    return orderbooks_.at(asset_id);
+}
+
+/**
+ * @brief Returns the exchange-side best bid/offer of an asset added with
+ * add_bbo_asset().
+ *
+ * @throws std::out_of_range if the asset is not top-of-book only.
+ */
+const core::orderbook::TopOfBook &
+ExecutionEngine::top_of_book(int asset_id) const {
+    return tob_books_.at(asset_id);
+}
+
 /**
  * @brief Returns a read-only reference to the list of order updates.
  *
@@ -935,6 +1568,55 @@ const std::vector<core::trading::Fill> &ExecutionEngine::fills() const {
  */
 void ExecutionEngine::clear_fills() { fills_.clear(); }
 
+/**
+ * @brief Hashes the exchange-side state of an asset for replay verification:
+ * its book and every resting order of ours, including fill progress and
+ * queue position.
+ */
+std::uint64_t ExecutionEngine::state_hash(int asset_id) const {
+    using utils::hash::combine;
+    using utils::hash::combine_double;
+    std::uint64_t h = 0;
+    if (auto tob = tob_books_.find(asset_id); tob != tob_books_.end()) {
+        h = combine_double(h, tob->second.best_bid());
+        h = combine_double(h, tob->second.depth_at_level(BookSide::Bid, 0));
+        h = combine_double(h, tob->second.best_ask());
+        h = combine_double(h, tob->second.depth_at_level(BookSide::Ask, 0));
+    } else {
+        h = orderbooks_.at(asset_id).state_hash();
+    }
+    for (const auto &order : active_orders_.at(asset_id)) {
+        h = combine(h, order->orderId_);
+        h = combine_double(h, order->price_);
+        h = combine_double(h, order->quantity_);
+        h = combine_double(h, order->filled_quantity_);
+        h = combine_double(h, order->queueEst_);
+        h = combine(h, static_cast<std::uint64_t>(order->queue_known_));
+        h = combine(h, static_cast<std::uint64_t>(order->orderStatus_));
+    }
+    const auto &trigger_book = trigger_books_.at(asset_id);
+    for (const auto *stops :
+         {&trigger_book.buy_stops_, &trigger_book.sell_stops_}) {
+        for (const auto &[stop_ticks, order] : *stops) {
+            h = combine(h, stop_ticks);
+            h = combine(h, order->orderId_);
+            h = combine(h, static_cast<std::uint64_t>(order->orderStatus_));
+        }
+    }
+    // unordered: combined so the result does not depend on iteration order
+    const auto &shadow = shadow_liquidity_.at(asset_id);
+    for (const auto *consumed :
+         {&shadow.bid_consumed_, &shadow.ask_consumed_}) {
+        if (consumed->empty()) continue;
+        std::uint64_t levels = 0;
+        for (const auto &[price, quantity] : *consumed) {
+            levels ^= combine_double(combine(0, price), quantity);
+        }
+        h = combine(h, levels);
+    }
+    return h;
+}
+
 /**
  * @brief Computes the natural logarithm of (1 + quantity).
  *
@@ -7,15 +7,24 @@
 
 #pragma once
 
+#include <cstdint>
 #include <deque>
 #include <functional>
+#include <map>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include "../../utils/logger/logger.h"
+#include "../market_data/book_update_batch.h"
+#include "../market_data/mbo_update.h"
+#include "../market_data/quote.h"
+#include "../orderbook/mbo_orderbook.h"
 #include "../orderbook/orderbook.h"
+#include "../orderbook/top_of_book.h"
 #include "../trading/depth.h"
 #include "../trading/fill.h"
 #include "../trading/order.h"
@@ -28,14 +37,20 @@
 namespace core::execution_engine {
 class ExecutionEngine {
   public:
-    ExecutionEngine(std::shared_ptr<utils::logger::Logger> logger = nullptr);
+    ExecutionEngine(std::shared_ptr<utils::logger::Logger> logger = nullptr,
+                    std::pmr::memory_resource *resource =
+                        std::pmr::get_default_resource());
 
     void add_asset(int asset_id, double tick_size, double lot_size);
+    void add_mbo_asset(int asset_id, double tick_size, double lot_size);
+    void add_bbo_asset(int asset_id, double tick_size, double lot_size);
 
     bool order_inactive(const std::shared_ptr<core::trading::Order> &order);
     bool clear_inactive_orders(int asset_id);
     bool cancel_order(int asset_id, const OrderId &orderId,
                       const Timestamp &current_timestamp);
+    bool expire_order(int asset_id, const OrderId &orderId,
+                      const Timestamp &current_timestamp);
 
     bool order_exists(const OrderId &orderId) const;
 
@@ -47,19 +62,31 @@ class ExecutionEngine {
                            std::shared_ptr<core::trading::Order> order);
     bool place_maker_order(int asset_id,
                            std::shared_ptr<core::trading::Order> order);
+    bool place_stop_order(int asset_id, TradeSide side,
+                          std::shared_ptr<core::trading::Order> order);
+    std::size_t pending_stops(int asset_id) const;
 
     bool execute_order(int asset_id, TradeSide side,
                        const core::trading::Order &order);
 
     void handle_book_update(int asset_id, const core::market_data::BookUpdate &book_update);
+    void handle_book_update_batch(
+        int asset_id, const core::market_data::BookUpdateBatch &book_batch);
     void handle_trade(int asset_id, const core::market_data::Trade &trade);
+    void handle_mbo_update(int asset_id,
+                           const core::market_data::MboUpdate &mbo_update);
+    void handle_quote(int asset_id, const core::market_data::Quote &quote);
 
     const std::vector<core::trading::OrderUpdate> &order_updates() const;
     const std::vector<core::trading::Fill> &fills() const;
+    core::orderbook::OrderBook &orderbook(int asset_id);
+    const core::orderbook::TopOfBook &top_of_book(int asset_id) const;
 
     void clear_fills();
     void clear_order_updates();
 
+    std::uint64_t state_hash(int asset_id) const;
+
     constexpr double f(double x);
 
     void set_order_entry_latency_us(const Microseconds latency_us);
@@ -69,28 +96,91 @@ class ExecutionEngine {
     Microseconds order_entry_latency_us_ = 25000;
     Microseconds order_response_latency_us_ = 10000;
 
-    std::unordered_map<int, double> tick_sizes_;
-    std::unordered_map<int, double> lot_sizes_;
+    // backs the orders, books, maker books and order lookups below
+    std::pmr::memory_resource *resource_;
+
+    std::pmr::unordered_map<int, double> tick_sizes_;
+    std::pmr::unordered_map<int, double> lot_sizes_;
 
-    std::unordered_map<int, core::orderbook::OrderBook> orderbooks_;
+    std::pmr::unordered_map<int, core::orderbook::OrderBook> orderbooks_;
+    // order-level books for assets fed by an L3 stream, with the time
+    // priority of each of our maker orders on those assets
+    std::pmr::unordered_map<int, core::orderbook::MboOrderBook> mbo_books_;
+    std::pmr::unordered_map<OrderId, std::uint64_t> queue_sequences_;
+    // best bid/offer only books, replacing orderbooks_ for quote-fed assets
+    std::pmr::unordered_map<int, core::orderbook::TopOfBook> tob_books_;
 
     std::vector<core::trading::OrderUpdate> order_updates_;
     std::vector<core::trading::Fill> fills_;
 
     struct MakerBook {
-        std::unordered_map<Ticks, std::shared_ptr<core::trading::Order>>
+        std::pmr::unordered_map<Ticks, std::shared_ptr<core::trading::Order>>
             bid_orders_;
-        std::unordered_map<Ticks, std::shared_ptr<core::trading::Order>>
+        std::pmr::unordered_map<Ticks, std::shared_ptr<core::trading::Order>>
             ask_orders_;
     };
-    std::unordered_map<int, MakerBook> maker_books_;
+    std::pmr::unordered_map<int, MakerBook> maker_books_;
+
+    // untriggered stop orders by stop price: buy stops fire once the market
+    // reaches or rises above their stop, sell stops at or below it
+    using StopOrders =
+        std::pmr::multimap<Ticks, std::shared_ptr<core::trading::Order>>;
+    struct TriggerBook {
+        StopOrders buy_stops_;
+        StopOrders sell_stops_;
+    };
+    std::pmr::unordered_map<int, TriggerBook> trigger_books_;
+
+    // quantity our taker orders consumed per displayed level since that
+    // level's last real update, hidden from later taker orders
+    using ConsumedLevels = std::pmr::unordered_map<Ticks, Quantity>;
+    struct ShadowLiquidity {
+        ConsumedLevels bid_consumed_;
+        ConsumedLevels ask_consumed_;
+    };
+    std::pmr::unordered_map<int, ShadowLiquidity> shadow_liquidity_;
 
-    std::unordered_map<int, std::vector<std::shared_ptr<core::trading::Order>>>
+    std::pmr::unordered_map<
+        int, std::pmr::vector<std::shared_ptr<core::trading::Order>>>
         active_orders_;
-    std::unordered_map<OrderId, std::shared_ptr<core::trading::Order>> orders_;
+    std::pmr::unordered_map<OrderId, std::shared_ptr<core::trading::Order>>
+        orders_;
 
     std::shared_ptr<utils::logger::Logger> logger_;
 
+    void register_asset(int asset_id, double tick_size, double lot_size);
+    void check_book_triggers(int asset_id, Timestamp timestamp);
+    void fire_triggers(int asset_id, Ticks buy_reference,
+                       Ticks sell_reference, Timestamp timestamp);
+    void apply_book_update(int asset_id,
+                           const core::market_data::BookUpdate &book_update);
+    void fill_maker_order(int asset_id, const core::market_data::Trade &trade);
+    void advance_queue(core::trading::Order &order, Quantity old_depth,
+                       Quantity new_depth);
+    Quantity
+    depth_before_row(const core::orderbook::OrderBook &book,
+                     const std::vector<core::market_data::BookUpdate> &rows,
+                     std::size_t i, Ticks price, double tick_size) const;
+    void update_exact_queue(int asset_id, BookSide side, Ticks price);
+    void update_touch_queue(int asset_id, BookSide side, Ticks old_price,
+                            Quantity old_quantity);
+    std::optional<Quantity>
+    touch_queue_estimate(const core::orderbook::TopOfBook &tob, BookSide side,
+                         Ticks price) const;
+
+    // level accessors dispatching to the asset's TopOfBook or OrderBook
+    int book_levels(int asset_id, BookSide side) const;
+    Quantity book_depth_at_level(int asset_id, BookSide side, int level) const;
+    Ticks book_price_at_level(int asset_id, BookSide side, int level) const;
+    Price book_best_price(int asset_id, BookSide side) const;
+
+    Quantity taker_depth(int asset_id, BookSide side, int level,
+                         Ticks price) const;
+    void consume_liquidity(int asset_id, BookSide side, Ticks price,
+                           Quantity quantity);
+    void reconcile_liquidity(int asset_id, BookSide side, Ticks price);
+    void clear_shadow_liquidity(int asset_id);
+
     template <typename Container>
     static void clear_from_container(
         Container &container,
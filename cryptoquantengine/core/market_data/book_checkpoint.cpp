@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../utils/math/math_utils.h"
+#include "../orderbook/orderbook.h"
+#include "../types/enums/update_type.h"
+#include "book_checkpoint.h"
+#include "readers/book_stream_reader.h"
+#include "readers/trade_stream_reader.h"
+
+namespace core::market_data {
+namespace {
+// byte offset of each line, found by scanning forward only
+class LineOffsets {
+  public:
+    explicit LineOffsets(const std::string &file)
+        : in_(file, std::ios::binary) {}
+
+    std::uint64_t offset_of(unsigned line) {
+        std::string text;
+        while (next_line_ < line && std::getline(in_, text)) {
+            offset_ += text.size() + 1;
+            ++next_line_;
+        }
+        return offset_;
+    }
+
+  private:
+    std::ifstream in_;
+    unsigned next_line_ = 1;
+    std::uint64_t offset_ = 0;
+};
+
+template <typename Book>
+void write_levels(std::ostream &out, const Book &book, double tick_size) {
+    for (const auto &[ticks, quantity] : book) {
+        out << utils::math::ticks_to_price(ticks, tick_size) << ',' << quantity
+            << '\n';
+    }
+}
+
+std::pair<Price, Quantity> parse_level(const std::string &line) {
+    const auto comma = line.find(',');
+    if (comma == std::string::npos) {
+        throw std::runtime_error("Malformed book checkpoint level: " + line);
+    }
+    return {std::stod(line.substr(0, comma)),
+            std::stod(line.substr(comma + 1))};
+}
+} // namespace
+
+/**
+ * @brief Replays a day of book updates once and writes the reconstructed
+ * book every @p interval_us as a side-car checkpoint file.
+ *
+ * Checkpoints are only taken between two exchange timestamps and before an
+ * incremental row, so resuming from one never splits a batch or a snapshot.
+ * The file is text: a `checkpoint,<exch ts>,<local ts>,<book offset>,<trade
+ * offset>,<bid levels>,<ask levels>` line followed by one `price,quantity`
+ * line per bid level, then per ask level, best first.
+ *
+ * @return The number of checkpoints written.
+ * @throws std::invalid_argument if @p interval_us is 0.
+ * @throws std::runtime_error if the output file cannot be opened.
+ */
+std::size_t write_book_checkpoints(const std::string &book_file,
+                                   const std::string &trade_file,
+                                   double tick_size, double lot_size,
+                                   Microseconds interval_us,
+                                   const std::string &output_file) {
+    if (interval_us == 0) {
+        throw std::invalid_argument("Checkpoint interval must be positive");
+    }
+    std::ofstream out(output_file);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open checkpoint file: " +
+                                 output_file);
+    }
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    BookStreamReader book_reader(book_file);
+    TradeStreamReader trade_reader(trade_file);
+    LineOffsets book_lines(book_file);
+    LineOffsets trade_lines(trade_file);
+    core::orderbook::OrderBook book(tick_size, lot_size);
+
+    Trade trade;
+    bool trade_pending = trade_reader.parse_next(trade);
+    BookUpdate row;
+    std::optional<BookUpdate> prev;
+    Timestamp next_due = 0;
+    std::size_t written = 0;
+    while (book_reader.parse_next(row)) {
+        if (!prev) {
+            next_due = row.exch_timestamp_ + interval_us;
+        } else if (row.exch_timestamp_ >= next_due &&
+                   row.exch_timestamp_ != prev->exch_timestamp_ &&
+                   row.update_type_ == UpdateType::Incremental) {
+            while (trade_pending &&
+                   trade.exch_timestamp_ < prev->exch_timestamp_) {
+                trade_pending = trade_reader.parse_next(trade);
+            }
+            const std::uint64_t trade_offset =
+                trade_pending
+                    ? trade_lines.offset_of(trade_reader.file_line())
+                    : std::filesystem::file_size(trade_file);
+            const auto bids = book.bid_book();
+            const auto asks = book.ask_book();
+            out << "checkpoint," << prev->exch_timestamp_ << ','
+                << prev->local_timestamp_ << ','
+                << book_lines.offset_of(book_reader.file_line()) << ','
+                << trade_offset << ',' << bids.size() << ',' << asks.size()
+                << '\n';
+            write_levels(out, bids, tick_size);
+            write_levels(out, asks, tick_size);
+            ++written;
+            while (next_due <= row.exch_timestamp_) next_due += interval_us;
+        }
+        book.apply_book_update(row);
+        prev = row;
+    }
+    return written;
+}
+
+/**
+ * @brief Returns the latest checkpoint taken at or before @p start_us.
+ *
+ * @return The checkpoint, or std::nullopt if the first one is later.
+ * @throws std::runtime_error if the file cannot be opened or is malformed.
+ */
+std::optional<BookCheckpoint>
+find_book_checkpoint(const std::string &checkpoint_file, Timestamp start_us) {
+    std::ifstream in(checkpoint_file);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open checkpoint file: " +
+                                 checkpoint_file);
+    }
+    std::optional<BookCheckpoint> found;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("checkpoint,", 0) != 0) {
+            throw std::runtime_error("Malformed book checkpoint line: " + line);
+        }
+        std::istringstream fields(line.substr(11));
+        BookCheckpoint checkpoint{};
+        std::size_t bid_levels = 0, ask_levels = 0;
+        char comma;
+        if (!(fields >> checkpoint.exch_timestamp_ >> comma >>
+              checkpoint.local_timestamp_ >> comma >> checkpoint.book_offset_ >>
+              comma >> checkpoint.trade_offset_ >> comma >> bid_levels >>
+              comma >> ask_levels)) {
+            throw std::runtime_error("Malformed book checkpoint line: " + line);
+        }
+        if (checkpoint.exch_timestamp_ > start_us) break;
+        for (std::size_t i = 0; i < bid_levels + ask_levels; ++i) {
+            if (!std::getline(in, line)) {
+                throw std::runtime_error("Truncated book checkpoint file: " +
+                                         checkpoint_file);
+            }
+            (i < bid_levels ? checkpoint.bids_ : checkpoint.asks_)
+                .push_back(parse_level(line));
+        }
+        found = std::move(checkpoint);
+    }
+    return found;
+}
+} // namespace core::market_data
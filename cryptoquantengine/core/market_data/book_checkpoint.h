@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../types/aliases/usings.h"
+
+namespace core::market_data {
+/**
+ * @brief Full reconstructed book of one asset at a point in a day's replay,
+ * with the file offsets to resume reading from.
+ *
+ * The book reflects every book row up to and including the last row with
+ * exchange timestamp exch_timestamp_; book_offset_ is the byte offset of the
+ * next book row and trade_offset_ that of the first trade row with exchange
+ * timestamp >= exch_timestamp_.
+ */
+struct BookCheckpoint {
+    Timestamp exch_timestamp_;
+    Timestamp local_timestamp_;
+    std::uint64_t book_offset_;
+    std::uint64_t trade_offset_;
+    std::vector<std::pair<Price, Quantity>> bids_; // best first
+    std::vector<std::pair<Price, Quantity>> asks_; // best first
+};
+
+std::size_t write_book_checkpoints(const std::string &book_file,
+                                   const std::string &trade_file,
+                                   double tick_size, double lot_size,
+                                   Microseconds interval_us,
+                                   const std::string &output_file);
+std::optional<BookCheckpoint>
+find_book_checkpoint(const std::string &checkpoint_file, Timestamp start_us);
+} // namespace core::market_data
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../types/aliases/usings.h"
+#include "book_update.h"
+
+namespace core::market_data {
+/**
+ * @brief All book rows of one asset that share an exchange and local
+ * timestamp (e.g. the rows produced by a single exchange depth message),
+ * delivered and applied as one event.
+ */
+struct BookUpdateBatch {
+    Timestamp exch_timestamp_;
+    Timestamp local_timestamp_;
+
+    std::vector<BookUpdate> updates_; // in file order
+};
+} // namespace core::market_data
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "../types/enums/book_side.h"
+#include "../types/enums/update_type.h"
+#include "compressed_book_tape.h"
+
+namespace core::market_data {
+namespace {
+constexpr std::uint8_t kAskFlag = 1;
+constexpr std::uint8_t kSnapshotFlag = 2;
+constexpr std::uint8_t kRawPriceFlag = 4;
+constexpr std::uint8_t kRawAmountFlag = 8;
+
+void put_varint(std::vector<std::uint8_t> &out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t get_varint(const std::uint8_t *&in) {
+    std::uint64_t value = *in & 0x7f;
+    for (int shift = 7; *in++ & 0x80; shift += 7) {
+        value |= static_cast<std::uint64_t>(*in & 0x7f) << shift;
+    }
+    return value;
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^
+           static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^
+           -static_cast<std::int64_t>(value & 1);
+}
+
+void put_raw(std::vector<std::uint8_t> &out, double value) {
+    std::uint8_t bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    out.insert(out.end(), bytes, bytes + sizeof(double));
+}
+
+double get_raw(const std::uint8_t *&in) {
+    double value;
+    std::memcpy(&value, in, sizeof(double));
+    in += sizeof(double);
+    return value;
+}
+} // namespace
+
+/**
+ * @brief Creates an empty tape for rows on a @p tick_size price grid and
+ * @p lot_size quantity grid.
+ *
+ * @throws std::invalid_argument if a step is not positive or @p block_rows is
+ * zero.
+ */
+CompressedBookTape::CompressedBookTape(double tick_size, double lot_size,
+                                       std::size_t block_rows)
+    : price_scale_(make_scale(tick_size)), lot_scale_(make_scale(lot_size)),
+      block_rows_(block_rows) {
+    if (block_rows == 0) {
+        throw std::invalid_argument("Tape blocks must hold at least one row");
+    }
+    pending_.reserve(block_rows_);
+}
+
+CompressedBookTape::Scale CompressedBookTape::make_scale(double step) {
+    if (!(step > 0.0) || !std::isfinite(step)) {
+        throw std::invalid_argument("Tape tick and lot sizes must be positive");
+    }
+    Scale scale;
+    scale.step_ = step;
+    const double inverse = std::round(1.0 / step);
+    if (inverse >= 1.0 && std::fabs(inverse * step - 1.0) < 1e-12) {
+        scale.inverse_ = inverse;
+        scale.divide_ = true;
+    }
+    return scale;
+}
+
+/**
+ * @brief Appends a row; every block_rows rows are encoded into a block.
+ */
+void CompressedBookTape::append(const BookUpdate &update) {
+    pending_.push_back(update);
+    ++rows_;
+    if (pending_.size() == block_rows_) encode_block();
+}
+
+/**
+ * @brief Encodes any buffered rows into a (possibly short) block and releases
+ * spare capacity. Call once appending is done; later appends start a new
+ * block.
+ */
+void CompressedBookTape::flush() {
+    if (!pending_.empty()) encode_block();
+    data_.shrink_to_fit();
+    blocks_.shrink_to_fit();
+    pending_.shrink_to_fit();
+}
+
+/**
+ * @brief Returns the memory held by the tape, including rows not yet
+ * encoded.
+ */
+std::size_t CompressedBookTape::bytes() const {
+    return data_.capacity() + blocks_.capacity() * sizeof(Block) +
+           pending_.capacity() * sizeof(BookUpdate);
+}
+
+/**
+ * @brief Returns the size of the rows as BookUpdate structs divided by
+ * bytes(), or 0 for an empty tape.
+ */
+double CompressedBookTape::compression_ratio() const {
+    const std::size_t held = bytes();
+    return held == 0 ? 0.0
+                     : static_cast<double>(rows_ * sizeof(BookUpdate)) / held;
+}
+
+void CompressedBookTape::encode_block() {
+    std::array<std::vector<std::uint8_t>, kColumns> columns;
+    std::int64_t last_latency = 0, last_ticks = 0;
+    Timestamp last_exch = 0;
+    for (std::size_t i = 0; i < pending_.size(); ++i) {
+        const BookUpdate &row = pending_[i];
+        std::uint8_t flags = 0;
+        if (row.side_ == BookSide::Ask) flags |= kAskFlag;
+        if (row.update_type_ == UpdateType::Snapshot) flags |= kSnapshotFlag;
+
+        put_varint(columns[ExchTs], zigzag(static_cast<std::int64_t>(
+                                        row.exch_timestamp_ - last_exch)));
+        last_exch = row.exch_timestamp_;
+        const auto latency = static_cast<std::int64_t>(row.local_timestamp_ -
+                                                       row.exch_timestamp_);
+        put_varint(columns[Latency], zigzag(latency - last_latency));
+        last_latency = latency;
+
+        std::int64_t ticks, lots;
+        if (price_scale_.steps(row.price_, ticks)) {
+            put_varint(columns[Price], zigzag(ticks - last_ticks));
+            last_ticks = ticks;
+        } else {
+            flags |= kRawPriceFlag;
+            put_raw(columns[Raw], row.price_);
+            ++escapes_;
+        }
+        if (lot_scale_.steps(row.quantity_, lots) && lots >= 0) {
+            put_varint(columns[Amount], static_cast<std::uint64_t>(lots));
+        } else {
+            flags |= kRawAmountFlag;
+            put_raw(columns[Raw], row.quantity_);
+            ++escapes_;
+        }
+
+        if (i % 2 == 0) {
+            columns[Flags].push_back(flags);
+        } else {
+            columns[Flags].back() |= static_cast<std::uint8_t>(flags << 4);
+        }
+    }
+
+    Block block{data_.size(), static_cast<std::uint32_t>(pending_.size()), {}};
+    std::uint32_t end = 0;
+    for (std::size_t c = 0; c < kColumns; ++c) {
+        data_.insert(data_.end(), columns[c].begin(), columns[c].end());
+        end += static_cast<std::uint32_t>(columns[c].size());
+        block.ends_[c] = end;
+    }
+    blocks_.push_back(block);
+    pending_.clear();
+}
+
+void CompressedBookTape::decode_block(const Block &block,
+                                      std::vector<BookUpdate> &out) const {
+    const std::uint8_t *base = data_.data() + block.offset_;
+    const std::uint8_t *exch = base;
+    const std::uint8_t *latency = base + block.ends_[ExchTs];
+    const std::uint8_t *price = base + block.ends_[Latency];
+    const std::uint8_t *amount = base + block.ends_[Price];
+    const std::uint8_t *flags = base + block.ends_[Amount];
+    const std::uint8_t *raw = base + block.ends_[Flags];
+
+    out.resize(block.rows_);
+    std::int64_t last_latency = 0, last_ticks = 0;
+    Timestamp last_exch = 0;
+    for (std::uint32_t i = 0; i < block.rows_; ++i) {
+        BookUpdate &row = out[i];
+        const std::uint8_t f = (flags[i / 2] >> ((i % 2) * 4)) & 0x0f;
+        last_exch += static_cast<Timestamp>(unzigzag(get_varint(exch)));
+        last_latency += unzigzag(get_varint(latency));
+        row.exch_timestamp_ = last_exch;
+        row.local_timestamp_ = last_exch + static_cast<Timestamp>(last_latency);
+        row.side_ = (f & kAskFlag) ? BookSide::Ask : BookSide::Bid;
+        row.update_type_ = (f & kSnapshotFlag) ? UpdateType::Snapshot
+                                               : UpdateType::Incremental;
+        if (f & kRawPriceFlag) {
+            row.price_ = get_raw(raw);
+        } else {
+            last_ticks += unzigzag(get_varint(price));
+            row.price_ = price_scale_.value(last_ticks);
+        }
+        if (f & kRawAmountFlag) {
+            row.quantity_ = get_raw(raw);
+        } else {
+            const auto lots = static_cast<std::int64_t>(get_varint(amount));
+            row.quantity_ = lot_scale_.value(lots);
+        }
+    }
+}
+
+CompressedBookTape::Cursor::Cursor(const CompressedBookTape &tape)
+    : tape_(&tape) {
+    rows_.reserve(tape.block_rows_);
+}
+
+/**
+ * @brief Decodes the next block into the cursor's buffer; rows still pending
+ * on the tape are served last.
+ *
+ * @return false once every row has been served.
+ */
+bool CompressedBookTape::Cursor::load_block() {
+    pos_ = 0;
+    if (block_ < tape_->blocks_.size()) {
+        tape_->decode_block(tape_->blocks_[block_++], rows_);
+        return true;
+    }
+    rows_.clear();
+    if (pending_done_ || tape_->pending_.empty()) return false;
+    pending_done_ = true;
+    rows_ = tape_->pending_;
+    return true;
+}
+} // namespace core::market_data
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "book_update.h"
+
+namespace core::market_data {
+/**
+ * @brief Book rows stored as delta-encoded columns in independently decodable
+ * blocks, for keeping long tapes in memory.
+ *
+ * Each block holds up to block_rows rows as separate byte columns:
+ * exchange timestamp deltas and local-minus-exchange latency deltas as
+ * zig-zag varints, price deltas in ticks as zig-zag varints, quantities as
+ * varint lot counts, and side/snapshot flags packed four bits per row. A
+ * price or quantity that does not sit exactly on the tick or lot grid is
+ * stored as a raw double instead, so decoding always returns the appended
+ * rows bit for bit.
+ */
+class CompressedBookTape {
+  public:
+    static constexpr std::size_t kDefaultBlockRows = 4096;
+
+    class Cursor {
+      public:
+        explicit Cursor(const CompressedBookTape &tape);
+        bool next(BookUpdate &update) {
+            if (pos_ == rows_.size() && !load_block()) return false;
+            update = rows_[pos_++];
+            return true;
+        }
+
+      private:
+        bool load_block();
+
+        const CompressedBookTape *tape_;
+        std::size_t block_ = 0;
+        bool pending_done_ = false;
+        std::vector<BookUpdate> rows_; // the current block, decoded
+        std::size_t pos_ = 0;
+    };
+
+    CompressedBookTape() = default;
+    CompressedBookTape(double tick_size, double lot_size,
+                       std::size_t block_rows = kDefaultBlockRows);
+
+    void append(const BookUpdate &update);
+    void flush();
+    Cursor cursor() const { return Cursor(*this); }
+
+    std::size_t size() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+    std::size_t bytes() const;
+    double compression_ratio() const;
+    std::size_t escapes() const { return escapes_; }
+
+  private:
+    // n steps of a tick or lot; division by the inverse step is exact for
+    // decimal steps such as 0.01, where multiplying by the step is not
+    struct Scale {
+        double step_ = 1.0;
+        double inverse_ = 1.0;
+        bool divide_ = false;
+        double value(std::int64_t n) const {
+            return divide_ ? static_cast<double>(n) / inverse_
+                           : static_cast<double>(n) * step_;
+        }
+        // false if v is not exactly a whole number n of steps
+        bool steps(double v, std::int64_t &n) const {
+            if (!std::isfinite(v)) return false;
+            n = std::llround(divide_ ? v * inverse_ : v / step_);
+            return value(n) == v;
+        }
+    };
+
+    enum Column : std::size_t { ExchTs, Latency, Price, Amount, Flags, Raw };
+    static constexpr std::size_t kColumns = 6;
+
+    struct Block {
+        std::size_t offset_;
+        std::uint32_t rows_;
+        std::array<std::uint32_t, kColumns> ends_; // relative to offset_
+    };
+
+    static Scale make_scale(double step);
+    void encode_block();
+    void decode_block(const Block &block, std::vector<BookUpdate> &out) const;
+
+    Scale price_scale_;
+    Scale lot_scale_;
+    std::size_t block_rows_ = kDefaultBlockRows;
+    std::vector<std::uint8_t> data_;
+    std::vector<Block> blocks_;
+    std::vector<BookUpdate> pending_; // appended rows not yet encoded
+    std::size_t rows_ = 0;
+    std::size_t escapes_ = 0;
+};
+} // namespace core::market_data
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "../types/aliases/usings.h"
+
+namespace core::market_data {
+inline constexpr std::size_t kSnapshotLevels = 25;
+
+struct DepthLevel {
+    Price price_;
+    Quantity quantity_;
+};
+
+// top-N book snapshot (Tardis book_snapshot_25 / book_snapshot_5), best level
+// first on each side
+struct DepthSnapshot {
+    Timestamp exch_timestamp_;  // arrives at exchange first
+    Timestamp local_timestamp_; // sent to local with latency
+
+    std::size_t bid_count_ = 0; // populated entries of bids_
+    std::size_t ask_count_ = 0; // populated entries of asks_
+    std::array<DepthLevel, kSnapshotLevels> bids_;
+    std::array<DepthLevel, kSnapshotLevels> asks_;
+};
+} // namespace core::market_data
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "../types/enums/event_type.h"
+#include "event_tape.h"
+#include "market_data_feed.h"
+#include "market_event.h"
+
+namespace core::market_data {
+/**
+ * @brief Decodes an asset's book and trade files into an AssetTape.
+ *
+ * The files are read through a MarketDataFeed, so local timestamps and trade
+ * aggregation come out exactly as a file-backed feed would deliver them.
+ * With @p compression set, book rows are appended straight to a
+ * CompressedBookTape on the given grids, so the raw rows are never held in
+ * memory all at once.
+ */
+AssetTape EventTape::decode(const std::string &book_file,
+                            const std::string &trade_file,
+                            bool aggregate_trades,
+                            const std::optional<TapeCompression> &compression) {
+    const int asset_id = 0;
+    MarketDataFeed feed;
+    feed.set_trade_aggregation(aggregate_trades);
+    feed.add_stream(asset_id, book_file, trade_file);
+
+    AssetTape tape;
+    if (compression) {
+        tape.compressed_book_ =
+            CompressedBookTape(compression->tick_size_, compression->lot_size_,
+                               compression->block_rows_);
+    }
+    tape.verified_ = feed.verified(asset_id);
+    MarketEvent event;
+    while (feed.next_event(event)) {
+        if (event.event_type_ == EventType::Trade) {
+            tape.trades_.push_back(event.trade_);
+            continue;
+        }
+        for (const auto &update : event.book_batch_.updates_) {
+            if (compression) {
+                tape.compressed_book_.append(update);
+            } else {
+                tape.book_updates_.push_back(update);
+            }
+        }
+    }
+    tape.book_updates_.shrink_to_fit();
+    tape.compressed_book_.flush();
+    tape.trades_.shrink_to_fit();
+    return tape;
+}
+
+/**
+ * @brief Decodes an asset's files onto the tape, replacing any data already
+ * on it for @p asset_id.
+ */
+void EventTape::add_asset(int asset_id, const std::string &book_file,
+                          const std::string &trade_file,
+                          bool aggregate_trades) {
+    add_asset(asset_id, decode(book_file, trade_file, aggregate_trades));
+}
+} // namespace core::market_data
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "book_update.h"
+#include "compressed_book_tape.h"
+#include "trade.h"
+
+namespace core::market_data {
+/**
+ * @brief One asset's decoded book rows and trades, in file order.
+ */
+struct AssetTape {
+    std::vector<BookUpdate> book_updates_;
+    // replayed instead of book_updates_ when non-empty
+    CompressedBookTape compressed_book_;
+    std::vector<Trade> trades_;
+    bool verified_ = false; // decoded from a tape cleaned by validate_book_tape
+
+    std::size_t book_rows() const {
+        return book_updates_.size() + compressed_book_.size();
+    }
+    std::size_t bytes() const {
+        return book_updates_.capacity() * sizeof(BookUpdate) +
+               compressed_book_.bytes() + trades_.capacity() * sizeof(Trade);
+    }
+};
+
+// grids of the asset's book rows, to store them as a CompressedBookTape
+struct TapeCompression {
+    double tick_size_;
+    double lot_size_;
+    std::size_t block_rows_ = CompressedBookTape::kDefaultBlockRows;
+};
+
+/**
+ * @brief Read-only, fully decoded market data for a set of assets, replayed by
+ * MarketDataFeed::add_tape_stream() instead of reading CSV files.
+ *
+ * Decoding once and sharing the result lets many backtests run over the same
+ * data without re-parsing it. Copying a tape makes an independent replica;
+ * the copy's pages are first touched, and so placed, by the copying thread.
+ */
+class EventTape {
+  public:
+    static AssetTape
+    decode(const std::string &book_file, const std::string &trade_file,
+           bool aggregate_trades,
+           const std::optional<TapeCompression> &compression = std::nullopt);
+
+    void add_asset(int asset_id, const std::string &book_file,
+                   const std::string &trade_file, bool aggregate_trades);
+    void add_asset(int asset_id, AssetTape tape) {
+        assets_[asset_id] = std::move(tape);
+    }
+
+    // nullptr if the tape has no data for asset_id
+    const AssetTape *asset(int asset_id) const {
+        const auto it = assets_.find(asset_id);
+        return it == assets_.end() ? nullptr : &it->second;
+    }
+
+    std::size_t events() const {
+        std::size_t count = 0;
+        for (const auto &[_, tape] : assets_) {
+            count += tape.book_rows() + tape.trades_.size();
+        }
+        return count;
+    }
+
+    std::size_t bytes() const {
+        std::size_t total = 0;
+        for (const auto &[_, tape] : assets_) total += tape.bytes();
+        return total;
+    }
+
+  private:
+    std::map<int, AssetTape> assets_;
+};
+} // namespace core::market_data
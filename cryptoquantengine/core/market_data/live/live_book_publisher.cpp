@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "live_book_publisher.h"
+
+namespace core::market_data::live {
+/**
+ * @brief Creates the shared-memory region @p shm_name and an empty book on
+ * the symbol's tick and lot grid.
+ *
+ * @param depth Levels per side to publish, at most kSnapshotLevels.
+ * @throws std::invalid_argument or std::runtime_error from ShmBookWriter.
+ */
+LiveBookPublisher::LiveBookPublisher(const std::string &shm_name,
+                                     const std::string &symbol,
+                                     double tick_size, double lot_size,
+                                     std::size_t depth)
+    : book_(tick_size, lot_size), writer_(shm_name, symbol, depth) {}
+
+/**
+ * @brief Applies one message's book rows and publishes the result once, so
+ * readers never see a book with only part of a message applied.
+ *
+ * The rows are not sequenced; exchange feeds with update ids go through
+ * publish_diff() and publish_snapshot() instead.
+ *
+ * @throws std::invalid_argument if a row has a non-positive price or a
+ * negative quantity; rows before it stay applied and are published.
+ */
+void LiveBookPublisher::publish_book(const std::vector<BookUpdate> &updates) {
+    if (updates.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    try {
+        for (const auto &update : updates) book_.apply_book_update(update);
+    } catch (...) {
+        publish();
+        throw;
+    }
+    frame_.top_.exch_timestamp_ = updates.back().exch_timestamp_;
+    frame_.top_.local_timestamp_ = updates.back().local_timestamp_;
+    publish();
+}
+
+/**
+ * @brief Applies one depth message in update-id order and publishes.
+ *
+ * Until a snapshot has been applied, and after a gap, messages are buffered
+ * for the next publish_snapshot(). Messages already covered by the book
+ * (final id at or below the last applied id) are dropped. The first message
+ * after a snapshot must straddle the snapshot's id; every later one must
+ * continue the previous message (`pu` equal to the previous `u`, or `U` one
+ * above it when `pu` is not sent). A message that breaks the chain, or holds
+ * an invalid row, is logged and starts a resync instead of throwing, since
+ * this runs on the websocket thread.
+ */
+void LiveBookPublisher::publish_diff(const DepthDiff &diff) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!synced_) {
+        buffer_diff(diff);
+        return;
+    }
+    if (!apply_diff(diff)) {
+        buffer_diff(diff);
+        return;
+    }
+    publish();
+}
+
+/**
+ * @brief Replaces the book with a REST depth snapshot, then applies the
+ * buffered messages that follow it.
+ *
+ * A snapshot older than the book (its id at or below the last applied id)
+ * is ignored. Invalid rows are logged and leave the publisher waiting for
+ * the next snapshot.
+ *
+ * @param levels The snapshot rows.
+ * @param last_update_id The snapshot's `lastUpdateId`.
+ */
+void LiveBookPublisher::publish_snapshot(const std::vector<BookUpdate> &levels,
+                                         std::uint64_t last_update_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (synced_ && last_update_id <= last_update_id_) return;
+    batch_.updates_.assign(levels.begin(), levels.end());
+    try {
+        book_.clear();
+        book_.apply_book_updates(batch_);
+    } catch (const std::exception &e) {
+        resync(std::string("invalid snapshot row: ") + e.what());
+        return;
+    }
+    if (!levels.empty()) {
+        frame_.top_.exch_timestamp_ = levels.back().exch_timestamp_;
+        frame_.top_.local_timestamp_ = levels.back().local_timestamp_;
+    }
+    last_update_id_ = last_update_id;
+    bridging_ = true;
+    synced_ = true;
+    std::deque<DepthDiff> pending;
+    pending.swap(pending_);
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
+        if (!apply_diff(*it)) {
+            pending_.assign(std::make_move_iterator(it),
+                            std::make_move_iterator(pending.end()));
+            break;
+        }
+    }
+    publish();
+}
+
+/**
+ * @brief Applies @p diff if it continues the book (mutex_ held).
+ *
+ * @return false if it does not; the publisher is then resyncing.
+ */
+bool LiveBookPublisher::apply_diff(const DepthDiff &diff) {
+    if (diff.final_update_id_ <= last_update_id_) return true;
+    bool follows;
+    if (bridging_) {
+        follows = diff.first_update_id_ <= last_update_id_ + 1;
+    } else if (diff.prev_final_update_id_ != 0) {
+        follows = diff.prev_final_update_id_ == last_update_id_;
+    } else {
+        follows = diff.first_update_id_ == last_update_id_ + 1;
+    }
+    if (!follows) {
+        resync("gap after update " + std::to_string(last_update_id_) +
+               ", next message starts at " +
+               std::to_string(diff.first_update_id_));
+        return false;
+    }
+    batch_.updates_.assign(diff.updates_.begin(), diff.updates_.end());
+    try {
+        book_.apply_book_updates(batch_);
+    } catch (const std::exception &e) {
+        resync(std::string("invalid depth row: ") + e.what());
+        return false;
+    }
+    if (!diff.updates_.empty()) {
+        frame_.top_.exch_timestamp_ = diff.updates_.back().exch_timestamp_;
+        frame_.top_.local_timestamp_ = diff.updates_.back().local_timestamp_;
+    }
+    last_update_id_ = diff.final_update_id_;
+    bridging_ = false;
+    return true;
+}
+
+void LiveBookPublisher::buffer_diff(const DepthDiff &diff) {
+    // the oldest messages are the first a late snapshot makes redundant
+    if (pending_.size() == kMaxPendingDiffs) pending_.pop_front();
+    pending_.push_back(diff);
+}
+
+void LiveBookPublisher::resync(const std::string &reason) {
+    std::cerr << "[LiveBookPublisher] " << reason
+              << "; waiting for a new snapshot" << std::endl;
+    synced_ = false;
+}
+
+/**
+ * @brief Records @p trade as the last trade and publishes.
+ */
+void LiveBookPublisher::publish_trade(const Trade &trade) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frame_.top_.trade_exch_timestamp_ = trade.exch_timestamp_;
+    frame_.top_.trade_local_timestamp_ = trade.local_timestamp_;
+    frame_.top_.trade_price_ = trade.price_;
+    frame_.top_.trade_quantity_ = trade.quantity_;
+    frame_.top_.trade_side_ = trade.side_;
+    publish();
+}
+
+void LiveBookPublisher::publish() {
+    book_.top_levels(levels_, writer_.depth());
+    frame_.bid_count_ = levels_.bid_count_;
+    frame_.ask_count_ = levels_.ask_count_;
+    frame_.bids_ = levels_.bids_;
+    frame_.asks_ = levels_.asks_;
+    frame_.top_.best_bid_ =
+        levels_.bid_count_ > 0 ? levels_.bids_[0] : DepthLevel{0.0, 0.0};
+    frame_.top_.best_ask_ =
+        levels_.ask_count_ > 0 ? levels_.asks_[0] : DepthLevel{0.0, 0.0};
+    ++frame_.top_.updates_;
+    frame_.top_.published_ns_ =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    writer_.publish(frame_);
+}
+} // namespace core::market_data::live
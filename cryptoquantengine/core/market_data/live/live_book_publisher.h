@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../orderbook/orderbook.h"
+#include "../book_update.h"
+#include "../book_update_batch.h"
+#include "../depth_snapshot.h"
+#include "../trade.h"
+#include "shm_book.h"
+
+namespace core::market_data::live {
+// one exchange depth message with its update ids (Binance U, u and pu)
+struct DepthDiff {
+    std::uint64_t first_update_id_ = 0;
+    std::uint64_t final_update_id_ = 0;
+    std::uint64_t prev_final_update_id_ = 0; // 0 = not sent (spot streams)
+    std::vector<BookUpdate> updates_;
+};
+
+/**
+ * @brief Keeps a live OrderBook for one symbol and publishes its best levels,
+ * BBO and last trade to a shared-memory book region after every message.
+ */
+class LiveBookPublisher {
+  public:
+    LiveBookPublisher(const std::string &shm_name, const std::string &symbol,
+                      double tick_size, double lot_size,
+                      std::size_t depth = 10);
+
+    void publish_book(const std::vector<BookUpdate> &updates);
+    void publish_diff(const DepthDiff &diff);
+    void publish_snapshot(const std::vector<BookUpdate> &levels,
+                          std::uint64_t last_update_id);
+    void publish_trade(const Trade &trade);
+
+    // true until a snapshot has been applied and after a sequence gap
+    bool needs_snapshot() const { return !synced_; }
+    const std::string &shm_name() const { return writer_.name(); }
+
+    static constexpr std::size_t kMaxPendingDiffs = 16384;
+
+  private:
+    void publish(); // with mutex_ held
+    bool apply_diff(const DepthDiff &diff);
+    void buffer_diff(const DepthDiff &diff);
+    void resync(const std::string &reason);
+
+    std::mutex mutex_; // the websocket and REST threads both publish
+    core::orderbook::OrderBook book_;
+    BookUpdateBatch batch_; // rows being applied, storage reused
+    ShmBookWriter writer_;
+    DepthSnapshot levels_;
+    ShmBookFrame frame_{};
+
+    // sequencing of publish_diff() against publish_snapshot()
+    std::atomic<bool> synced_{false};
+    bool bridging_ = false; // next diff must straddle last_update_id_
+    std::uint64_t last_update_id_ = 0;
+    std::deque<DepthDiff> pending_; // diffs waiting for a snapshot
+};
+} // namespace core::market_data::live
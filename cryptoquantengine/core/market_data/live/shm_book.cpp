@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shm_book.h"
+
+namespace core::market_data::live {
+namespace {
+void check_name(const std::string &name) {
+    if (name.size() < 2 || name[0] != '/' ||
+        name.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument(
+            "Shared memory names are a '/' followed by a file name: " + name);
+    }
+}
+
+std::runtime_error system_error(const std::string &what,
+                                const std::string &name) {
+    return std::runtime_error(what + " " + name + ": " +
+                              std::strerror(errno));
+}
+} // namespace
+
+/**
+ * @brief Creates the shared-memory object @p name, or takes over one left
+ * behind by an earlier writer, and maps it for writing.
+ *
+ * The sequence of a region taken over carries on from where it was, so
+ * readers that stayed attached never see it go back.
+ *
+ * @param depth Levels per side the writer will fill, at most kSnapshotLevels.
+ * @throws std::invalid_argument if @p name is not a valid shared-memory name
+ * or @p depth is out of range.
+ * @throws std::runtime_error if the object cannot be created or mapped.
+ */
+ShmBookWriter::ShmBookWriter(const std::string &name,
+                             const std::string &symbol, std::size_t depth)
+    : name_(name), depth_(depth) {
+    check_name(name);
+    if (depth == 0 || depth > kSnapshotLevels) {
+        throw std::invalid_argument("Book depth must be between 1 and " +
+                                    std::to_string(kSnapshotLevels));
+    }
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) throw system_error("Failed to create", name);
+    if (ftruncate(fd, sizeof(ShmBookRegion)) != 0) {
+        close(fd);
+        throw system_error("Failed to size", name);
+    }
+    void *address = mmap(nullptr, sizeof(ShmBookRegion),
+                         PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) throw system_error("Failed to map", name);
+    // a new object is zero-filled, which is a valid all-zero region
+    region_ = static_cast<ShmBookRegion *>(address);
+
+    sequence_ = region_->sequence_.load(std::memory_order_relaxed);
+    if (sequence_ & 1) { // an earlier writer died mid-publish
+        ++sequence_;
+        region_->sequence_.store(sequence_, std::memory_order_release);
+    }
+    region_->version_ = kShmBookVersion;
+    region_->depth_ = static_cast<std::uint32_t>(depth);
+    std::memset(region_->symbol_, 0, sizeof(region_->symbol_));
+    std::memcpy(region_->symbol_, symbol.data(),
+                std::min(symbol.size(), sizeof(region_->symbol_) - 1));
+    region_->magic_.store(kShmBookMagic, std::memory_order_release);
+}
+
+/**
+ * @brief Unmaps and unlinks the region. Attached readers keep their mapping
+ * but see no further updates; new readers fail to open it.
+ */
+ShmBookWriter::~ShmBookWriter() {
+    if (region_ == nullptr) return;
+    munmap(region_, sizeof(ShmBookRegion));
+    shm_unlink(name_.c_str());
+}
+
+/**
+ * @brief Copies @p frame into the region under the seqlock. Never waits for
+ * readers; only one thread may publish at a time.
+ */
+void ShmBookWriter::publish(const ShmBookFrame &frame) {
+    std::uint64_t words[kShmBookWords];
+    std::memcpy(words, &frame, sizeof(frame));
+    region_->sequence_.store(sequence_ + 1, std::memory_order_relaxed);
+    // orders the odd sequence before any payload store
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < kShmBookWords; ++i) {
+        region_->words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_ += 2;
+    region_->sequence_.store(sequence_, std::memory_order_release);
+}
+
+/**
+ * @brief Maps the shared-memory object @p name read-only.
+ *
+ * @throws std::invalid_argument if @p name is not a valid shared-memory name.
+ * @throws std::runtime_error if the object does not exist, cannot be mapped,
+ * or is not a book region of this version.
+ */
+ShmBookReader::ShmBookReader(const std::string &name) {
+    check_name(name);
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) throw system_error("Failed to open", name);
+    struct stat info;
+    if (fstat(fd, &info) != 0 ||
+        static_cast<std::size_t>(info.st_size) < sizeof(ShmBookRegion)) {
+        close(fd);
+        throw std::runtime_error("Not a book region: " + name);
+    }
+    void *address =
+        mmap(nullptr, sizeof(ShmBookRegion), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) throw system_error("Failed to map", name);
+    region_ = static_cast<const ShmBookRegion *>(address);
+    if (region_->magic_.load(std::memory_order_acquire) != kShmBookMagic ||
+        region_->version_ != kShmBookVersion) {
+        munmap(const_cast<ShmBookRegion *>(region_), sizeof(ShmBookRegion));
+        region_ = nullptr;
+        throw std::runtime_error("Not a book region of version " +
+                                 std::to_string(kShmBookVersion) + ": " +
+                                 name);
+    }
+}
+
+ShmBookReader::~ShmBookReader() {
+    if (region_ != nullptr) {
+        munmap(const_cast<ShmBookRegion *>(region_), sizeof(ShmBookRegion));
+    }
+}
+
+/**
+ * @brief Returns the symbol the writer publishes.
+ */
+std::string ShmBookReader::symbol() const {
+    return std::string(region_->symbol_,
+                       strnlen(region_->symbol_, sizeof(region_->symbol_)));
+}
+} // namespace core::market_data::live
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "../../types/aliases/usings.h"
+#include "../../types/enums/trade_side.h"
+#include "../depth_snapshot.h"
+
+namespace core::market_data::live {
+inline constexpr std::uint64_t kShmBookMagic = 0x4b4f4f424d485351; // QSHMBOOK
+inline constexpr std::uint32_t kShmBookVersion = 1;
+
+// best levels and last trade; readers that only need these copy just this
+struct ShmBookTop {
+    std::uint64_t updates_;     // publishes so far, 0 before the first
+    std::int64_t published_ns_; // steady_clock at publish, for staleness
+    Timestamp exch_timestamp_;  // of the last book update applied
+    Timestamp local_timestamp_;
+    DepthLevel best_bid_; // zero when the side is empty
+    DepthLevel best_ask_;
+    Timestamp trade_exch_timestamp_; // last trade, zero before the first
+    Timestamp trade_local_timestamp_;
+    Price trade_price_;
+    Quantity trade_quantity_;
+    TradeSide trade_side_;
+};
+
+struct ShmBookFrame {
+    ShmBookTop top_; // first, so a top-only read copies a prefix
+    std::uint64_t bid_count_; // populated entries of bids_
+    std::uint64_t ask_count_; // populated entries of asks_
+    std::array<DepthLevel, kSnapshotLevels> bids_; // best first
+    std::array<DepthLevel, kSnapshotLevels> asks_;
+};
+
+static_assert(std::is_trivially_copyable_v<ShmBookFrame>);
+static_assert(sizeof(ShmBookTop) % 8 == 0 && sizeof(ShmBookFrame) % 8 == 0);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "the region is shared between processes");
+
+inline constexpr std::size_t kShmBookWords = sizeof(ShmBookFrame) / 8;
+
+/**
+ * @brief Layout of the shared-memory object. The frame is guarded by a
+ * seqlock: the sequence is odd while the writer is copying a frame in and
+ * even otherwise. Payload words are relaxed atomics, so a reader racing the
+ * writer reads a torn copy that the sequence check rejects rather than
+ * undefined behaviour.
+ */
+struct ShmBookRegion {
+    std::atomic<std::uint64_t> magic_; // stored last by the writer
+    std::uint32_t version_;
+    std::uint32_t depth_; // levels per side the writer fills
+    char symbol_[32];
+    alignas(64) std::atomic<std::uint64_t> sequence_;
+    alignas(64) std::array<std::atomic<std::uint64_t>, kShmBookWords> words_;
+};
+
+/**
+ * @brief The single writer of a book region. Creates (or takes over) the
+ * POSIX shared-memory object and unlinks it on destruction.
+ */
+class ShmBookWriter {
+  public:
+    ShmBookWriter(const std::string &name, const std::string &symbol,
+                  std::size_t depth);
+    ~ShmBookWriter();
+    ShmBookWriter(const ShmBookWriter &) = delete;
+    ShmBookWriter &operator=(const ShmBookWriter &) = delete;
+
+    void publish(const ShmBookFrame &frame);
+
+    const std::string &name() const { return name_; }
+    std::size_t depth() const { return depth_; }
+
+  private:
+    std::string name_;
+    std::size_t depth_;
+    ShmBookRegion *region_ = nullptr;
+    std::uint64_t sequence_ = 0; // the writer's copy, always even
+};
+
+/**
+ * @brief A read-only view of a book region. Reads never block the writer or
+ * each other: try_read() makes one attempt and is wait-free, read() retries
+ * until it gets a consistent copy.
+ */
+class ShmBookReader {
+  public:
+    explicit ShmBookReader(const std::string &name);
+    ~ShmBookReader();
+    ShmBookReader(const ShmBookReader &) = delete;
+    ShmBookReader &operator=(const ShmBookReader &) = delete;
+
+    // changes on every publish; compare to skip copying an unchanged book
+    std::uint64_t sequence() const {
+        return region_->sequence_.load(std::memory_order_acquire);
+    }
+
+    bool try_read(ShmBookFrame &frame) const { return try_copy(frame); }
+    bool try_read(ShmBookTop &top) const { return try_copy(top); }
+
+    void read(ShmBookFrame &frame) const {
+        while (!try_copy(frame)) {
+        }
+    }
+    void read(ShmBookTop &top) const {
+        while (!try_copy(top)) {
+        }
+    }
+
+    std::string symbol() const;
+    std::size_t depth() const { return region_->depth_; }
+
+  private:
+    // copies the first sizeof(T) bytes of the frame under the seqlock
+    template <typename T> bool try_copy(T &out) const {
+        constexpr std::size_t words = sizeof(T) / 8;
+        static_assert(sizeof(T) % 8 == 0 && words <= kShmBookWords);
+        const std::uint64_t before =
+            region_->sequence_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        std::uint64_t copy[words];
+        for (std::size_t i = 0; i < words; ++i) {
+            copy[i] = region_->words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (region_->sequence_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&out, copy, sizeof(T));
+        return true;
+    }
+
+    const ShmBookRegion *region_ = nullptr;
+};
+} // namespace core::market_data::live
@@ -6,20 +6,26 @@
  */
 
 #include <chrono>
-#include <future>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "../../utils/thread/task_pool.h"
 #include "../market_data/book_update.h"
+#include "../market_data/book_update_batch.h"
+#include "../market_data/mbo_update.h"
+#include "../market_data/quote.h"
 #include "../market_data/trade.h"
 #include "../orderbook/orderbook.h"
 #include "../types/aliases/usings.h"
 #include "../types/enums/event_type.h"
 #include "market_data_feed.h"
 #include "readers/book_stream_reader.h"
+#include "readers/mbo_stream_reader.h"
+#include "readers/quote_stream_reader.h"
 #include "readers/trade_stream_reader.h"
 
 namespace core::market_data {
@@ -48,11 +54,19 @@ MarketDataFeed::MarketDataFeed(
     const std::unordered_map<int, std::string> &trade_files) {
     using namespace core::market_data;
 
-    for (const auto &[asset_id, book_file] : book_files) {
-        auto trade_it = trade_files.find(asset_id);
+    // assets are opened in parallel, each opening its two files in parallel
+    const std::vector<std::pair<int, std::string>> assets(book_files.begin(),
+                                                          book_files.end());
+    std::vector<StreamState> streams(assets.size());
+    utils::thread::parallel_for(0, assets.size(), [&](std::size_t i) {
+        auto trade_it = trade_files.find(assets[i].first);
         std::string trade_file =
             (trade_it != trade_files.end()) ? trade_it->second : "";
-        add_stream(asset_id, book_file, trade_file);
+        streams[i] =
+            open_book_stream(assets[i].second, trade_file, std::nullopt);
+    });
+    for (std::size_t i = 0; i < assets.size(); ++i) {
+        asset_streams_[assets[i].first] = std::move(streams[i]);
     }
 }
 
@@ -74,55 +88,206 @@ MarketDataFeed::MarketDataFeed(
  */
 void MarketDataFeed::add_stream(int asset_id, const std::string &book_file,
                                 const std::string &trade_file) {
+    add_book_stream(asset_id, book_file, trade_file, std::nullopt);
+}
+
+/**
+ * @brief Adds an asset data stream that starts from a book checkpoint.
+ *
+ * The first book event is a snapshot batch holding the checkpoint's book;
+ * book and trade reading then resume at the checkpoint's file offsets, so
+ * the stream continues exactly as a replay from the start of the files
+ * would, without reading what came before.
+ *
+ * @param checkpoint A checkpoint of @p book_file and @p trade_file, e.g. from
+ * find_book_checkpoint().
+ */
+void MarketDataFeed::add_stream(int asset_id, const std::string &book_file,
+                                const std::string &trade_file,
+                                const BookCheckpoint &checkpoint) {
+    add_book_stream(asset_id, book_file, trade_file, checkpoint);
+}
+
+void MarketDataFeed::add_book_stream(
+    int asset_id, const std::string &book_file, const std::string &trade_file,
+    const std::optional<BookCheckpoint> &checkpoint) {
+    asset_streams_[asset_id] =
+        open_book_stream(book_file, trade_file, checkpoint);
+}
+
+/**
+ * @brief Opens an asset's book and trade readers in parallel on the shared
+ * task pool.
+ */
+MarketDataFeed::StreamState MarketDataFeed::open_book_stream(
+    const std::string &book_file, const std::string &trade_file,
+    const std::optional<BookCheckpoint> &checkpoint) const {
     using namespace core::market_data;
     StreamState stream;
-
-    auto book_future = std::async(std::launch::async, [book_file]() {
-        auto reader = std::make_unique<BookStreamReader>();
-        reader->open(book_file);
-        return reader;
-    });
-    auto trade_future = std::async(std::launch::async, [trade_file]() {
-        auto reader = std::make_unique<TradeStreamReader>();
-        reader->open(trade_file);
-        return reader;
+    utils::thread::parallel_for(0, 2, [&](std::size_t reader) {
+        if (reader == 0) {
+            stream.book_reader = std::make_unique<BookStreamReader>();
+            if (checkpoint) {
+                stream.book_reader->open(book_file, *checkpoint);
+            } else {
+                stream.book_reader->open(book_file);
+            }
+        } else {
+            stream.trade_reader = std::make_unique<TradeStreamReader>();
+            stream.trade_reader->open(
+                trade_file, checkpoint ? checkpoint->trade_offset_ : 0);
+        }
     });
-    stream.book_reader = book_future.get();
-    stream.trade_reader = trade_future.get();
     stream.book_reader->set_market_feed_latency_us(market_feed_latency_us_);
     stream.trade_reader->set_market_feed_latency_us(market_feed_latency_us_);
+    stream.trade_reader->set_aggregate_trades(aggregate_trades_);
+    return stream;
+}
+
+/**
+ * @brief Adds an asset stream replayed from a decoded event tape.
+ *
+ * Events are delivered exactly as add_stream() would deliver them from the
+ * files the tape was decoded from. Local timestamps and trade aggregation
+ * were fixed when the tape was decoded, so set_market_feed_latency() and
+ * set_trade_aggregation() do not affect tape streams. Compressed book rows
+ * are decoded a block at a time as the stream advances.
+ *
+ * @param tape The asset's tape; must outlive the feed.
+ */
+void MarketDataFeed::add_tape_stream(int asset_id, const AssetTape &tape) {
+    StreamState stream;
+    stream.tape = &tape;
+    if (!tape.compressed_book_.empty()) {
+        stream.tape_cursor.emplace(tape.compressed_book_.cursor());
+    }
+    asset_streams_[asset_id] = std::move(stream);
+}
+
+/**
+ * @brief Adds an asset whose book is described by order-level (L3) events.
+ *
+ * Like add_stream(), but the book side of the stream is read by an
+ * `MboStreamReader` and delivered as `EventType::MboUpdate` events by
+ * next_event().
+ *
+ * @param asset_id The unique identifier of the asset.
+ * @param order_file Path to the CSV file containing order-level events.
+ * @param trade_file Path to the CSV file containing trade data.
+ */
+void MarketDataFeed::add_mbo_stream(int asset_id, const std::string &order_file,
+                                    const std::string &trade_file) {
+    using namespace core::market_data;
+    StreamState stream;
+    stream.mbo_reader = std::make_unique<MboStreamReader>();
+    stream.mbo_reader->open(order_file);
+    stream.trade_reader = std::make_unique<TradeStreamReader>();
+    stream.trade_reader->open(trade_file);
+    stream.mbo_reader->set_market_feed_latency_us(market_feed_latency_us_);
+    stream.trade_reader->set_market_feed_latency_us(market_feed_latency_us_);
+    stream.trade_reader->set_aggregate_trades(aggregate_trades_);
+    asset_streams_[asset_id] = std::move(stream);
+}
+
+/**
+ * @brief Adds an asset whose book is described by best bid/offer updates only.
+ *
+ * Like add_stream(), but the book side of the stream is read by a
+ * `QuoteStreamReader` and delivered as `EventType::Quote` events by
+ * next_event().
+ *
+ * @param asset_id The unique identifier of the asset.
+ * @param quote_file Path to the CSV file containing best bid/offer updates.
+ * @param trade_file Path to the CSV file containing trade data.
+ */
+void MarketDataFeed::add_quote_stream(int asset_id,
+                                      const std::string &quote_file,
+                                      const std::string &trade_file) {
+    using namespace core::market_data;
+    StreamState stream;
+    stream.quote_reader = std::make_unique<QuoteStreamReader>();
+    stream.quote_reader->open(quote_file);
+    stream.trade_reader = std::make_unique<TradeStreamReader>();
+    stream.trade_reader->open(trade_file);
+    stream.quote_reader->set_market_feed_latency_us(market_feed_latency_us_);
+    stream.trade_reader->set_market_feed_latency_us(market_feed_latency_us_);
+    stream.trade_reader->set_aggregate_trades(aggregate_trades_);
     asset_streams_[asset_id] = std::move(stream);
 }
 
 /**
- * @brief Retrieves the next market data event (either book update or trade)
- * across all assets.
+ * @brief Retrieves the next market data event across all assets.
  *
- * This function scans all asset streams and identifies the earliest event based
- * on timestamp. The event can be either a `BookUpdate` or a `Trade`, and is
- * selected in global chronological order from all assets being tracked. The
- * corresponding event is returned via reference parameters, and internal stream
- * pointers are advanced accordingly.
+ * Events are selected in global chronological order from all assets being
+ * tracked, and the stream they came from is advanced. Book rows are grouped:
+ * every consecutive row of the asset sharing the first row's exchange and
+ * local timestamps is drained into `event.book_batch_` and returned as one
+ * `EventType::BookUpdateBatch` event. Order-level events of streams added
+ * with add_mbo_stream() arrive as `EventType::MboUpdate`, best bid/offer
+ * updates of streams added with add_quote_stream() as `EventType::Quote`,
+ * and trades as `EventType::Trade`.
  *
- * @param[out] asset_id The asset ID associated with the next event.
- * @param[out] event_type The type of the next event (`EventType::BookUpdate` or
- * `EventType::Trade`).
- * @param[out] book_update The book update event data (valid only if event_type
- * is BookUpdate).
- * @param[out] trade The trade event data (valid only if event_type is Trade).
+ * @param[out] event The event; only the member matching its `event_type_` is
+ * set. The batch's row storage is reused when @p event is.
  * @return true if a new event was found and returned, false if all streams are
  * exhausted.
  */
-bool MarketDataFeed::next_event(int &asset_id, EventType &event_type,
-                                core::market_data::BookUpdate &book_update,
-                                core::market_data::Trade &trade) {
-    using namespace core::market_data;
+bool MarketDataFeed::next_event(MarketEvent &event) {
+    if (!select_next(event.asset_id_, event.event_type_)) return false;
+
+    auto &stream = asset_streams_.at(event.asset_id_);
+    switch (event.event_type_) {
+    case EventType::BookUpdate: {
+        auto &batch = event.book_batch_;
+        event.event_type_ = EventType::BookUpdateBatch;
+        batch.exch_timestamp_ = stream.next_book_update->exch_timestamp_;
+        batch.local_timestamp_ = stream.next_book_update->local_timestamp_;
+        batch.updates_.clear();
+        do {
+            batch.updates_.push_back(*stream.next_book_update);
+            stream.advance_book();
+        } while (stream.next_book_update.has_value() &&
+                 stream.next_book_update->exch_timestamp_ ==
+                     batch.exch_timestamp_ &&
+                 stream.next_book_update->local_timestamp_ ==
+                     batch.local_timestamp_);
+        break;
+    }
+    case EventType::MboUpdate:
+        event.mbo_update_ = *stream.next_mbo_update;
+        stream.advance_mbo();
+        break;
+    case EventType::Quote:
+        event.quote_ = *stream.next_quote;
+        stream.advance_quote();
+        break;
+    default:
+        event.trade_ = *stream.next_trade;
+        stream.advance_trade();
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the stream holding the earliest pending event.
+ *
+ * Book updates win ties against trades of the same asset, and lower asset IDs
+ * win ties across assets.
+ *
+ * @param[out] asset_id The asset ID of the earliest event.
+ * @param[out] event_type `EventType::BookUpdate`, `EventType::MboUpdate`,
+ * `EventType::Quote` or `EventType::Trade`.
+ * @return true if an event is pending, false if all streams are exhausted.
+ */
+bool MarketDataFeed::select_next(int &asset_id, EventType &event_type) {
     bool found = false;
     Timestamp min_time = std::numeric_limits<Timestamp>::max();
 
     for (auto &[id, stream] : asset_streams_) {
         // Ensure both streams are preloaded (happens only once)
         if (!stream.next_book_update.has_value()) stream.advance_book();
+        if (!stream.next_mbo_update.has_value()) stream.advance_mbo();
+        if (!stream.next_quote.has_value()) stream.advance_quote();
         if (!stream.next_trade.has_value()) stream.advance_trade();
 
         if (stream.next_book_update.has_value() &&
@@ -133,6 +298,22 @@ bool MarketDataFeed::next_event(int &asset_id, EventType &event_type,
             found = true;
         }
 
+        if (stream.next_mbo_update.has_value() &&
+            stream.next_mbo_update->exch_timestamp_ < min_time) {
+            min_time = stream.next_mbo_update->exch_timestamp_;
+            asset_id = id;
+            event_type = EventType::MboUpdate;
+            found = true;
+        }
+
+        if (stream.next_quote.has_value() &&
+            stream.next_quote->exch_timestamp_ < min_time) {
+            min_time = stream.next_quote->exch_timestamp_;
+            asset_id = id;
+            event_type = EventType::Quote;
+            found = true;
+        }
+
         if (stream.next_trade.has_value() &&
             stream.next_trade->exch_timestamp_ < min_time) {
             min_time = stream.next_trade->exch_timestamp_;
@@ -141,19 +322,18 @@ bool MarketDataFeed::next_event(int &asset_id, EventType &event_type,
             found = true;
         }
     }
+    return found;
+}
 
-    if (!found) return false;
-
-    auto &stream = asset_streams_.at(asset_id);
-    if (event_type == EventType::BookUpdate) {
-        book_update = *stream.next_book_update;
-        stream.advance_book();
-    } else {
-        trade = *stream.next_trade;
-        stream.advance_trade();
-    }
-
-    return true;
+/**
+ * @brief Returns true if the book tape of @p asset_id was cleaned by
+ * validate_book_tape and is unchanged since.
+ */
+bool MarketDataFeed::verified(int asset_id) const {
+    const auto it = asset_streams_.find(asset_id);
+    if (it == asset_streams_.end()) return false;
+    if (it->second.tape) return it->second.tape->verified_;
+    return it->second.book_reader && it->second.book_reader->verified();
 }
 
 /**
@@ -174,6 +354,8 @@ std::optional<Timestamp> MarketDataFeed::peek_timestamp() {
 
     for (auto &[asset_id, stream] : asset_streams_) {
         if (!stream.next_book_update.has_value()) stream.advance_book();
+        if (!stream.next_mbo_update.has_value()) stream.advance_mbo();
+        if (!stream.next_quote.has_value()) stream.advance_quote();
         if (!stream.next_trade.has_value()) stream.advance_trade();
 
         if (stream.next_book_update.has_value()) {
@@ -183,6 +365,20 @@ std::optional<Timestamp> MarketDataFeed::peek_timestamp() {
             }
         }
 
+        if (stream.next_mbo_update.has_value()) {
+            Timestamp ts = stream.next_mbo_update->exch_timestamp_;
+            if (!earliest.has_value() || ts < *earliest) {
+                earliest = ts;
+            }
+        }
+
+        if (stream.next_quote.has_value()) {
+            Timestamp ts = stream.next_quote->exch_timestamp_;
+            if (!earliest.has_value() || ts < *earliest) {
+                earliest = ts;
+            }
+        }
+
         if (stream.next_trade.has_value()) {
             Timestamp ts = stream.next_trade->exch_timestamp_;
             if (!earliest.has_value() || ts < *earliest) {
@@ -207,8 +403,25 @@ std::optional<Timestamp> MarketDataFeed::peek_timestamp() {
  */
 bool MarketDataFeed::StreamState::advance_book() {
     using namespace core::market_data;
+    if (tape_cursor) {
+        BookUpdate update;
+        if (tape_cursor->next(update)) {
+            next_book_update = update;
+            return true;
+        }
+        next_book_update.reset();
+        return false;
+    }
+    if (tape) {
+        if (tape_book_pos < tape->book_updates_.size()) {
+            next_book_update = tape->book_updates_[tape_book_pos++];
+            return true;
+        }
+        next_book_update.reset();
+        return false;
+    }
     BookUpdate update;
-    if (book_reader->parse_next(update)) {
+    if (book_reader && book_reader->parse_next(update)) {
         next_book_update = update;
         return true;
     }
@@ -216,6 +429,40 @@ bool MarketDataFeed::StreamState::advance_book() {
     return false;
 }
 
+/**
+ * @brief Advances the order-level stream to the next available event.
+ *
+ * @return true if a new event was parsed and stored in `next_mbo_update`,
+ * false if the stream has ended or the asset has no order-level stream.
+ */
+bool MarketDataFeed::StreamState::advance_mbo() {
+    using namespace core::market_data;
+    MboUpdate update;
+    if (mbo_reader && mbo_reader->parse_next(update)) {
+        next_mbo_update = update;
+        return true;
+    }
+    next_mbo_update.reset();
+    return false;
+}
+
+/**
+ * @brief Advances the quote stream to the next best bid/offer update.
+ *
+ * @return true if a new quote was parsed and stored in `next_quote`, false if
+ * the stream has ended or the asset has no quote stream.
+ */
+bool MarketDataFeed::StreamState::advance_quote() {
+    using namespace core::market_data;
+    Quote quote;
+    if (quote_reader && quote_reader->parse_next(quote)) {
+        next_quote = quote;
+        return true;
+    }
+    next_quote.reset();
+    return false;
+}
+
 /**
  * @brief Advances the trade stream to the next available trade.
  *
@@ -229,6 +476,14 @@ bool MarketDataFeed::StreamState::advance_book() {
  */
 bool MarketDataFeed::StreamState::advance_trade() {
     using namespace core::market_data;
+    if (tape) {
+        if (tape_trade_pos < tape->trades_.size()) {
+            next_trade = tape->trades_[tape_trade_pos++];
+            return true;
+        }
+        next_trade.reset();
+        return false;
+    }
     Trade trade;
     if (trade_reader->parse_next(trade)) {
         next_trade = trade;
@@ -241,8 +496,31 @@ bool MarketDataFeed::StreamState::advance_trade() {
 void MarketDataFeed::set_market_feed_latency(Microseconds latency_us) {
     market_feed_latency_us_ = latency_us;
     for (auto &[_, stream] : asset_streams_) {
-        stream.book_reader->set_market_feed_latency_us(latency_us);
-        stream.trade_reader->set_market_feed_latency_us(latency_us);
+        if (stream.book_reader)
+            stream.book_reader->set_market_feed_latency_us(latency_us);
+        if (stream.mbo_reader)
+            stream.mbo_reader->set_market_feed_latency_us(latency_us);
+        if (stream.quote_reader)
+            stream.quote_reader->set_market_feed_latency_us(latency_us);
+        if (stream.trade_reader)
+            stream.trade_reader->set_market_feed_latency_us(latency_us);
+    }
+}
+
+/**
+ * @brief Enables or disables trade aggregation on all trade streams.
+ *
+ * When enabled, consecutive trades with the same exchange timestamp, side and
+ * price are delivered as a single trade event. Applies to existing streams and
+ * to streams added afterwards.
+ *
+ * @param aggregate true to merge identical-timestamp trades.
+ */
+void MarketDataFeed::set_trade_aggregation(bool aggregate) {
+    aggregate_trades_ = aggregate;
+    for (auto &[_, stream] : asset_streams_) {
+        if (stream.trade_reader)
+            stream.trade_reader->set_aggregate_trades(aggregate);
     }
 }
 } // namespace core::market_data
\ No newline at end of file
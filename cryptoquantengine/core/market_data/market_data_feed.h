@@ -17,8 +17,16 @@
 #include "../orderbook/orderbook.h"
 #include "../types/enums/event_type.h"
 #include "../types/aliases/usings.h"
+#include "book_checkpoint.h"
 #include "book_update.h"
+#include "book_update_batch.h"
+#include "event_tape.h"
+#include "market_event.h"
+#include "mbo_update.h"
+#include "quote.h"
 #include "readers/book_stream_reader.h"
+#include "readers/mbo_stream_reader.h"
+#include "readers/quote_stream_reader.h"
 #include "readers/trade_stream_reader.h"
 #include "trade.h"
 
@@ -31,24 +39,54 @@ class MarketDataFeed {
 
     void add_stream(int asset_id, const std::string &book_file,
                     const std::string &trade_file);
-    bool next_event(int &asset_id, EventType &event_type,
-                    core::market_data::BookUpdate &book_update,
-                    core::market_data::Trade &trade);
+    void add_stream(int asset_id, const std::string &book_file,
+                    const std::string &trade_file,
+                    const BookCheckpoint &checkpoint);
+    void add_tape_stream(int asset_id, const AssetTape &tape);
+    void add_mbo_stream(int asset_id, const std::string &order_file,
+                        const std::string &trade_file);
+    void add_quote_stream(int asset_id, const std::string &quote_file,
+                          const std::string &trade_file);
+    bool next_event(MarketEvent &event);
     std::optional<Timestamp> peek_timestamp();
+    bool verified(int asset_id) const;
     void set_market_feed_latency(Microseconds latency_us);
+    void set_trade_aggregation(bool aggregate);
 
   private:
     struct StreamState {
         std::unique_ptr<core::market_data::BookStreamReader> book_reader;
         std::unique_ptr<core::market_data::TradeStreamReader> trade_reader;
+        std::unique_ptr<core::market_data::MboStreamReader> mbo_reader;
+        std::unique_ptr<core::market_data::QuoteStreamReader> quote_reader;
 
         std::optional<core::market_data::BookUpdate> next_book_update;
         std::optional<core::market_data::Trade> next_trade;
+        std::optional<core::market_data::MboUpdate> next_mbo_update;
+        std::optional<core::market_data::Quote> next_quote;
+
+        // replayed instead of the book and trade readers when set
+        const AssetTape *tape = nullptr;
+        std::size_t tape_book_pos = 0;
+        std::size_t tape_trade_pos = 0;
+        std::optional<CompressedBookTape::Cursor> tape_cursor;
 
         bool advance_book();
         bool advance_trade();
+        bool advance_mbo();
+        bool advance_quote();
     };
+    bool select_next(int &asset_id, EventType &event_type);
+    void add_book_stream(int asset_id, const std::string &book_file,
+                         const std::string &trade_file,
+                         const std::optional<BookCheckpoint> &checkpoint);
+    StreamState
+    open_book_stream(const std::string &book_file,
+                     const std::string &trade_file,
+                     const std::optional<BookCheckpoint> &checkpoint) const;
+
     std::map<int, StreamState> asset_streams_;
     Microseconds market_feed_latency_us_ = 10'000;
+    bool aggregate_trades_ = false;
 };
 } // namespace core::market_data
\ No newline at end of file
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include "../types/enums/event_type.h"
+#include "book_update_batch.h"
+#include "mbo_update.h"
+#include "quote.h"
+#include "trade.h"
+
+namespace core::market_data {
+/**
+ * @brief One event delivered by MarketDataFeed::next_event().
+ *
+ * Only the member matching `event_type_` holds the event; the others keep
+ * what earlier events left in them, so reusing one MarketEvent across calls
+ * also reuses the batch's row storage.
+ */
+struct MarketEvent {
+    int asset_id_ = 0;
+    EventType event_type_ = EventType::None;
+
+    BookUpdateBatch book_batch_; // EventType::BookUpdateBatch
+    Trade trade_;                // EventType::Trade
+    MboUpdate mbo_update_;       // EventType::MboUpdate
+    Quote quote_;                // EventType::Quote
+};
+} // namespace core::market_data
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "../types/aliases/usings.h"
+#include "../types/enums/book_side.h"
+#include "../types/enums/mbo_action.h"
+
+namespace core::market_data {
+// one order-level (market-by-order, L3) book event
+struct MboUpdate {
+    Timestamp exch_timestamp_;  // arrives at exchange first
+    Timestamp local_timestamp_; // sent to local with latency
+
+    std::uint64_t order_id_; // exchange-assigned id of the resting order
+    MboAction action_;
+    BookSide side_;
+
+    Price price_;
+    Quantity quantity_; // remaining order quantity after the event
+};
+} // namespace core::market_data
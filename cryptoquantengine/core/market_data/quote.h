@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include "../types/aliases/usings.h"
+
+namespace core::market_data {
+// best bid/offer update (Tardis quotes, Binance bookTicker)
+struct Quote {
+    Timestamp exch_timestamp_;  // arrives at exchange first
+    Timestamp local_timestamp_; // sent to local with latency
+
+    Price bid_price_; // 0 = no bid
+    Quantity bid_quantity_;
+    Price ask_price_; // 0 = no ask
+    Quantity ask_quantity_;
+};
+} // namespace core::market_data
@@ -5,16 +5,81 @@
  * associated with this software.
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
 #include "base_stream_reader.h"
 #include "../../../../external/csv/csv.h"
 
 namespace core::market_data {
+namespace {
+// serves the header line, then the file from a saved row offset, so the CSV
+// reader sees a well-formed file that starts mid-stream
+class OffsetByteSource : public io::ByteSourceBase {
+  public:
+    OffsetByteSource(FILE *file, std::string header)
+        : file_(file), header_(std::move(header)) {}
+    ~OffsetByteSource() override { std::fclose(file_); }
+
+    // the CSV reader takes a short read for end of file, so always fill
+    int read(char *buffer, int size) override {
+        std::size_t n = 0;
+        if (header_pos_ < header_.size()) {
+            n = std::min(static_cast<std::size_t>(size),
+                         header_.size() - header_pos_);
+            std::memcpy(buffer, header_.data() + header_pos_, n);
+            header_pos_ += n;
+        }
+        n += std::fread(buffer + n, 1, static_cast<std::size_t>(size) - n,
+                        file_);
+        return static_cast<int>(n);
+    }
+
+  private:
+    FILE *file_;
+    std::string header_;
+    std::size_t header_pos_ = 0;
+};
+
+std::unique_ptr<io::ByteSourceBase> open_at(const std::string &filename,
+                                            std::uint64_t offset) {
+    FILE *file = std::fopen(filename.c_str(), "rb");
+    if (!file) throw std::runtime_error("Failed to open file: " + filename);
+    std::string header;
+    for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file)) {
+        header.push_back(static_cast<char>(c));
+        if (c == '\n') break;
+    }
+    if (std::fseek(file, static_cast<long>(offset), SEEK_SET) != 0) {
+        std::fclose(file);
+        throw std::runtime_error("Failed to seek in file: " + filename);
+    }
+    return std::make_unique<OffsetByteSource>(file, std::move(header));
+}
+} // namespace
+
 BaseStreamReader::CSVReaderImpl::CSVReaderImpl(const std::string &filename)
     : reader(filename) {}
 
+/**
+ * @brief Opens @p filename for reading from the row starting at byte
+ * @p offset (as saved in a book checkpoint); the header is still read from
+ * the top of the file.
+ */
+BaseStreamReader::CSVReaderImpl::CSVReaderImpl(const std::string &filename,
+                                               std::uint64_t offset)
+    : reader(filename, open_at(filename, offset)) {}
+
 void BaseStreamReader::init_csv_reader(const std::string &filename,
-                                       const std::vector<std::string> &cols) {
-    csv_reader_ = std::make_unique<CSVReaderImpl>(filename);
+                                       const std::vector<std::string> &cols,
+                                       std::uint64_t offset) {
+    csv_reader_ = offset == 0
+                      ? std::make_unique<CSVReaderImpl>(filename)
+                      : std::make_unique<CSVReaderImpl>(filename, offset);
     csv_reader_->reader.read_header(
         io::ignore_extra_column | io::ignore_missing_column, cols[0].c_str(),
         cols[1].c_str(), cols[2].c_str(), cols[3].c_str(), cols[4].c_str(),
@@ -30,4 +95,13 @@ void BaseStreamReader::init_csv_reader(const std::string &filename,
 void BaseStreamReader::set_market_feed_latency_us(Microseconds latency) {
     market_feed_latency_us_ = latency;
 }
+
+/**
+ * @brief Returns the file line of the last row read (the header is line 1),
+ * or 0 before the first read. Counts from the resume offset for readers
+ * opened mid-file.
+ */
+unsigned BaseStreamReader::file_line() const {
+    return csv_reader_ ? csv_reader_->reader.get_file_line() : 0;
+}
 } // namespace core::market_data
\ No newline at end of file
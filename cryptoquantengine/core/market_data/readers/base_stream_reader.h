@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -22,9 +23,11 @@ class BaseStreamReader {
         io::CSVReader<6> reader;
         std::unordered_map<std::string, size_t> column_map;
         explicit CSVReaderImpl(const std::string &filename);
+        CSVReaderImpl(const std::string &filename, std::uint64_t offset);
     };
     void init_csv_reader(const std::string &filename,
-                         const std::vector<std::string> &cols);
+                         const std::vector<std::string> &cols,
+                         std::uint64_t offset = 0);
     std::unique_ptr<CSVReaderImpl> csv_reader_;
     bool has_local_timestamp_ = false;
     Microseconds market_feed_latency_us_ = 0;
@@ -33,5 +36,6 @@ class BaseStreamReader {
     virtual ~BaseStreamReader() = default;
     virtual void open(const std::string &filename) = 0;
     void set_market_feed_latency_us(Microseconds latency);
+    unsigned file_line() const;
 };
 } // namespace core::market_data
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -32,12 +33,78 @@ void BookStreamReader::open(const std::string &filename) {
                                      "is_snapshot", "side",
                                      "price",       "amount"};
     init_csv_reader(filename, cols);
+    seed_rows_.clear();
+    seed_pos_ = 0;
+    verified_ = is_verified(filename);
 }
+
+/**
+ * @brief Opens the file to resume from a book checkpoint.
+ *
+ * The checkpoint's levels are returned first, as snapshot rows stamped with
+ * the checkpoint's timestamps, followed by the file's rows from the
+ * checkpoint's book offset onwards.
+ */
+void BookStreamReader::open(const std::string &filename,
+                            const BookCheckpoint &checkpoint) {
+    std::vector<std::string> cols = {"timestamp",   "local_timestamp",
+                                     "is_snapshot", "side",
+                                     "price",       "amount"};
+    init_csv_reader(filename, cols, checkpoint.book_offset_);
+    seed_rows_.clear();
+    seed_pos_ = 0;
+    verified_ = is_verified(filename);
+    auto seed = [&](BookSide side, const auto &levels) {
+        for (const auto &[price, quantity] : levels) {
+            seed_rows_.push_back(
+                BookUpdate{.exch_timestamp_ = checkpoint.exch_timestamp_,
+                           .local_timestamp_ = checkpoint.local_timestamp_,
+                           .update_type_ = UpdateType::Snapshot,
+                           .side_ = side,
+                           .price_ = price,
+                           .quantity_ = quantity});
+        }
+    };
+    seed(BookSide::Bid, checkpoint.bids_);
+    seed(BookSide::Ask, checkpoint.asks_);
+}
+/**
+ * @brief Path of the side-car written next to a tape cleaned by
+ * validate_book_tape.
+ */
+std::string BookStreamReader::verified_marker(const std::string &filename) {
+    return filename + ".verified";
+}
+
+/**
+ * @brief Returns true if @p filename has a verified side-car whose recorded
+ * size matches the file, i.e. the tape has not changed since it was cleaned.
+ */
+bool BookStreamReader::is_verified(const std::string &filename) {
+    std::ifstream marker(verified_marker(filename));
+    std::string line;
+    if (!marker.is_open() || !std::getline(marker, line) ||
+        line.rfind("bytes=", 0) != 0) {
+        return false;
+    }
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(filename, ec);
+    return !ec && line.substr(6) == std::to_string(size);
+}
+
 /*
  * @brief Parses the next row from the CSV file and populates the BookUpdate
  * object.
  */
 bool BookStreamReader::parse_next(core::market_data::BookUpdate &update) {
+    if (seed_pos_ < seed_rows_.size()) {
+        update = seed_rows_[seed_pos_++];
+        if (!has_local_timestamp_) {
+            update.local_timestamp_ =
+                update.exch_timestamp_ + market_feed_latency_us_;
+        }
+        return true;
+    }
     if (!csv_reader_) return false;
     try {
         Timestamp exch_timestamp = 0;
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -16,6 +17,7 @@
 #include "../../market_data/book_update.h"
 #include "../../types/enums/book_side.h"
 #include "../../types/aliases/usings.h"
+#include "../book_checkpoint.h"
 #include "base_stream_reader.h"
 
 namespace core::market_data {
@@ -25,6 +27,17 @@ class BookStreamReader : public BaseStreamReader {
     explicit BookStreamReader(const std::string &filename);
 
     void open(const std::string &filename) override;
+    void open(const std::string &filename, const BookCheckpoint &checkpoint);
     bool parse_next(core::market_data::BookUpdate &update);
+    bool verified() const { return verified_; }
+
+    static std::string verified_marker(const std::string &filename);
+    static bool is_verified(const std::string &filename);
+
+  private:
+    bool verified_ = false; // cleaned by validate_book_tape
+    // checkpoint levels, returned as snapshot rows before the file's rows
+    std::vector<core::market_data::BookUpdate> seed_rows_;
+    std::size_t seed_pos_ = 0;
 };
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "../../../../external/csv/csv.h"
+#include "../../market_data/mbo_update.h"
+#include "../../types/enums/book_side.h"
+#include "../../types/enums/mbo_action.h"
+#include "../../types/aliases/usings.h"
+#include "mbo_stream_reader.h"
+
+namespace core::market_data {
+MboStreamReader::MboStreamReader() = default;
+/*
+ * @brief Constructs an MboStreamReader and opens the specified CSV file.
+ */
+MboStreamReader::MboStreamReader(const std::string &filename) {
+    open(filename);
+}
+
+void MboStreamReader::open(const std::string &filename) {
+    mbo_reader_ = std::make_unique<io::CSVReader<7>>(filename);
+    mbo_reader_->read_header(
+        io::ignore_extra_column | io::ignore_missing_column, "timestamp",
+        "local_timestamp", "order_id", "action", "side", "price", "amount");
+    has_local_timestamp_ = mbo_reader_->has_column("local_timestamp");
+}
+/*
+ * @brief Parses the next row from the CSV file and populates the MboUpdate
+ * object. Rows with a missing or unknown action or side are skipped.
+ */
+bool MboStreamReader::parse_next(core::market_data::MboUpdate &update) {
+    if (!mbo_reader_) return false;
+    try {
+        Timestamp exch_timestamp = 0;
+        Timestamp local_timestamp = 0;
+        std::uint64_t order_id = 0;
+        std::string action_str;
+        std::string side_str;
+        double price = 0;
+        double quantity = 0;
+        while (mbo_reader_->read_row(exch_timestamp, local_timestamp,
+                                     order_id, action_str, side_str, price,
+                                     quantity)) {
+            if (!has_local_timestamp_) {
+                local_timestamp = exch_timestamp + market_feed_latency_us_;
+            }
+            MboAction action;
+            if (action_str == "add") {
+                action = MboAction::Add;
+            } else if (action_str == "modify") {
+                action = MboAction::Modify;
+            } else if (action_str == "delete") {
+                action = MboAction::Delete;
+            } else {
+                std::cerr << "Warning: Skipped row with unknown action '"
+                          << action_str << "'\n";
+                continue;
+            }
+            if (side_str != "bid" && side_str != "ask") {
+                std::cerr << "Warning: Skipped row with missing required "
+                             "fields\n";
+                continue;
+            }
+            update.exch_timestamp_ = exch_timestamp;
+            update.local_timestamp_ = local_timestamp;
+            update.order_id_ = order_id;
+            update.action_ = action;
+            update.side_ = (side_str == "bid") ? BookSide::Bid : BookSide::Ask;
+            update.price_ = price;
+            update.quantity_ = quantity;
+            return true;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Parsing error: " << e.what() << "\n";
+    }
+    return false;
+}
+} // namespace core::market_data
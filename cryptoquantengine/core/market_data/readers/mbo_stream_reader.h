@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "../../../../external/csv/csv.h"
+#include "../../market_data/mbo_update.h"
+#include "../../types/aliases/usings.h"
+#include "base_stream_reader.h"
+
+namespace core::market_data {
+/**
+ * @brief Reads order-level (L3) book events from CSV.
+ *
+ * Expected columns: timestamp, local_timestamp (optional), order_id, action
+ * (add/modify/delete), side (bid/ask), price, amount.
+ */
+class MboStreamReader : public BaseStreamReader {
+  public:
+    MboStreamReader();
+    explicit MboStreamReader(const std::string &filename);
+
+    void open(const std::string &filename) override;
+    bool parse_next(core::market_data::MboUpdate &update);
+
+  private:
+    // seven columns, so it does not fit the shared six-column reader
+    std::unique_ptr<io::CSVReader<7>> mbo_reader_;
+};
+} // namespace core::market_data
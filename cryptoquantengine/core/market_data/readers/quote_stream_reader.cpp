@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../../../external/csv/csv.h"
+#include "../../market_data/quote.h"
+#include "../../types/aliases/usings.h"
+#include "quote_stream_reader.h"
+
+namespace core::market_data {
+QuoteStreamReader::QuoteStreamReader() = default;
+
+QuoteStreamReader::QuoteStreamReader(const std::string &filename) {
+    open(filename);
+}
+
+void QuoteStreamReader::open(const std::string &filename) {
+    std::vector<std::string> cols = {"timestamp", "local_timestamp",
+                                     "ask_amount", "ask_price",
+                                     "bid_price", "bid_amount"};
+    init_csv_reader(filename, cols);
+}
+
+/**
+ * @brief Parses the next best bid/offer row from the CSV file.
+ *
+ * Empty price fields (a side with no resting liquidity) are read as 0.
+ *
+ * @param quote The quote to populate.
+ * @return true if a quote was parsed, false at end of file.
+ */
+bool QuoteStreamReader::parse_next(core::market_data::Quote &quote) {
+    if (!csv_reader_) return false;
+    try {
+        Timestamp exch_timestamp = 0;
+        Timestamp local_timestamp = 0;
+        std::string ask_quantity, ask_price, bid_price, bid_quantity;
+        if (!csv_reader_->reader.read_row(exch_timestamp, local_timestamp,
+                                          ask_quantity, ask_price, bid_price,
+                                          bid_quantity)) {
+            return false;
+        }
+        if (!has_local_timestamp_) {
+            local_timestamp = exch_timestamp + market_feed_latency_us_;
+        }
+        auto to_double = [](const std::string &s) {
+            return s.empty() ? 0.0 : std::stod(s);
+        };
+        quote.exch_timestamp_ = exch_timestamp;
+        quote.local_timestamp_ = local_timestamp;
+        quote.bid_price_ = to_double(bid_price);
+        quote.bid_quantity_ = to_double(bid_quantity);
+        quote.ask_price_ = to_double(ask_price);
+        quote.ask_quantity_ = to_double(ask_quantity);
+        return true;
+    } catch (const std::exception &e) {
+        std::cerr << "Parsing error: " << e.what() << "\n";
+    }
+    return false;
+}
+} // namespace core::market_data
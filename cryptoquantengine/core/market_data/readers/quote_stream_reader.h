@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "../../market_data/quote.h"
+#include "../../types/aliases/usings.h"
+#include "base_stream_reader.h"
+
+namespace core::market_data {
+/**
+ * @brief Reads best bid/offer updates from CSV.
+ *
+ * Expected columns (Tardis `quotes` layout): timestamp, local_timestamp
+ * (optional), ask_amount, ask_price, bid_price, bid_amount.
+ */
+class QuoteStreamReader : public BaseStreamReader {
+  public:
+    QuoteStreamReader();
+    explicit QuoteStreamReader(const std::string &filename);
+
+    void open(const std::string &filename) override;
+    bool parse_next(core::market_data::Quote &quote);
+};
+} // namespace core::market_data
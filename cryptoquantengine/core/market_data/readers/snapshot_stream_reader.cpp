@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../../market_data/depth_snapshot.h"
+#include "../../types/aliases/usings.h"
+#include "snapshot_stream_reader.h"
+
+namespace core::market_data {
+namespace {
+// splits "asks[12].price" into ("asks", 12, "price")
+bool parse_level_column(std::string_view name, std::string_view &side,
+                        int &level, std::string_view &field) {
+    auto open = name.find('[');
+    auto close = name.find("].");
+    if (open == std::string_view::npos || close == std::string_view::npos ||
+        close < open) {
+        return false;
+    }
+    side = name.substr(0, open);
+    field = name.substr(close + 2);
+    auto digits = name.substr(open + 1, close - open - 1);
+    auto [ptr, ec] =
+        std::from_chars(digits.data(), digits.data() + digits.size(), level);
+    return ec == std::errc() && ptr == digits.data() + digits.size();
+}
+} // namespace
+
+SnapshotStreamReader::SnapshotStreamReader() = default;
+
+SnapshotStreamReader::SnapshotStreamReader(const std::string &filename) {
+    open(filename);
+}
+
+/**
+ * @brief Opens a snapshot file and maps its header to snapshot fields.
+ * @throws std::runtime_error if the file cannot be opened or has no
+ * timestamp column.
+ */
+void SnapshotStreamReader::open(const std::string &filename) {
+    file_ = std::ifstream(filename);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Could not open snapshot file: " + filename);
+    }
+    columns_.clear();
+    has_local_timestamp_ = false;
+    bool has_timestamp = false;
+    if (!std::getline(file_, line_)) return;
+    if (!line_.empty() && line_.back() == '\r') line_.pop_back();
+
+    std::string_view header(line_);
+    while (true) {
+        auto comma = header.find(',');
+        std::string_view name = header.substr(0, comma);
+        Column column;
+        std::string_view side, field;
+        int level = 0;
+        if (name == "timestamp") {
+            column.field_ = Field::Timestamp;
+            has_timestamp = true;
+        } else if (name == "local_timestamp") {
+            column.field_ = Field::LocalTimestamp;
+            has_local_timestamp_ = true;
+        } else if (parse_level_column(name, side, level, field) &&
+                   level >= 0 &&
+                   level < static_cast<int>(kSnapshotLevels)) {
+            column.level_ = static_cast<std::uint8_t>(level);
+            if (side == "asks" && field == "price") {
+                column.field_ = Field::AskPrice;
+            } else if (side == "asks" && field == "amount") {
+                column.field_ = Field::AskAmount;
+            } else if (side == "bids" && field == "price") {
+                column.field_ = Field::BidPrice;
+            } else if (side == "bids" && field == "amount") {
+                column.field_ = Field::BidAmount;
+            }
+        }
+        columns_.push_back(column);
+        if (comma == std::string_view::npos) break;
+        header.remove_prefix(comma + 1);
+    }
+    if (!has_timestamp) {
+        throw std::runtime_error("Snapshot file has no timestamp column: " +
+                                 filename);
+    }
+}
+
+/**
+ * @brief Parses the next snapshot row.
+ *
+ * Numbers are decoded in place from the line buffer. A side ends at its first
+ * empty or zero-priced level, so `bid_count_`/`ask_count_` give the number of
+ * valid entries.
+ *
+ * @param snapshot The snapshot to populate.
+ * @return true if a row was parsed, false at end of file.
+ */
+bool SnapshotStreamReader::parse_next(
+    core::market_data::DepthSnapshot &snapshot) {
+    if (!file_.is_open()) return false;
+    while (std::getline(file_, line_)) {
+        if (!line_.empty() && line_.back() == '\r') line_.pop_back();
+        if (line_.empty()) continue;
+
+        snapshot.exch_timestamp_ = 0;
+        snapshot.local_timestamp_ = 0;
+        for (std::size_t i = 0; i < kSnapshotLevels; ++i) {
+            snapshot.bids_[i] = DepthLevel{0.0, 0.0};
+            snapshot.asks_[i] = DepthLevel{0.0, 0.0};
+        }
+
+        const char *pos = line_.data();
+        const char *end = line_.data() + line_.size();
+        bool malformed = false;
+        for (std::size_t c = 0; c < columns_.size() && pos <= end; ++c) {
+            const char *comma = pos;
+            while (comma < end && *comma != ',') ++comma;
+            const Column &column = columns_[c];
+            if (column.field_ != Field::Ignore && comma > pos) {
+                std::from_chars_result result{};
+                double value = 0.0;
+                switch (column.field_) {
+                case Field::Timestamp:
+                    result = std::from_chars(pos, comma,
+                                             snapshot.exch_timestamp_);
+                    break;
+                case Field::LocalTimestamp:
+                    result = std::from_chars(pos, comma,
+                                             snapshot.local_timestamp_);
+                    break;
+                default:
+                    result = std::from_chars(pos, comma, value);
+                    break;
+                }
+                if (result.ec != std::errc()) malformed = true;
+                switch (column.field_) {
+                case Field::AskPrice:
+                    snapshot.asks_[column.level_].price_ = value;
+                    break;
+                case Field::AskAmount:
+                    snapshot.asks_[column.level_].quantity_ = value;
+                    break;
+                case Field::BidPrice:
+                    snapshot.bids_[column.level_].price_ = value;
+                    break;
+                case Field::BidAmount:
+                    snapshot.bids_[column.level_].quantity_ = value;
+                    break;
+                default:
+                    break;
+                }
+            }
+            pos = comma + 1;
+        }
+        if (malformed) {
+            std::cerr << "Warning: Skipped malformed snapshot row\n";
+            continue;
+        }
+        if (!has_local_timestamp_) {
+            snapshot.local_timestamp_ =
+                snapshot.exch_timestamp_ + market_feed_latency_us_;
+        }
+        snapshot.bid_count_ = 0;
+        while (snapshot.bid_count_ < kSnapshotLevels &&
+               snapshot.bids_[snapshot.bid_count_].price_ > 0.0) {
+            ++snapshot.bid_count_;
+        }
+        snapshot.ask_count_ = 0;
+        while (snapshot.ask_count_ < kSnapshotLevels &&
+               snapshot.asks_[snapshot.ask_count_].price_ > 0.0) {
+            ++snapshot.ask_count_;
+        }
+        return true;
+    }
+    return false;
+}
+} // namespace core::market_data
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../market_data/depth_snapshot.h"
+#include "../../types/aliases/usings.h"
+#include "base_stream_reader.h"
+
+namespace core::market_data {
+/**
+ * @brief Reads top-N book snapshots from CSV.
+ *
+ * Expected columns (Tardis `book_snapshot_25` layout): timestamp,
+ * local_timestamp (optional), and for each level i `asks[i].price`,
+ * `asks[i].amount`, `bids[i].price`, `bids[i].amount`. Files with fewer than
+ * 25 levels per side (e.g. `book_snapshot_5`) are accepted; levels beyond
+ * kSnapshotLevels are ignored.
+ */
+class SnapshotStreamReader : public BaseStreamReader {
+  public:
+    SnapshotStreamReader();
+    explicit SnapshotStreamReader(const std::string &filename);
+
+    void open(const std::string &filename) override;
+    bool parse_next(core::market_data::DepthSnapshot &snapshot);
+
+  private:
+    // the row is far wider than the shared six-column reader, so lines are
+    // split by hand and each column is routed by its precomputed role
+    enum class Field : std::uint8_t {
+        Ignore,
+        Timestamp,
+        LocalTimestamp,
+        AskPrice,
+        AskAmount,
+        BidPrice,
+        BidAmount
+    };
+    struct Column {
+        Field field_ = Field::Ignore;
+        std::uint8_t level_ = 0;
+    };
+
+    std::ifstream file_;
+    std::string line_;
+    std::vector<Column> columns_;
+};
+} // namespace core::market_data
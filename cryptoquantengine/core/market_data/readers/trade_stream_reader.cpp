@@ -27,11 +27,63 @@ TradeStreamReader::TradeStreamReader(const std::string &filename) {
 }
 
 void TradeStreamReader::open(const std::string &filename) {
+    open(filename, 0);
+}
+
+/**
+ * @brief Opens the file to resume from the row starting at byte @p offset
+ * (0 = the first row).
+ */
+void TradeStreamReader::open(const std::string &filename,
+                             std::uint64_t offset) {
     std::vector<std::string> cols = {"timestamp", "local_timestamp", "id",
                                      "side",      "price",           "amount"};
-    init_csv_reader(filename, cols);
+    init_csv_reader(filename, cols, offset);
+    pending_trade_.reset();
 }
+
+/**
+ * @brief Parses the next trade from the CSV file.
+ *
+ * When trade aggregation is enabled, consecutive rows that share the same
+ * exchange timestamp, side and price are merged into a single trade whose
+ * quantity is the sum of the rows. The id and local timestamp of the first row
+ * are kept. A resting order can fill at most min(trade qty, remaining qty) on
+ * each trade, so the merged trade produces the same filled quantity as the
+ * individual rows would have.
+ *
+ * @param trade The trade to populate.
+ * @return true if a trade was parsed, false at end of file.
+ */
 bool TradeStreamReader::parse_next(core::market_data::Trade &trade) {
+    if (!aggregate_trades_) return read_next(trade);
+    if (pending_trade_.has_value()) {
+        trade = *pending_trade_;
+        pending_trade_.reset();
+    } else if (!read_next(trade)) {
+        return false;
+    }
+    Trade next;
+    while (read_next(next)) {
+        if (next.exch_timestamp_ != trade.exch_timestamp_ ||
+            next.side_ != trade.side_ || next.price_ != trade.price_) {
+            pending_trade_ = next;
+            break;
+        }
+        trade.quantity_ += next.quantity_;
+    }
+    return true;
+}
+
+/**
+ * @brief Enables or disables merging of same-timestamp, same-side, same-price
+ * trades.
+ */
+void TradeStreamReader::set_aggregate_trades(bool aggregate) {
+    aggregate_trades_ = aggregate;
+}
+
+bool TradeStreamReader::read_next(core::market_data::Trade &trade) {
     if (!csv_reader_) return false;
     try {
         Timestamp exch_timestamp = 0;
@@ -46,7 +98,7 @@ bool TradeStreamReader::parse_next(core::market_data::Trade &trade) {
         }
         if (side_str.empty()) {
             std::cerr << "Warning: Skipped row with missing required fields\n";
-            return parse_next(trade);
+            return read_next(trade);
         }
         if (!has_local_timestamp_) {
             local_timestamp = exch_timestamp + market_feed_latency_us_;
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -25,6 +27,14 @@ class TradeStreamReader : public BaseStreamReader {
     explicit TradeStreamReader(const std::string &filename);
 
     void open(const std::string &filename) override;
+    void open(const std::string &filename, std::uint64_t offset);
     bool parse_next(core::market_data::Trade &trade);
+    void set_aggregate_trades(bool aggregate);
+
+  private:
+    bool read_next(core::market_data::Trade &trade);
+
+    bool aggregate_trades_ = false;
+    std::optional<core::market_data::Trade> pending_trade_;
 };
 } // namespace core::market_data
\ No newline at end of file
@@ -8,10 +8,14 @@
 #include <curl/curl.h>
 #include <iostream>
 #include <json/json.hpp>
+#include <utility>
+#include <vector>
 
 #include "../../../../utils/http/http_utils.h"
+#include "../../../../utils/thread/thread_placement.h"
 #include "../../../types/enums/update_type.h"
 #include "../../book_update.h"
+#include "../../quote.h"
 #include "../../trade.h"
 #include "binance_stream_reader.h"
 
@@ -19,15 +23,17 @@ namespace core::market_data {
 
 BinanceStreamReader::BinanceStreamReader() = default;
 
-BinanceStreamReader::BinanceStreamReader(const std::string &ws_uri,
-                                         const std::string &rest_uri,
-                                         const std::string &book_csv,
-                                         const std::string &trade_csv,
-                                         bool enable_csv_writer)
-    : enable_csv_writer_(enable_csv_writer) {
+BinanceStreamReader::BinanceStreamReader(
+    const std::string &ws_uri, const std::string &rest_uri,
+    const std::string &book_csv, const std::string &trade_csv,
+    bool enable_csv_writer, std::shared_ptr<live::LiveBookPublisher> publisher,
+    const std::string &quote_csv)
+    : enable_csv_writer_(enable_csv_writer), publisher_(std::move(publisher)) {
     std::cout << "[BinanceStreamReader] Constructor called" << std::endl;
     book_csv_.open(book_csv, std::ios::out | std::ios::app);
     trade_csv_.open(trade_csv, std::ios::out | std::ios::app);
+    if (!quote_csv.empty())
+        quote_csv_.open(quote_csv, std::ios::out | std::ios::app);
     open(ws_uri);
     running_ = true;
     if (enable_csv_writer) {
@@ -46,6 +52,7 @@ BinanceStreamReader::~BinanceStreamReader() {
     if (rest_thread_.joinable()) rest_thread_.join();
     if (book_csv_.is_open()) book_csv_.close();
     if (trade_csv_.is_open()) trade_csv_.close();
+    if (quote_csv_.is_open()) quote_csv_.close();
 }
 
 void BinanceStreamReader::open(const std::string &uri) {
@@ -66,6 +73,12 @@ void BinanceStreamReader::open(const std::string &uri) {
         trade_csv_ << "timestamp,local_timestamp,id,side,price,amount\n";
         trade_header_written_ = true;
     }
+    if (quote_csv_.is_open() && !quote_header_written_) {
+        // read back by QuoteStreamReader
+        quote_csv_ << "timestamp,local_timestamp,ask_amount,ask_price,"
+                      "bid_price,bid_amount\n";
+        quote_header_written_ = true;
+    }
 }
 
 /*
@@ -84,6 +97,10 @@ void BinanceStreamReader::on_message(const std::string &msg) {
                     handle_book_message(data);
                 } else if (event_type == "trade") {
                     handle_trade_message(data);
+                } else if (event_type == "aggTrade") {
+                    handle_agg_trade_message(data);
+                } else if (event_type == "bookTicker") {
+                    handle_book_ticker_message(data);
                 }
             }
         }
@@ -143,6 +160,7 @@ void BinanceStreamReader::handle_book_message(const nlohmann::json &j) {
     update.exch_timestamp_ = 1000 * j.value("T", static_cast<std::uint64_t>(0));
     update.local_timestamp_ =
         1000 * j.value("E", static_cast<std::uint64_t>(0));
+    depth_diff_.updates_.clear();
     if (j.contains("b") && !j["b"].empty()) {
         for (const auto &bid : j["b"]) {
             update.side_ = BookSide::Bid;
@@ -151,6 +169,7 @@ void BinanceStreamReader::handle_book_message(const nlohmann::json &j) {
             update.update_type_ = UpdateType::Incremental;
             book_queue_.push(update);
             book_cv_.notify_one();
+            if (publisher_) depth_diff_.updates_.push_back(update);
         }
     }
     if (j.contains("a") && !j["a"].empty()) {
@@ -161,8 +180,18 @@ void BinanceStreamReader::handle_book_message(const nlohmann::json &j) {
             update.update_type_ = UpdateType::Incremental;
             book_queue_.push(update);
             book_cv_.notify_one();
+            if (publisher_) depth_diff_.updates_.push_back(update);
         }
     }
+    if (publisher_) {
+        depth_diff_.first_update_id_ =
+            j.value("U", static_cast<std::uint64_t>(0));
+        depth_diff_.final_update_id_ =
+            j.value("u", static_cast<std::uint64_t>(0));
+        depth_diff_.prev_final_update_id_ =
+            j.value("pu", static_cast<std::uint64_t>(0));
+        publisher_->publish_diff(depth_diff_);
+    }
 }
 
 void BinanceStreamReader::handle_trade_message(const nlohmann::json &j) {
@@ -183,8 +212,56 @@ void BinanceStreamReader::handle_trade_message(const nlohmann::json &j) {
     trade.orderId_ = j.value("t", static_cast<std::uint64_t>(0));
     trade.price_ = std::stod(j.value("p", "0"));
     trade.quantity_ = std::stod(j.value("q", "0"));
-    trade.side_ = j.value("m", false) ? TradeSide::Buy : TradeSide::Sell;
+    trade.side_ = j.value("m", false) ? TradeSide::Sell : TradeSide::Buy;
+    trade_queue_.push(trade);
+    if (publisher_) publisher_->publish_trade(trade);
+}
+
+void BinanceStreamReader::handle_agg_trade_message(const nlohmann::json &j) {
+    /*{
+      "e": "aggTrade",
+      "E": 1756922507818,
+      "a": 52736512,
+      "s": "XRPUSDC",
+      "p": "2.8667",
+      "q": "186.0",
+      "f": 117581739,
+      "l": 117581752,
+      "T": 1756922507818,
+      "m": false
+    }*/
+    Trade trade;
+    trade.exch_timestamp_ = 1000 * j.value("T", static_cast<std::uint64_t>(0));
+    trade.local_timestamp_ = 1000 * j.value("E", static_cast<std::uint64_t>(0));
+    trade.orderId_ = j.value("a", static_cast<std::uint64_t>(0));
+    trade.price_ = std::stod(j.value("p", "0"));
+    trade.quantity_ = std::stod(j.value("q", "0"));
+    trade.side_ = j.value("m", false) ? TradeSide::Sell : TradeSide::Buy;
     trade_queue_.push(trade);
+    if (publisher_) publisher_->publish_trade(trade);
+}
+
+void BinanceStreamReader::handle_book_ticker_message(const nlohmann::json &j) {
+    /*{
+      "e": "bookTicker",
+      "u": 400900217,
+      "E": 1568014460893,
+      "T": 1568014460891,
+      "s": "BNBUSDT",
+      "b": "25.35190000",
+      "B": "31.21000000",
+      "a": "25.36520000",
+      "A": "40.66000000"
+    }*/
+    Quote quote;
+    quote.exch_timestamp_ = 1000 * j.value("T", static_cast<std::uint64_t>(0));
+    quote.local_timestamp_ = 1000 * j.value("E", static_cast<std::uint64_t>(0));
+    quote.bid_price_ = std::stod(j.value("b", "0"));
+    quote.bid_quantity_ = std::stod(j.value("B", "0"));
+    quote.ask_price_ = std::stod(j.value("a", "0"));
+    quote.ask_quantity_ = std::stod(j.value("A", "0"));
+    quote_queue_.push(quote);
+    book_cv_.notify_one();
 }
 
 bool BinanceStreamReader::parse_next_book(BookUpdate &update) {
@@ -203,7 +280,17 @@ bool BinanceStreamReader::parse_next_trade(Trade &trade) {
     return true;
 }
 
+bool BinanceStreamReader::parse_next_quote(Quote &quote) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (quote_queue_.empty()) return false;
+    quote = quote_queue_.front();
+    quote_queue_.pop();
+    return true;
+}
+
 void BinanceStreamReader::poll_rest_snapshots(const std::string &rest_uri) {
+    utils::thread::place_current_thread(utils::thread::ThreadRole::WsIo,
+                                        "ws-rest");
     /*
     {"lastUpdateId":8509976781069,"E":1756951185683,"T":1756951185662,"bids":[["2.8401","14252.6"],["2.8400","32721.6"],["2.8399","11071.3"],["2.8398","22734.2"],["2.8397","25936.4"]],"asks":[["2.8402","4860.5"],["2.8403","30948.3"],["2.8404","12429.9"],["2.8405","2258.8"],["2.8406","8144.3"]]}
     */
@@ -215,6 +302,7 @@ void BinanceStreamReader::poll_rest_snapshots(const std::string &rest_uri) {
                 std::chrono::duration_cast<std::chrono::microseconds>(
                     std::chrono::system_clock::now().time_since_epoch())
                     .count();
+            std::vector<BookUpdate> rows; // for publisher_
             {
                 // std::lock_guard<std::mutex> lock(queue_mutex_);
                 if (snapshot.contains("bids")) {
@@ -233,6 +321,7 @@ void BinanceStreamReader::poll_rest_snapshots(const std::string &rest_uri) {
                         update.quantity_ = std::stod(bid[1].get<std::string>());
                         book_queue_.push(update);
                         book_cv_.notify_one();
+                        if (publisher_) rows.push_back(update);
                     }
                 }
                 if (snapshot.contains("asks")) {
@@ -250,9 +339,15 @@ void BinanceStreamReader::poll_rest_snapshots(const std::string &rest_uri) {
                         update.quantity_ = std::stod(ask[1].get<std::string>());
                         book_queue_.push(update);
                         book_cv_.notify_one();
+                        if (publisher_) rows.push_back(update);
                     }
                 }
             }
+            if (publisher_) {
+                publisher_->publish_snapshot(
+                    rows, snapshot.value("lastUpdateId",
+                                         static_cast<std::uint64_t>(0)));
+            }
             std::cout << "[BinanceStreamReader] Snapshot pushed at " << now
                       << std::endl;
 
@@ -263,14 +358,24 @@ void BinanceStreamReader::poll_rest_snapshots(const std::string &rest_uri) {
             std::cerr << "[BinanceStreamReader] Snapshot loop unknown error"
                       << std::endl;
         }
-        for (int i = 0; i < 1; ++i) {
-            if (!running_) break;
-            std::this_thread::sleep_for(std::chrono::minutes(1));
+        // a minute between snapshots, or a second when the live book is
+        // waiting for one (depth requests are rate limited)
+        const auto start = std::chrono::steady_clock::now();
+        while (running_) {
+            const auto waited = std::chrono::steady_clock::now() - start;
+            if (waited >= std::chrono::minutes(1)) break;
+            if (waited >= std::chrono::seconds(1) && publisher_ &&
+                publisher_->needs_snapshot()) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     }
 }
 
 void BinanceStreamReader::csv_write_loop() {
+    utils::thread::place_current_thread(utils::thread::ThreadRole::Writer,
+                                        "csv-writer");
     try {
         std::cout << "[BinanceStreamReader] csv_write_loop started"
                   << std::endl;
@@ -278,7 +383,7 @@ void BinanceStreamReader::csv_write_loop() {
         while (running_) {
             book_cv_.wait(lock, [this] {
                 return !book_queue_.empty() || !trade_queue_.empty() ||
-                       !running_;
+                       !quote_queue_.empty() || !running_;
             });
             while (!book_queue_.empty()) {
                 const BookUpdate &update = book_queue_.front();
@@ -309,6 +414,18 @@ void BinanceStreamReader::csv_write_loop() {
                 }
                 trade_queue_.pop();
             }
+
+            while (!quote_queue_.empty()) {
+                const Quote &quote = quote_queue_.front();
+                if (quote_csv_.is_open()) {
+                    quote_csv_ << quote.exch_timestamp_ << ","
+                               << quote.local_timestamp_ << ","
+                               << quote.ask_quantity_ << "," << quote.ask_price_
+                               << "," << quote.bid_price_ << ","
+                               << quote.bid_quantity_ << "\n";
+                }
+                quote_queue_.pop();
+            }
         }
     } catch (const std::exception &e) {
         std::cerr << "[BinanceStreamReader] CSV write loop error: " << e.what()
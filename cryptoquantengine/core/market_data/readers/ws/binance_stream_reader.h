@@ -9,6 +9,8 @@
 
 #include "../../../types/aliases/usings.h"
 #include "../../book_update.h"
+#include "../../live/live_book_publisher.h"
+#include "../../quote.h"
 #include "../../trade.h"
 #include "websocket_stream_reader.h"
 #include <chrono>
@@ -18,6 +20,7 @@
 #include <mutex>
 #include <queue>
 #include <string>
+#include <vector>
 
 namespace core::market_data {
 
@@ -29,12 +32,16 @@ class BinanceStreamReader : public BaseWebSocketStreamReader {
                                  const std::string &rest_uri,
                                  const std::string &book_csv,
                                  const std::string &trade_csv,
-                                 bool enable_csv_writer);
+                                 bool enable_csv_writer,
+                                 std::shared_ptr<live::LiveBookPublisher>
+                                     publisher = nullptr,
+                                 const std::string &quote_csv = "");
 
     void open(const std::string &uri) override;
 
     bool parse_next_book(BookUpdate &update);
     bool parse_next_trade(Trade &trade);
+    bool parse_next_quote(Quote &quote);
 
   protected:
     void on_message(const std::string &msg) override;
@@ -42,6 +49,7 @@ class BinanceStreamReader : public BaseWebSocketStreamReader {
   private:
     std::queue<BookUpdate> book_queue_;
     std::queue<Trade> trade_queue_;
+    std::queue<Quote> quote_queue_;
     std::mutex queue_mutex_;
     std::mutex write_queue_mutex_;
     std::condition_variable book_cv_, trade_cv_;
@@ -51,11 +59,19 @@ class BinanceStreamReader : public BaseWebSocketStreamReader {
 
     std::ofstream book_csv_;
     std::ofstream trade_csv_;
+    std::ofstream quote_csv_; // bookTicker rows in the quotes layout
     bool book_header_written_ = false;
     bool trade_header_written_ = false;
+    bool quote_header_written_ = false;
+
+    // optional: keeps a live book in shared memory for local readers
+    std::shared_ptr<live::LiveBookPublisher> publisher_;
+    live::DepthDiff depth_diff_; // one depth message, for publisher_
 
     void handle_book_message(const nlohmann::json &j);
     void handle_trade_message(const nlohmann::json &j);
+    void handle_agg_trade_message(const nlohmann::json &j);
+    void handle_book_ticker_message(const nlohmann::json &j);
     void poll_rest_snapshots(const std::string &rest_uri);
     void csv_write_loop();
 };
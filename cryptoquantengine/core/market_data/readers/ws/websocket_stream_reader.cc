@@ -11,6 +11,8 @@
 #include <websocketpp/common/thread.hpp>
 #include <websocketpp/config/asio_client.hpp>
 
+#include "../../../../utils/thread/thread_placement.h"
+
 namespace core::market_data {
 
 BaseWebSocketStreamReader::BaseWebSocketStreamReader() = default;
@@ -88,7 +90,11 @@ void BaseWebSocketStreamReader::connect(const std::string &uri) {
         return;
     }
     ws_client_->connect(con);
-    ws_thread_ = std::thread([this] { ws_client_->run(); });
+    ws_thread_ = std::thread([this] {
+        utils::thread::place_current_thread(utils::thread::ThreadRole::WsIo,
+                                            "ws-io");
+        ws_client_->run();
+    });
     processing_thread_ =
         std::thread(&BaseWebSocketStreamReader::process_queue, this);
 }
@@ -121,6 +127,8 @@ void BaseWebSocketStreamReader::disconnect() {
 }
 
 void BaseWebSocketStreamReader::process_queue() {
+    utils::thread::place_current_thread(utils::thread::ThreadRole::Parser,
+                                        "ws-parser");
     try {
         while (running_) {
             std::string msg;
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../utils/thread/task_pool.h"
+#include "../types/aliases/usings.h"
+#include "../types/enums/book_side.h"
+#include "readers/book_stream_reader.h"
+#include "tape_validator.h"
+
+namespace core::market_data {
+namespace {
+struct Columns {
+    int timestamp_ = -1;
+    int local_timestamp_ = -1; // optional
+    int is_snapshot_ = -1;
+    int side_ = -1;
+    int price_ = -1;
+    int amount_ = -1;
+};
+
+enum class RowStatus : std::uint8_t {
+    Ok,
+    Malformed,
+    NonPositivePrice,
+    NegativeQuantity
+};
+
+struct Row {
+    RowStatus status_ = RowStatus::Malformed;
+    Timestamp exch_timestamp_ = 0;
+    Timestamp local_timestamp_ = 0;
+    bool is_snapshot_ = false;
+    BookSide side_ = BookSide::Bid;
+    Price price_ = 0.0;
+    Quantity quantity_ = 0.0;
+    // written back verbatim so cleaning never reformats a number
+    std::string_view price_text_;
+    std::string_view amount_text_;
+};
+
+std::vector<std::string_view> split(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    std::vector<std::string_view> fields;
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t comma = line.find(',', start);
+        fields.push_back(line.substr(start, comma - start));
+        if (comma == std::string_view::npos) break;
+        start = comma + 1;
+    }
+    return fields;
+}
+
+Columns parse_header(const std::string &header) {
+    Columns columns;
+    const auto names = split(header);
+    for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+        if (names[i] == "timestamp") columns.timestamp_ = i;
+        if (names[i] == "local_timestamp") columns.local_timestamp_ = i;
+        if (names[i] == "is_snapshot") columns.is_snapshot_ = i;
+        if (names[i] == "side") columns.side_ = i;
+        if (names[i] == "price") columns.price_ = i;
+        if (names[i] == "amount") columns.amount_ = i;
+    }
+    if (columns.timestamp_ < 0 || columns.is_snapshot_ < 0 ||
+        columns.side_ < 0 || columns.price_ < 0 || columns.amount_ < 0) {
+        throw std::runtime_error("Book tape header lacks a required column: " +
+                                 header);
+    }
+    return columns;
+}
+
+template <typename T> bool parse_number(std::string_view text, T &value) {
+    const auto result =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+Row parse_row(std::string_view line, const Columns &columns) {
+    Row row;
+    const auto fields = split(line);
+    auto field = [&](int index) -> std::string_view {
+        return index >= 0 && index < static_cast<int>(fields.size())
+                   ? fields[index]
+                   : std::string_view{};
+    };
+    const auto side = field(columns.side_);
+    const auto snapshot = field(columns.is_snapshot_);
+    row.price_text_ = field(columns.price_);
+    row.amount_text_ = field(columns.amount_);
+    if (!parse_number(field(columns.timestamp_), row.exch_timestamp_) ||
+        (columns.local_timestamp_ >= 0 &&
+         !parse_number(field(columns.local_timestamp_),
+                       row.local_timestamp_)) ||
+        !parse_number(row.price_text_, row.price_) ||
+        !parse_number(row.amount_text_, row.quantity_) ||
+        (side != "bid" && side != "ask") ||
+        (snapshot != "true" && snapshot != "false")) {
+        return row;
+    }
+    row.side_ = side == "bid" ? BookSide::Bid : BookSide::Ask;
+    row.is_snapshot_ = snapshot == "true";
+    row.status_ = row.price_ <= 0.0       ? RowStatus::NonPositivePrice
+                  : row.quantity_ < 0.0   ? RowStatus::NegativeQuantity
+                                          : RowStatus::Ok;
+    return row;
+}
+
+// price levels with their last update time, to spot stale crossing levels
+struct Level {
+    Quantity quantity_;
+    Timestamp updated_;
+    std::string price_text_;
+};
+
+class CrossCheckBook {
+  public:
+    void apply(const Row &row) {
+        if (row.is_snapshot_ && !last_snapshot_) {
+            bids_.clear();
+            asks_.clear();
+        }
+        last_snapshot_ = row.is_snapshot_;
+        if (row.side_ == BookSide::Bid) {
+            update(bids_, row);
+        } else {
+            update(asks_, row);
+        }
+    }
+
+    bool crossed() const {
+        return !bids_.empty() && !asks_.empty() &&
+               bids_.begin()->first >= asks_.begin()->first;
+    }
+
+    // deletes the staler of the two touching levels; returns a deletion row
+    // for the cleaned tape
+    std::string remove_stale(Timestamp exch_timestamp,
+                             Timestamp local_timestamp, bool has_local) {
+        const bool bid_stale =
+            bids_.begin()->second.updated_ <= asks_.begin()->second.updated_;
+        std::string line = std::to_string(exch_timestamp) + ',';
+        if (has_local) line += std::to_string(local_timestamp) + ',';
+        if (bid_stale) {
+            line += "false,bid," + bids_.begin()->second.price_text_ + ",0\n";
+            bids_.erase(bids_.begin());
+        } else {
+            line += "false,ask," + asks_.begin()->second.price_text_ + ",0\n";
+            asks_.erase(asks_.begin());
+        }
+        return line;
+    }
+
+  private:
+    template <typename Book> void update(Book &book, const Row &row) {
+        if (row.quantity_ == 0.0) {
+            book.erase(row.price_);
+        } else {
+            book[row.price_] = Level{row.quantity_, row.exch_timestamp_,
+                                     std::string(row.price_text_)};
+        }
+    }
+
+    std::map<Price, Level, std::greater<>> bids_;
+    std::map<Price, Level> asks_;
+    bool last_snapshot_ = true;
+};
+
+bool same_row(const Row &a, const Row &b) {
+    return a.exch_timestamp_ == b.exch_timestamp_ &&
+           a.local_timestamp_ == b.local_timestamp_ &&
+           a.is_snapshot_ == b.is_snapshot_ && a.side_ == b.side_ &&
+           a.price_ == b.price_ && a.quantity_ == b.quantity_;
+}
+} // namespace
+
+/**
+ * @brief One-time validation and cleaning pass over a book update CSV.
+ *
+ * Rows are parsed and checked in parallel by chunk; timestamp order,
+ * duplicates and crossed books are then checked in file order. Rows that
+ * cannot be used are dropped, out-of-order timestamps are raised to the
+ * previous row's, and a book crossed for crossed_batches_ consecutive batches
+ * has its staler touching levels deleted. The cleaned tape is written to
+ * @p output_file with a `.verified` side-car recording its size, which
+ * BookStreamReader::is_verified checks before trusting the tape.
+ *
+ * @throws std::runtime_error if a file cannot be opened or written, or the
+ * header lacks a required column.
+ */
+TapeValidationReport validate_book_tape(const std::string &input_file,
+                                        const std::string &output_file,
+                                        const TapeValidationConfig &config) {
+    std::ifstream in(input_file, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open book tape: " + input_file);
+    }
+    std::ofstream out(output_file, std::ios::binary);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open output tape: " + output_file);
+    }
+    std::string header;
+    std::getline(in, header);
+    const Columns columns = parse_header(header);
+    const bool has_local = columns.local_timestamp_ >= 0;
+    out << (has_local ? "timestamp,local_timestamp,is_snapshot,side,price,"
+                        "amount\n"
+                      : "timestamp,is_snapshot,side,price,amount\n");
+
+    const std::size_t tasks =
+        config.threads_ > 0 ? config.threads_
+                            : utils::thread::TaskPool::instance().size() + 1;
+    TapeValidationReport report;
+    CrossCheckBook book;
+    std::optional<Row> last;
+    Timestamp batch_exch = 0, batch_local = 0;
+    int crossed_run = 0;
+
+    auto end_batch = [&] {
+        if (!book.crossed()) {
+            crossed_run = 0;
+            return;
+        }
+        if (++crossed_run < config.crossed_batches_) return;
+        while (book.crossed()) {
+            out << book.remove_stale(batch_exch, batch_local, has_local);
+            ++report.crossed_repairs_;
+            ++report.rows_out_;
+        }
+        crossed_run = 0;
+    };
+
+    std::vector<std::string> lines;
+    std::vector<Row> rows;
+    while (in) {
+        // read one chunk sequentially, then parse it in parallel
+        lines.clear();
+        std::string line;
+        while (lines.size() < config.chunk_rows_ && std::getline(in, line)) {
+            if (!line.empty() && line != "\r") lines.push_back(std::move(line));
+        }
+        if (lines.empty()) break;
+        rows.assign(lines.size(), Row{});
+        const std::size_t per_task = (lines.size() + tasks - 1) / tasks;
+        utils::thread::parallel_for(
+            0, lines.size(),
+            [&](std::size_t i) { rows[i] = parse_row(lines[i], columns); },
+            utils::thread::TaskPriority::Normal, per_task);
+
+        // order-dependent checks, in file order
+        for (Row &row : rows) {
+            ++report.rows_in_;
+            if (row.status_ == RowStatus::Malformed) {
+                ++report.malformed_;
+                continue;
+            }
+            if (row.status_ == RowStatus::NonPositivePrice) {
+                ++report.non_positive_price_;
+                continue;
+            }
+            if (row.status_ == RowStatus::NegativeQuantity) {
+                ++report.negative_quantity_;
+                continue;
+            }
+            if (!has_local) row.local_timestamp_ = row.exch_timestamp_;
+            if (last && (row.exch_timestamp_ < last->exch_timestamp_ ||
+                         row.local_timestamp_ < last->local_timestamp_)) {
+                ++report.out_of_order_;
+                row.exch_timestamp_ =
+                    std::max(row.exch_timestamp_, last->exch_timestamp_);
+                row.local_timestamp_ =
+                    std::max(row.local_timestamp_, last->local_timestamp_);
+            }
+            if (last && same_row(row, *last)) {
+                ++report.duplicates_;
+                continue;
+            }
+            if (last && (row.exch_timestamp_ != batch_exch ||
+                         row.local_timestamp_ != batch_local)) {
+                end_batch();
+            }
+            batch_exch = row.exch_timestamp_;
+            batch_local = row.local_timestamp_;
+            book.apply(row);
+            out << row.exch_timestamp_ << ',';
+            if (has_local) out << row.local_timestamp_ << ',';
+            out << (row.is_snapshot_ ? "true," : "false,")
+                << (row.side_ == BookSide::Bid ? "bid," : "ask,")
+                << row.price_text_ << ',' << row.amount_text_ << '\n';
+            ++report.rows_out_;
+            last = row;
+        }
+        // rows view the chunk's lines, which the next chunk replaces
+        if (last) {
+            last->price_text_ = {};
+            last->amount_text_ = {};
+        }
+    }
+    if (last) end_batch();
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write output tape: " +
+                                 output_file);
+    }
+
+    std::ofstream marker(BookStreamReader::verified_marker(output_file));
+    marker << "bytes=" << std::filesystem::file_size(output_file) << '\n'
+           << "rows=" << report.rows_out_ << '\n'
+           << "source=" << input_file << '\n';
+    return report;
+}
+} // namespace core::market_data
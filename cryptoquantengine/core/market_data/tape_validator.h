@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace core::market_data {
+struct TapeValidationConfig {
+    unsigned threads_ = 0;             // parse tasks per chunk (0 = pool size)
+    std::size_t chunk_rows_ = 1 << 18; // rows parsed per parallel chunk
+    // a book still crossed after this many consecutive batches is repaired
+    int crossed_batches_ = 3;
+};
+
+struct TapeValidationReport {
+    std::uint64_t rows_in_ = 0;
+    std::uint64_t rows_out_ = 0;
+    std::uint64_t malformed_ = 0;          // dropped: missing or bad fields
+    std::uint64_t non_positive_price_ = 0; // dropped
+    std::uint64_t negative_quantity_ = 0;  // dropped
+    std::uint64_t duplicates_ = 0;         // dropped: repeats of the last row
+    std::uint64_t out_of_order_ = 0;       // timestamps raised to the last one
+    std::uint64_t crossed_repairs_ = 0;    // stale crossing levels deleted
+};
+
+TapeValidationReport validate_book_tape(const std::string &input_file,
+                                        const std::string &output_file,
+                                        const TapeValidationConfig &config =
+                                            TapeValidationConfig{});
+} // namespace core::market_data
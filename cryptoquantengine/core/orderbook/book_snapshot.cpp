@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "../../utils/math/math_utils.h"
+#include "book_snapshot.h"
+
+namespace core::orderbook {
+/**
+ * @brief Sets the quantity of a level, removing it when @p quantity is 0.
+ *
+ * The page directory and the touched page are cloned first if they are
+ * shared with a snapshot, so snapshots never observe the write.
+ *
+ * @param price Level price in ticks.
+ * @param quantity New level quantity (0 = remove).
+ */
+void PagedLevels::set(Ticks price, Quantity quantity) {
+    const Ticks page_index = price >> kPageBits;
+    const int slot = static_cast<int>(price & (kPageSize - 1));
+
+    if (!directory_) {
+        if (quantity == 0.0) return;
+        directory_ = std::make_shared<Directory>();
+    }
+    auto find_page = [&]() {
+        return std::lower_bound(
+            directory_->begin(), directory_->end(), page_index,
+            [](const auto &entry, Ticks idx) { return entry.first < idx; });
+    };
+    auto it = find_page();
+    bool exists = it != directory_->end() && it->first == page_index;
+    if (!exists && quantity == 0.0) return;
+
+    if (directory_.use_count() > 1) {
+        directory_ = std::make_shared<Directory>(*directory_);
+        it = find_page();
+    }
+    if (!exists) {
+        it = directory_->emplace(it, page_index, std::make_shared<Page>());
+    } else if (it->second.use_count() > 1) {
+        it->second = std::make_shared<Page>(*it->second);
+    }
+
+    Page &page = *it->second;
+    const std::uint64_t bit = std::uint64_t{1} << slot;
+    if (quantity == 0.0) {
+        page.mask_ &= ~bit;
+        page.quantities_[slot] = 0.0;
+        if (page.mask_ == 0) directory_->erase(it);
+    } else {
+        page.mask_ |= bit;
+        page.quantities_[slot] = quantity;
+    }
+}
+
+/**
+ * @brief Returns the quantity at a level, or 0 if the level is absent.
+ */
+Quantity PagedLevels::get(Ticks price) const {
+    if (!directory_) return 0.0;
+    const Ticks page_index = price >> kPageBits;
+    auto it = std::lower_bound(
+        directory_->begin(), directory_->end(), page_index,
+        [](const auto &entry, Ticks idx) { return entry.first < idx; });
+    if (it == directory_->end() || it->first != page_index) return 0.0;
+    return it->second->quantities_[price & (kPageSize - 1)];
+}
+
+std::size_t PagedLevels::page_count() const {
+    return directory_ ? directory_->size() : 0;
+}
+
+/**
+ * @brief Appends every level whose quantity differs between two sides.
+ *
+ * Pages shared by both sides are skipped without being inspected, so the cost
+ * is proportional to the number of pages written between the two.
+ */
+void PagedLevels::diff(const PagedLevels &from, const PagedLevels &to,
+                       std::vector<LevelDelta> &out) {
+    static const Directory empty;
+    const Directory &a = from.directory_ ? *from.directory_ : empty;
+    const Directory &b = to.directory_ ? *to.directory_ : empty;
+    if (&a == &b) return;
+
+    auto emit_page = [&](Ticks page_index, const Page *pa, const Page *pb) {
+        std::uint64_t mask = (pa ? pa->mask_ : 0) | (pb ? pb->mask_ : 0);
+        while (mask != 0) {
+            int slot = std::countr_zero(mask);
+            mask &= mask - 1;
+            Quantity qa = pa ? pa->quantities_[slot] : 0.0;
+            Quantity qb = pb ? pb->quantities_[slot] : 0.0;
+            if (qa != qb) {
+                out.push_back(
+                    LevelDelta{(page_index << kPageBits) + slot, qa, qb});
+            }
+        }
+    };
+
+    std::size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j == b.size() || (i < a.size() && a[i].first < b[j].first)) {
+            emit_page(a[i].first, a[i].second.get(), nullptr);
+            ++i;
+        } else if (i == a.size() || b[j].first < a[i].first) {
+            emit_page(b[j].first, nullptr, b[j].second.get());
+            ++j;
+        } else {
+            if (a[i].second != b[j].second) {
+                emit_page(a[i].first, a[i].second.get(), b[j].second.get());
+            }
+            ++i;
+            ++j;
+        }
+    }
+}
+
+BookSnapshot::BookSnapshot(Timestamp timestamp, double tick_size,
+                           PagedLevels bids, PagedLevels asks)
+    : timestamp_(timestamp), tick_size_(tick_size), bids_(std::move(bids)),
+      asks_(std::move(asks)) {}
+
+/**
+ * @brief Returns the local time at which the snapshot was taken.
+ */
+Timestamp BookSnapshot::timestamp() const { return timestamp_; }
+
+Price BookSnapshot::best_bid() const {
+    return utils::math::ticks_to_price(price_at_level(BookSide::Bid, 0),
+                                       tick_size_);
+}
+
+Price BookSnapshot::best_ask() const {
+    return utils::math::ticks_to_price(price_at_level(BookSide::Ask, 0),
+                                       tick_size_);
+}
+
+/**
+ * @brief Returns the mid price, or 0.0 if either side is empty.
+ */
+Price BookSnapshot::mid_price() const {
+    Ticks bid = price_at_level(BookSide::Bid, 0);
+    Ticks ask = price_at_level(BookSide::Ask, 0);
+    if (bid == 0 || ask == 0) return 0.0;
+    return (utils::math::ticks_to_price(bid, tick_size_) +
+            utils::math::ticks_to_price(ask, tick_size_)) /
+           2.0;
+}
+
+Quantity BookSnapshot::depth_at(const BookSide side, const Ticks price) const {
+    return (side == BookSide::Bid) ? bids_.get(price) : asks_.get(price);
+}
+
+/**
+ * @brief Returns the quantity at a 0-based level, or 0 if out of range.
+ */
+Quantity BookSnapshot::depth_at_level(const BookSide side,
+                                      const int level) const {
+    if (level < 0) return 0.0;
+    Quantity result = 0.0;
+    int i = 0;
+    const PagedLevels &levels = (side == BookSide::Bid) ? bids_ : asks_;
+    levels.for_each(side == BookSide::Bid, [&](Ticks, Quantity qty) {
+        if (i++ < level) return true;
+        result = qty;
+        return false;
+    });
+    return result;
+}
+
+/**
+ * @brief Returns the price at a 0-based level, or 0 if out of range.
+ */
+Ticks BookSnapshot::price_at_level(const BookSide side, const int level) const {
+    if (level < 0) return 0;
+    Ticks result = 0;
+    int i = 0;
+    const PagedLevels &levels = (side == BookSide::Bid) ? bids_ : asks_;
+    levels.for_each(side == BookSide::Bid, [&](Ticks price, Quantity) {
+        if (i++ < level) return true;
+        result = price;
+        return false;
+    });
+    return result;
+}
+
+std::map<Ticks, Quantity, std::greater<>> BookSnapshot::bid_book() const {
+    std::map<Ticks, Quantity, std::greater<>> result;
+    bids_.for_each(true, [&](Ticks price, Quantity qty) {
+        result.emplace_hint(result.end(), price, qty);
+        return true;
+    });
+    return result;
+}
+
+std::map<Ticks, Quantity> BookSnapshot::ask_book() const {
+    std::map<Ticks, Quantity> result;
+    asks_.for_each(false, [&](Ticks price, Quantity qty) {
+        result.emplace_hint(result.end(), price, qty);
+        return true;
+    });
+    return result;
+}
+
+/**
+ * @brief Lists the levels that changed between two snapshots.
+ *
+ * Bids are listed before asks, each side in ascending price order. Cost is
+ * proportional to the number of pages written between the two snapshots.
+ *
+ * @param from The older snapshot.
+ * @param to The newer snapshot.
+ * @return One entry per level whose quantity differs.
+ */
+std::vector<LevelDiff> BookSnapshot::diff(const BookSnapshot &from,
+                                          const BookSnapshot &to) {
+    std::vector<LevelDiff> result;
+    std::vector<PagedLevels::LevelDelta> deltas;
+    PagedLevels::diff(from.bids_, to.bids_, deltas);
+    for (const auto &d : deltas) {
+        result.push_back(LevelDiff{BookSide::Bid, d.price_, d.from_quantity_,
+                                   d.to_quantity_});
+    }
+    deltas.clear();
+    PagedLevels::diff(from.asks_, to.asks_, deltas);
+    for (const auto &d : deltas) {
+        result.push_back(LevelDiff{BookSide::Ask, d.price_, d.from_quantity_,
+                                   d.to_quantity_});
+    }
+    return result;
+}
+} // namespace core::orderbook
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../types/aliases/usings.h"
+#include "../types/enums/book_side.h"
+
+namespace core::orderbook {
+/**
+ * @brief One side of a book stored as copy-on-write pages of 64 consecutive
+ * ticks.
+ *
+ * Copying a PagedLevels shares every page, so it costs O(1). The first write
+ * after a copy clones the page directory and then each page it touches, which
+ * leaves the copy untouched.
+ */
+class PagedLevels {
+  public:
+    static constexpr int kPageBits = 6;
+    static constexpr Ticks kPageSize = Ticks{1} << kPageBits;
+
+    void set(Ticks price, Quantity quantity);
+    Quantity get(Ticks price) const;
+    std::size_t page_count() const;
+
+    /**
+     * @brief Visits populated levels in ascending (or descending) price order.
+     * @param visit Called with (ticks, quantity); returning false stops.
+     */
+    template <typename Visitor>
+    void for_each(bool descending, Visitor &&visit) const {
+        if (!directory_) return;
+        const auto &dir = *directory_;
+        for (std::size_t n = 0; n < dir.size(); ++n) {
+            const auto &[page_index, page] =
+                descending ? dir[dir.size() - 1 - n] : dir[n];
+            std::uint64_t mask = page->mask_;
+            while (mask != 0) {
+                int slot = descending ? 63 - std::countl_zero(mask)
+                                      : std::countr_zero(mask);
+                mask &= ~(std::uint64_t{1} << slot);
+                if (!visit((page_index << kPageBits) + slot,
+                           page->quantities_[slot]))
+                    return;
+            }
+        }
+    }
+
+    struct LevelDelta {
+        Ticks price_;
+        Quantity from_quantity_;
+        Quantity to_quantity_;
+    };
+    static void diff(const PagedLevels &from, const PagedLevels &to,
+                     std::vector<LevelDelta> &out);
+
+  private:
+    struct Page {
+        std::uint64_t mask_ = 0; // bit i set = slot i populated
+        std::array<Quantity, kPageSize> quantities_{};
+    };
+    using Directory = std::vector<std::pair<Ticks, std::shared_ptr<Page>>>;
+
+    std::shared_ptr<Directory> directory_;
+};
+
+struct LevelDiff {
+    BookSide side_;
+    Ticks price_;
+    Quantity from_quantity_; // 0 = level absent in the older snapshot
+    Quantity to_quantity_;   // 0 = level absent in the newer snapshot
+};
+
+/**
+ * @brief Immutable view of an order book at one point in time.
+ *
+ * Snapshots share their storage with the book they were taken from and with
+ * each other, so taking and keeping them is cheap; diffing two snapshots only
+ * inspects pages that differ.
+ */
+class BookSnapshot {
+  public:
+    BookSnapshot() = default;
+    BookSnapshot(Timestamp timestamp, double tick_size, PagedLevels bids,
+                 PagedLevels asks);
+
+    Timestamp timestamp() const;
+
+    Price best_bid() const;
+    Price best_ask() const;
+    Price mid_price() const;
+
+    Quantity depth_at(const BookSide side, const Ticks price) const;
+    Quantity depth_at_level(const BookSide side, const int level) const;
+    Ticks price_at_level(const BookSide side, const int level) const;
+
+    std::map<Ticks, Quantity, std::greater<>> bid_book() const;
+    std::map<Ticks, Quantity> ask_book() const;
+
+    static std::vector<LevelDiff> diff(const BookSnapshot &from,
+                                       const BookSnapshot &to);
+
+  private:
+    Timestamp timestamp_ = 0;
+    double tick_size_ = 1.0;
+    PagedLevels bids_;
+    PagedLevels asks_;
+};
+} // namespace core::orderbook
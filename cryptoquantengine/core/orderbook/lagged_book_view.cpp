@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <map>
+
+#include "../../utils/math/math_utils.h"
+#include "lagged_book_view.h"
+#include "orderbook.h"
+
+namespace core::orderbook {
+namespace {
+/**
+ * @brief Walks the locally visible levels of one side in price priority,
+ * merging the source book with the overlay of lagged levels.
+ *
+ * @param visit Called with (ticks, quantity) per visible level; returning
+ * false stops the walk.
+ */
+template <typename BookMap, typename OverlayMap, typename Visitor>
+void visit_levels(const BookMap &book, const OverlayMap &overlay,
+                  Visitor &&visit) {
+    const auto comp = book.key_comp();
+    auto b = book.begin();
+    auto o = overlay.begin();
+    while (b != book.end() || o != overlay.end()) {
+        Ticks price;
+        Quantity qty;
+        if (o == overlay.end() ||
+            (b != book.end() && comp(b->first, o->first))) {
+            price = b->first;
+            qty = b->second;
+            ++b;
+        } else {
+            if (b != book.end() && b->first == o->first) ++b;
+            price = o->first;
+            qty = o->second.quantity_;
+            ++o;
+        }
+        if (qty == 0.0) continue;
+        if (!visit(price, qty)) return;
+    }
+}
+} // namespace
+
+/**
+ * @brief Creates a view of @p book and enables its change log.
+ *
+ * The view must be created while @p book is still empty, and @p book must
+ * outlive the view.
+ *
+ * @param book The exchange-side book the local view is derived from.
+ */
+LaggedBookView::LaggedBookView(OrderBook &book) : book_(&book) {
+    book_->enable_change_log();
+}
+
+/**
+ * @brief Makes visible every change whose local timestamp is before @p now.
+ *
+ * Newly logged changes are first registered in the overlay, freezing the
+ * locally visible quantity of their level. Changes are then delivered in log
+ * order until the first one that is not yet visible, and trimmed from the
+ * source book's log.
+ *
+ * @param now The current local time in microseconds.
+ */
+void LaggedBookView::advance(Timestamp now) {
+    auto &log = book_->change_log_;
+    for (; registered_ < log.size(); ++registered_) {
+        register_change(log[registered_]);
+    }
+    while (!log.empty() && log.front().local_timestamp_ < now) {
+        deliver_change(log.front());
+        log.pop_front();
+        --registered_;
+    }
+}
+
+void LaggedBookView::register_change(const LevelChange &change) {
+    if (change.side_ == BookSide::Bid) {
+        auto [it, _] = bid_overlay_.try_emplace(
+            change.price_, LaggedLevel{change.prev_quantity_, 0});
+        ++it->second.pending_;
+    } else {
+        auto [it, _] = ask_overlay_.try_emplace(
+            change.price_, LaggedLevel{change.prev_quantity_, 0});
+        ++it->second.pending_;
+    }
+}
+
+void LaggedBookView::deliver_change(const LevelChange &change) {
+    if (change.side_ == BookSide::Bid) {
+        auto it = bid_overlay_.find(change.price_);
+        it->second.quantity_ = change.new_quantity_;
+        if (--it->second.pending_ == 0) bid_overlay_.erase(it);
+        if (snapshots_enabled_)
+            bid_pages_.set(change.price_, change.new_quantity_);
+    } else {
+        auto it = ask_overlay_.find(change.price_);
+        it->second.quantity_ = change.new_quantity_;
+        if (--it->second.pending_ == 0) ask_overlay_.erase(it);
+        if (snapshots_enabled_)
+            ask_pages_.set(change.price_, change.new_quantity_);
+    }
+}
+
+/**
+ * @brief Returns an immutable snapshot of the locally visible book.
+ *
+ * The first call builds a paged copy-on-write mirror of the visible levels;
+ * from then on the mirror is kept up to date as changes are delivered, and
+ * each snapshot only shares its pages, so taking one costs O(1).
+ *
+ * @param now The local time the snapshot is labelled with.
+ * @return A snapshot that stays valid regardless of later book changes.
+ */
+BookSnapshot LaggedBookView::snapshot(Timestamp now) {
+    if (!snapshots_enabled_) {
+        for (const auto &[price, qty] : bid_book()) bid_pages_.set(price, qty);
+        for (const auto &[price, qty] : ask_book()) ask_pages_.set(price, qty);
+        snapshots_enabled_ = true;
+    }
+    return BookSnapshot(now, book_->tick_size_, bid_pages_, ask_pages_);
+}
+
+/**
+ * @brief Returns the number of logged changes not yet visible locally.
+ */
+std::size_t LaggedBookView::pending_changes() const {
+    return book_->change_log_.size();
+}
+
+Price LaggedBookView::best_bid() const {
+    return utils::math::ticks_to_price(price_at_level(BookSide::Bid, 0),
+                                       book_->tick_size_);
+}
+
+Price LaggedBookView::best_ask() const {
+    return utils::math::ticks_to_price(price_at_level(BookSide::Ask, 0),
+                                       book_->tick_size_);
+}
+
+/**
+ * @brief Returns the locally visible mid price, or 0.0 if either side is
+ * empty.
+ */
+Price LaggedBookView::mid_price() const {
+    Ticks bid = price_at_level(BookSide::Bid, 0);
+    Ticks ask = price_at_level(BookSide::Ask, 0);
+    if (bid == 0 || ask == 0) return 0.0;
+    return (utils::math::ticks_to_price(bid, book_->tick_size_) +
+            utils::math::ticks_to_price(ask, book_->tick_size_)) /
+           2.0;
+}
+
+/**
+ * @brief Returns the locally visible quantity at a price, or 0 if absent.
+ */
+Quantity LaggedBookView::depth_at(const BookSide side,
+                                  const Ticks price) const {
+    if (side == BookSide::Bid) {
+        auto it = bid_overlay_.find(price);
+        if (it != bid_overlay_.end()) return it->second.quantity_;
+    } else {
+        auto it = ask_overlay_.find(price);
+        if (it != ask_overlay_.end()) return it->second.quantity_;
+    }
+    return book_->depth_at(side, price);
+}
+
+/**
+ * @brief Returns the locally visible quantity at a 0-based level, or 0 if out
+ * of range.
+ */
+Quantity LaggedBookView::depth_at_level(const BookSide side,
+                                        const int level) const {
+    if (level < 0) return 0.0;
+    Quantity result = 0.0;
+    int i = 0;
+    auto visit = [&](Ticks, Quantity qty) {
+        if (i++ < level) return true;
+        result = qty;
+        return false;
+    };
+    if (side == BookSide::Bid) {
+        visit_levels(book_->bid_book_, bid_overlay_, visit);
+    } else {
+        visit_levels(book_->ask_book_, ask_overlay_, visit);
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the locally visible price at a 0-based level, or 0 if out of
+ * range.
+ */
+Ticks LaggedBookView::price_at_level(const BookSide side,
+                                     const int level) const {
+    if (level < 0) return 0;
+    Ticks result = 0;
+    int i = 0;
+    auto visit = [&](Ticks price, Quantity) {
+        if (i++ < level) return true;
+        result = price;
+        return false;
+    };
+    if (side == BookSide::Bid) {
+        visit_levels(book_->bid_book_, bid_overlay_, visit);
+    } else {
+        visit_levels(book_->ask_book_, ask_overlay_, visit);
+    }
+    return result;
+}
+
+/**
+ * @brief Materialises the locally visible bid side.
+ */
+std::map<Ticks, Quantity, std::greater<>> LaggedBookView::bid_book() const {
+    std::map<Ticks, Quantity, std::greater<>> result;
+    visit_levels(book_->bid_book_, bid_overlay_,
+                 [&](Ticks price, Quantity qty) {
+                     result.emplace_hint(result.end(), price, qty);
+                     return true;
+                 });
+    return result;
+}
+
+/**
+ * @brief Materialises the locally visible ask side.
+ */
+std::map<Ticks, Quantity> LaggedBookView::ask_book() const {
+    std::map<Ticks, Quantity> result;
+    visit_levels(book_->ask_book_, ask_overlay_,
+                 [&](Ticks price, Quantity qty) {
+                     result.emplace_hint(result.end(), price, qty);
+                     return true;
+                 });
+    return result;
+}
+} // namespace core::orderbook
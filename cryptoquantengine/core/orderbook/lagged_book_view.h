@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+
+#include "../types/aliases/usings.h"
+#include "../types/enums/book_side.h"
+#include "book_snapshot.h"
+#include "level_change.h"
+#include "orderbook.h"
+
+namespace core::orderbook {
+/**
+ * @brief Read-only view of an OrderBook as it was seen locally, i.e. with
+ * every change delayed until its local timestamp.
+ *
+ * The view does not keep a second copy of the book. It keeps only the levels
+ * whose locally visible quantity still differs from the source book, derived
+ * from the source book's change log. Levels without pending changes are read
+ * straight from the source book.
+ */
+class LaggedBookView {
+  public:
+    explicit LaggedBookView(OrderBook &book);
+
+    void advance(Timestamp now);
+
+    Price best_bid() const;
+    Price best_ask() const;
+    Price mid_price() const;
+
+    Quantity depth_at(const BookSide side, const Ticks price) const;
+    Quantity depth_at_level(const BookSide side, const int level) const;
+    Ticks price_at_level(const BookSide side, const int level) const;
+
+    std::map<Ticks, Quantity, std::greater<>> bid_book() const;
+    std::map<Ticks, Quantity> ask_book() const;
+
+    BookSnapshot snapshot(Timestamp now);
+
+    std::size_t pending_changes() const;
+
+  private:
+    struct LaggedLevel {
+        Quantity quantity_; // locally visible quantity (0 = absent)
+        int pending_;       // changes not yet visible locally
+    };
+
+    OrderBook *book_;
+    std::size_t registered_ = 0;
+    std::map<Ticks, LaggedLevel, std::greater<>> bid_overlay_;
+    std::map<Ticks, LaggedLevel> ask_overlay_;
+
+    // paged mirror of the visible state, kept once snapshots are requested
+    bool snapshots_enabled_ = false;
+    PagedLevels bid_pages_;
+    PagedLevels ask_pages_;
+
+    void register_change(const LevelChange &change);
+    void deliver_change(const LevelChange &change);
+};
+} // namespace core::orderbook
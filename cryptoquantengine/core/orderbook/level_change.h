@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include "../types/aliases/usings.h"
+#include "../types/enums/book_side.h"
+
+namespace core::orderbook {
+struct LevelChange {
+    Timestamp local_timestamp_; // when the change becomes visible locally
+    BookSide side_;
+    Ticks price_;
+    Quantity prev_quantity_; // 0 = level did not exist
+    Quantity new_quantity_;  // 0 = level removed
+};
+} // namespace core::orderbook
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "../../utils/math/math_utils.h"
+#include "../market_data/mbo_update.h"
+#include "../types/enums/mbo_action.h"
+#include "mbo_orderbook.h"
+
+namespace core::orderbook {
+/**
+ * @brief Constructs an empty book.
+ *
+ * @param resource Memory resource backing the order pool, the id index and
+ * the price levels.
+ */
+MboOrderBook::MboOrderBook(double tick_size, double lot_size,
+                           std::pmr::memory_resource *resource)
+    : tick_size_(tick_size), lot_size_(lot_size), nodes_(resource),
+      free_nodes_(resource), index_(resource), bid_levels_(resource),
+      ask_levels_(resource) {
+    if (tick_size <= 0.0) {
+        throw std::invalid_argument("Tick size must be positive: " +
+                                    std::to_string(tick_size));
+    }
+    if (lot_size <= 0.0) {
+        throw std::invalid_argument("Lot size must be positive: " +
+                                    std::to_string(lot_size));
+    }
+}
+
+/**
+ * @brief Applies one order-level event to the book.
+ *
+ * - Add inserts the order at the back of its level's queue (an add for a
+ *   known id is treated as a modify).
+ * - Modify keeps the order's queue priority when only its quantity shrinks;
+ *   a price change or a size increase re-queues it at the back of the level,
+ *   as exchanges do. A modify for an unknown id is treated as an add.
+ * - Delete (or a modify to zero quantity) removes the order. Deletes for
+ *   unknown ids are ignored.
+ *
+ * @param update The order-level event.
+ * @param[out] touched The price levels whose aggregate quantity may have
+ * changed.
+ * @return The number of entries written to @p touched (0, 1 or 2).
+ * @throws std::invalid_argument if an add or modify has a non-positive price
+ * or a negative quantity.
+ */
+int MboOrderBook::apply(const core::market_data::MboUpdate &update,
+                        std::array<LevelKey, 2> &touched) {
+    std::uint32_t node = index_.find(update.order_id_);
+    if (update.action_ == MboAction::Delete) {
+        if (node == kNil) return 0;
+        touched[0] = LevelKey{nodes_[node].side_, nodes_[node].price_};
+        remove_order(node);
+        return 1;
+    }
+    if (update.price_ <= 0.0) {
+        throw std::invalid_argument("Price must be positive: " +
+                                    std::to_string(update.price_));
+    }
+    if (update.quantity_ < 0.0) {
+        throw std::invalid_argument("Quantity cannot be negative: " +
+                                    std::to_string(update.quantity_));
+    }
+    const Ticks price = utils::math::price_to_ticks(update.price_, tick_size_);
+    if (node == kNil) {
+        if (update.quantity_ == 0.0) return 0;
+        add_order(update.order_id_, update.side_, price, update.quantity_);
+        touched[0] = LevelKey{update.side_, price};
+        return 1;
+    }
+
+    Node &existing = nodes_[node];
+    touched[0] = LevelKey{existing.side_, existing.price_};
+    if (update.quantity_ == 0.0) {
+        remove_order(node);
+        return 1;
+    }
+    if (existing.side_ == update.side_ && existing.price_ == price &&
+        update.quantity_ <= existing.quantity_) {
+        // size reduction keeps time priority
+        level(existing.side_, existing.price_)->quantity_ +=
+            update.quantity_ - existing.quantity_;
+        existing.quantity_ = update.quantity_;
+        return 1;
+    }
+    remove_order(node);
+    add_order(update.order_id_, update.side_, price, update.quantity_);
+    if (touched[0].side_ == update.side_ && touched[0].price_ == price) {
+        return 1;
+    }
+    touched[1] = LevelKey{update.side_, price};
+    return 2;
+}
+
+void MboOrderBook::add_order(std::uint64_t order_id, BookSide side,
+                             Ticks price, Quantity quantity) {
+    std::uint32_t node;
+    if (!free_nodes_.empty()) {
+        node = free_nodes_.back();
+        free_nodes_.pop_back();
+    } else {
+        node = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    Level &lvl = (side == BookSide::Bid) ? bid_levels_[price]
+                                         : ask_levels_[price];
+    nodes_[node] = Node{.order_id_ = order_id,
+                        .sequence_ = next_sequence_++,
+                        .quantity_ = quantity,
+                        .price_ = price,
+                        .side_ = side,
+                        .prev_ = lvl.tail_,
+                        .next_ = kNil};
+    if (lvl.tail_ != kNil) {
+        nodes_[lvl.tail_].next_ = node;
+    } else {
+        lvl.head_ = node;
+    }
+    lvl.tail_ = node;
+    lvl.quantity_ += quantity;
+    ++lvl.count_;
+    index_.insert(order_id, node);
+}
+
+void MboOrderBook::remove_order(std::uint32_t node) {
+    const Node &n = nodes_[node];
+    Level *lvl = level(n.side_, n.price_);
+    if (n.prev_ != kNil) {
+        nodes_[n.prev_].next_ = n.next_;
+    } else {
+        lvl->head_ = n.next_;
+    }
+    if (n.next_ != kNil) {
+        nodes_[n.next_].prev_ = n.prev_;
+    } else {
+        lvl->tail_ = n.prev_;
+    }
+    lvl->quantity_ -= n.quantity_;
+    if (--lvl->count_ == 0) {
+        (n.side_ == BookSide::Bid) ? bid_levels_.erase(n.price_)
+                                   : ask_levels_.erase(n.price_);
+    }
+    index_.erase(n.order_id_);
+    free_nodes_.push_back(node);
+}
+
+MboOrderBook::Level *MboOrderBook::level(BookSide side, Ticks price) {
+    if (side == BookSide::Bid) {
+        auto it = bid_levels_.find(price);
+        return (it != bid_levels_.end()) ? &it->second : nullptr;
+    }
+    auto it = ask_levels_.find(price);
+    return (it != ask_levels_.end()) ? &it->second : nullptr;
+}
+
+const MboOrderBook::Level *MboOrderBook::level(BookSide side,
+                                               Ticks price) const {
+    return const_cast<MboOrderBook *>(this)->level(side, price);
+}
+
+/**
+ * @brief Returns the aggregate resting quantity at a price level, or 0.
+ */
+Quantity MboOrderBook::depth_at(const BookSide side, const Ticks price) const {
+    const Level *lvl = level(side, price);
+    if (!lvl) return 0.0;
+    // guard against accumulated rounding leaving a tiny residue
+    return (lvl->quantity_ > 0.0) ? lvl->quantity_ : 0.0;
+}
+
+/**
+ * @brief Returns the number of resting orders at a price level.
+ */
+int MboOrderBook::order_count_at(const BookSide side,
+                                 const Ticks price) const {
+    const Level *lvl = level(side, price);
+    return lvl ? lvl->count_ : 0;
+}
+
+/**
+ * @brief Returns the resting quantity queued ahead of a given time priority.
+ *
+ * Sums the orders at the level whose sequence number is lower than
+ * @p sequence, i.e. those that joined the queue before an order that was
+ * assigned @p sequence via next_sequence().
+ *
+ * @param side Book side of the level.
+ * @param price Level price in ticks.
+ * @param sequence Time priority of the order whose queue position is wanted.
+ * @return The exact quantity ahead in the FIFO queue.
+ */
+Quantity MboOrderBook::volume_ahead(const BookSide side, const Ticks price,
+                                    std::uint64_t sequence) const {
+    const Level *lvl = level(side, price);
+    if (!lvl) return 0.0;
+    Quantity ahead = 0.0;
+    for (std::uint32_t n = lvl->head_;
+         n != kNil && nodes_[n].sequence_ < sequence; n = nodes_[n].next_) {
+        ahead += nodes_[n].quantity_;
+    }
+    return ahead;
+}
+
+/**
+ * @brief Returns the time priority an order joining the book now would get.
+ *
+ * Every resting order has a lower sequence number; every order added later
+ * gets a higher one.
+ */
+std::uint64_t MboOrderBook::next_sequence() const { return next_sequence_; }
+
+Price MboOrderBook::best_bid() const {
+    return bid_levels_.empty()
+               ? 0.0
+               : utils::math::ticks_to_price(bid_levels_.begin()->first,
+                                             tick_size_);
+}
+
+Price MboOrderBook::best_ask() const {
+    return ask_levels_.empty()
+               ? 0.0
+               : utils::math::ticks_to_price(ask_levels_.begin()->first,
+                                             tick_size_);
+}
+
+/**
+ * @brief Returns the total number of resting orders.
+ */
+std::size_t MboOrderBook::order_count() const { return index_.size(); }
+
+/**
+ * @brief Removes every order; sequence numbers keep increasing.
+ */
+void MboOrderBook::clear() {
+    nodes_.clear();
+    free_nodes_.clear();
+    index_.clear();
+    bid_levels_.clear();
+    ask_levels_.clear();
+}
+
+MboOrderBook::OrderIndex::OrderIndex(std::pmr::memory_resource *resource)
+    : slots_(resource) {}
+
+std::size_t MboOrderBook::OrderIndex::slot_of(std::uint64_t order_id) const {
+    // Fibonacci hashing spreads sequential exchange ids across the table
+    return static_cast<std::size_t>((order_id * 0x9E3779B97F4A7C15ull) >>
+                                    32) &
+           (slots_.size() - 1);
+}
+
+std::uint32_t MboOrderBook::OrderIndex::find(std::uint64_t order_id) const {
+    if (slots_.empty()) return kNil;
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t i = slot_of(order_id);; i = (i + 1) & mask) {
+        if (slots_[i].value_ == kNil) return kNil;
+        if (slots_[i].key_ == order_id) return slots_[i].value_;
+    }
+}
+
+void MboOrderBook::OrderIndex::insert(std::uint64_t order_id,
+                                      std::uint32_t node) {
+    if ((size_ + 1) * 2 > slots_.size()) grow();
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t i = slot_of(order_id);; i = (i + 1) & mask) {
+        if (slots_[i].value_ == kNil) {
+            slots_[i] = Slot{order_id, node};
+            ++size_;
+            return;
+        }
+        if (slots_[i].key_ == order_id) {
+            slots_[i].value_ = node;
+            return;
+        }
+    }
+}
+
+void MboOrderBook::OrderIndex::erase(std::uint64_t order_id) {
+    if (slots_.empty()) return;
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t i = slot_of(order_id);
+    while (true) {
+        if (slots_[i].value_ == kNil) return;
+        if (slots_[i].key_ == order_id) break;
+        i = (i + 1) & mask;
+    }
+    // backward-shift deletion keeps probe chains intact without tombstones
+    std::size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (slots_[j].value_ == kNil) break;
+        std::size_t home = slot_of(slots_[j].key_);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            slots_[i] = slots_[j];
+            i = j;
+        }
+    }
+    slots_[i].value_ = kNil;
+    --size_;
+}
+
+void MboOrderBook::OrderIndex::clear() {
+    slots_.clear();
+    size_ = 0;
+}
+
+std::size_t MboOrderBook::OrderIndex::size() const { return size_; }
+
+void MboOrderBook::OrderIndex::grow() {
+    std::pmr::vector<Slot> old(std::move(slots_));
+    slots_.assign(old.empty() ? 1024 : old.size() * 2, Slot{});
+    size_ = 0;
+    for (const auto &slot : old) {
+        if (slot.value_ != kNil) insert(slot.key_, slot.value_);
+    }
+}
+} // namespace core::orderbook
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+#include "../market_data/mbo_update.h"
+#include "../types/aliases/usings.h"
+#include "../types/enums/book_side.h"
+
+namespace core::orderbook {
+/**
+ * @brief Market-by-order (L3) book keeping every resting order in FIFO order
+ * per price level.
+ *
+ * Orders live in a pooled node array and are linked into intrusive
+ * doubly-linked lists per level; an open-addressing hash maps exchange order
+ * ids to nodes. Each order carries a sequence number giving its time
+ * priority, which lets queue position be computed exactly.
+ */
+class MboOrderBook {
+  public:
+    struct LevelKey {
+        BookSide side_;
+        Ticks price_;
+    };
+
+    MboOrderBook(double tick_size, double lot_size,
+                 std::pmr::memory_resource *resource =
+                     std::pmr::get_default_resource());
+
+    int apply(const core::market_data::MboUpdate &update,
+              std::array<LevelKey, 2> &touched);
+
+    Quantity depth_at(const BookSide side, const Ticks price) const;
+    int order_count_at(const BookSide side, const Ticks price) const;
+    Quantity volume_ahead(const BookSide side, const Ticks price,
+                          std::uint64_t sequence) const;
+    std::uint64_t next_sequence() const;
+
+    Price best_bid() const;
+    Price best_ask() const;
+    std::size_t order_count() const;
+
+    void clear();
+
+  private:
+    static constexpr std::uint32_t kNil =
+        std::numeric_limits<std::uint32_t>::max();
+
+    struct Node {
+        std::uint64_t order_id_;
+        std::uint64_t sequence_;
+        Quantity quantity_;
+        Ticks price_;
+        BookSide side_;
+        std::uint32_t prev_;
+        std::uint32_t next_;
+    };
+    struct Level {
+        std::uint32_t head_ = kNil;
+        std::uint32_t tail_ = kNil;
+        Quantity quantity_ = 0.0;
+        int count_ = 0;
+    };
+
+    // open-addressing (linear probing) order id -> node index
+    class OrderIndex {
+      public:
+        explicit OrderIndex(std::pmr::memory_resource *resource);
+
+        std::uint32_t find(std::uint64_t order_id) const;
+        void insert(std::uint64_t order_id, std::uint32_t node);
+        void erase(std::uint64_t order_id);
+        void clear();
+        std::size_t size() const;
+
+      private:
+        struct Slot {
+            std::uint64_t key_;
+            std::uint32_t value_ = kNil; // kNil = empty slot
+        };
+        std::pmr::vector<Slot> slots_;
+        std::size_t size_ = 0;
+
+        std::size_t slot_of(std::uint64_t order_id) const;
+        void grow();
+    };
+
+    double tick_size_;
+    double lot_size_;
+    std::uint64_t next_sequence_ = 0;
+
+    std::pmr::vector<Node> nodes_;
+    std::pmr::vector<std::uint32_t> free_nodes_;
+    OrderIndex index_;
+    std::pmr::map<Ticks, Level, std::greater<>> bid_levels_;
+    std::pmr::map<Ticks, Level> ask_levels_;
+
+    void add_order(std::uint64_t order_id, BookSide side, Ticks price,
+                   Quantity quantity);
+    void remove_order(std::uint32_t node);
+    Level *level(BookSide side, Ticks price);
+    const Level *level(BookSide side, Ticks price) const;
+};
+} // namespace core::orderbook
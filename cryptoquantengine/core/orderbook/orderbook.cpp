@@ -9,10 +9,14 @@
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 
 #include "../../utils/logger/logger.h"
+#include "../../utils/hash/hash_utils.h"
 #include "../../utils/math/math_utils.h"
 #include "../market_data/book_update.h"
+#include "../market_data/book_update_batch.h"
+#include "../market_data/depth_snapshot.h"
 #include "../market_data/trade.h"
 #include "../types/enums/book_side.h"
 #include "orderbook.h"
@@ -20,10 +24,18 @@
 namespace core {
 namespace orderbook {
 
+/**
+ * @brief Constructs an empty book.
+ *
+ * @param resource Memory resource backing the price levels and the change
+ * log; a per-run arena lets a sweep worker release them wholesale.
+ */
 OrderBook::OrderBook(double tick_size, double lot_size,
-                     std::shared_ptr<utils::logger::Logger> logger)
-    : tick_size_(tick_size), lot_size_(lot_size), bid_book_(), ask_book_(),
-      last_update_(UpdateType::Snapshot), logger_(logger){
+                     std::shared_ptr<utils::logger::Logger> logger,
+                     std::pmr::memory_resource *resource)
+    : tick_size_(tick_size), lot_size_(lot_size), bid_book_(resource),
+      ask_book_(resource), last_update_(UpdateType::Snapshot),
+      change_log_(resource), batch_rows_(resource), logger_(logger) {
     if (tick_size <= 0.0) {
         throw std::invalid_argument("Tick size must be positive: " +
                                     std::to_string(tick_size));
@@ -42,7 +54,7 @@ OrderBook::OrderBook(double tick_size, double lot_size,
  * @return A map of price levels (Ticks) to quantities (Quantity) for asks.
  */
 std::map<Ticks, Quantity, std::greater<>> OrderBook::bid_book() const {
-    return bid_book_;
+    return {bid_book_.begin(), bid_book_.end()};
 }
 
 /**
@@ -52,7 +64,9 @@ std::map<Ticks, Quantity, std::greater<>> OrderBook::bid_book() const {
  *
  * @return A map of price levels (Ticks) to quantities (Quantity) for asks.
  */
-std::map<Ticks, Quantity> OrderBook::ask_book() const { return ask_book_; }
+std::map<Ticks, Quantity> OrderBook::ask_book() const {
+    return {ask_book_.begin(), ask_book_.end()};
+}
 
 /**
  * @brief Clears the order book by removing all bids and asks.
@@ -63,6 +77,43 @@ void OrderBook::clear() {
     ask_book_.clear();
 }
 
+/**
+ * @brief Clears the book, logging the removal of every level when the change
+ * log is enabled.
+ *
+ * @param local_timestamp Time at which the removals become visible locally.
+ */
+void OrderBook::clear(Timestamp local_timestamp) {
+    if (log_changes_) {
+        for (const auto &[price, qty] : bid_book_) {
+            log_change(local_timestamp, BookSide::Bid, price, qty, 0.0);
+        }
+        for (const auto &[price, qty] : ask_book_) {
+            log_change(local_timestamp, BookSide::Ask, price, qty, 0.0);
+        }
+    }
+    clear();
+}
+
+/**
+ * @brief Starts recording every level change applied to this book.
+ *
+ * Each change is appended to the change log together with the local
+ * timestamp of the update that caused it. The log is consumed (and trimmed)
+ * by a LaggedBookView, which derives the latency-delayed local view of the
+ * book from this single book.
+ */
+void OrderBook::enable_change_log() { log_changes_ = true; }
+
+void OrderBook::log_change(Timestamp local_timestamp, BookSide side,
+                           Ticks price, Quantity prev_quantity,
+                           Quantity new_quantity) {
+    if (prev_quantity == new_quantity) return;
+    // positional: the C++17 stream target compiles this file too
+    change_log_.push_back(LevelChange{local_timestamp, side, price,
+                                      prev_quantity, new_quantity});
+}
+
 /**
  * @brief Applies a book update to the order book.
  *
@@ -72,23 +123,27 @@ void OrderBook::clear() {
  *
  * @param update The book update to apply.
  * @throws std::invalid_argument if the price is not positive or quantity is
- * negative.
+ * negative, unless row checks are disabled.
  */
 void OrderBook::apply_book_update(const core::market_data::BookUpdate &update) {
 
-    if (update.price_ <= 0.0) {
+    if (check_rows_ && update.price_ <= 0.0) {
         throw std::invalid_argument("Price must be positive: " +
                                     std::to_string(update.price_));
     }
-    if (update.quantity_ < 0.0) {
+    if (check_rows_ && update.quantity_ < 0.0) {
         throw std::invalid_argument("Quantity cannot be negative: " +
                                     std::to_string(update.quantity_));
     }
     if (update.update_type_ == UpdateType::Snapshot &&
         last_update_ == UpdateType::Incremental) {
-        clear();
+        clear(update.local_timestamp_);
     }
     Ticks price_ticks = utils::math::price_to_ticks(update.price_, tick_size_);
+    if (log_changes_) {
+        log_change(update.local_timestamp_, update.side_, price_ticks,
+                   depth_at(update.side_, price_ticks), update.quantity_);
+    }
     if (update.quantity_ == 0.0) {
         (update.side_ == BookSide::Bid) ? bid_book_.erase(price_ticks)
                                         : ask_book_.erase(price_ticks);
@@ -100,6 +155,241 @@ void OrderBook::apply_book_update(const core::market_data::BookUpdate &update) {
     last_update_ = update.update_type_;
 }
 
+/**
+ * @brief Enables or disables the per-row price and quantity checks of
+ * `apply_book_update()`.
+ *
+ * Only disable them for tapes already cleaned by validate_book_tape, whose
+ * rows are known to have positive prices and non-negative quantities.
+ */
+void OrderBook::set_row_checks(bool enabled) { check_rows_ = enabled; }
+
+/**
+ * @brief Applies a whole book update batch.
+ *
+ * Leaves the book as calling `apply_book_update()` for each row in order
+ * would, but all rows are checked before any is applied, and rows are
+ * grouped by side and price: each touched level costs one map operation,
+ * visited in book order so adjacent levels reuse the previous position.
+ * The change log gets one entry per level, stamped with the local timestamp
+ * of the level's last row. A snapshot row following incremental ones still
+ * clears the book at that point, so rows on either side of it are grouped
+ * separately.
+ *
+ * @param batch The grouped book updates to apply.
+ * @throws std::invalid_argument if any row has a non-positive price or a
+ * negative quantity; the book is left unchanged.
+ */
+void OrderBook::apply_book_updates(
+    const core::market_data::BookUpdateBatch &batch) {
+    const auto &rows = batch.updates_;
+    if (check_rows_) {
+        for (const auto &update : rows) {
+            if (update.price_ <= 0.0) {
+                throw std::invalid_argument("Price must be positive: " +
+                                            std::to_string(update.price_));
+            }
+            if (update.quantity_ < 0.0) {
+                throw std::invalid_argument("Quantity cannot be negative: " +
+                                            std::to_string(update.quantity_));
+            }
+        }
+    }
+    std::size_t begin = 0;
+    while (begin < rows.size()) {
+        if (rows[begin].update_type_ == UpdateType::Snapshot &&
+            last_update_ == UpdateType::Incremental) {
+            clear(rows[begin].local_timestamp_);
+        }
+        std::size_t end = begin + 1;
+        while (end < rows.size() &&
+               !(rows[end].update_type_ == UpdateType::Snapshot &&
+                 rows[end - 1].update_type_ == UpdateType::Incremental)) {
+            ++end;
+        }
+        apply_batch_rows(rows, begin, end);
+        last_update_ = rows[end - 1].update_type_;
+        begin = end;
+    }
+}
+
+/**
+ * @brief Applies rows [@p begin, @p end) of a batch, none of which clears
+ * the book, one map operation per touched level.
+ */
+void OrderBook::apply_batch_rows(
+    const std::vector<core::market_data::BookUpdate> &rows, std::size_t begin,
+    std::size_t end) {
+    batch_rows_.clear();
+    for (std::size_t i = begin; i < end; ++i) {
+        batch_rows_.push_back(
+            BatchRow{rows[i].side_,
+                     utils::math::price_to_ticks(rows[i].price_, tick_size_),
+                     static_cast<std::uint32_t>(i)});
+    }
+    // bids best (highest) first, then asks best (lowest) first; rows of one
+    // level keep their batch order so the last one wins
+    std::sort(batch_rows_.begin(), batch_rows_.end(),
+              [](const BatchRow &a, const BatchRow &b) {
+                  if (a.side_ != b.side_) return a.side_ == BookSide::Bid;
+                  if (a.price_ != b.price_) {
+                      return (a.side_ == BookSide::Bid) ? a.price_ > b.price_
+                                                        : a.price_ < b.price_;
+                  }
+                  return a.index_ < b.index_;
+              });
+    std::size_t asks = apply_side_rows(bid_book_, BookSide::Bid, rows, 0);
+    apply_side_rows(ask_book_, BookSide::Ask, rows, asks);
+}
+
+/**
+ * @brief Applies the sorted batch rows of @p side, which start at
+ * batch_rows_[@p first], to that side's @p book.
+ *
+ * @return The index of the first row not on @p side.
+ */
+template <typename Book>
+std::size_t OrderBook::apply_side_rows(
+    Book &book, BookSide side,
+    const std::vector<core::market_data::BookUpdate> &rows,
+    std::size_t first) {
+    auto comp = book.key_comp();
+    auto it = book.begin();
+    std::size_t i = first;
+    while (i < batch_rows_.size() && batch_rows_[i].side_ == side) {
+        const Ticks price = batch_rows_[i].price_;
+        while (i + 1 < batch_rows_.size() && batch_rows_[i + 1].side_ == side &&
+               batch_rows_[i + 1].price_ == price) {
+            ++i;
+        }
+        const auto &last = rows[batch_rows_[i].index_];
+        ++i;
+        // `it` sits just past the previous level; search only when other
+        // levels lie in between
+        if (it != book.end() && comp(it->first, price)) {
+            it = book.lower_bound(price);
+        }
+        const bool found = it != book.end() && it->first == price;
+        if (log_changes_) {
+            log_change(last.local_timestamp_, side, price,
+                       found ? it->second : 0.0, last.quantity_);
+        }
+        if (last.quantity_ == 0.0) {
+            if (found) it = book.erase(it);
+        } else if (found) {
+            it->second = last.quantity_;
+            ++it;
+        } else {
+            it = std::next(book.emplace_hint(it, price, last.quantity_));
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Replaces the whole book with a top-N snapshot.
+ *
+ * Both sides are rebuilt in one pass from the snapshot's sorted levels and
+ * swapped in, instead of clearing the book and applying one update per level.
+ * When the change log is enabled only levels whose quantity differs from the
+ * previous book are logged.
+ *
+ * @param snapshot The snapshot; levels are best first on each side.
+ * @throws std::invalid_argument if a level has a negative quantity.
+ */
+void OrderBook::load_snapshot(
+    const core::market_data::DepthSnapshot &snapshot) {
+    // built with the book's allocator so the swap below is allowed
+    decltype(bid_book_) bids(bid_book_.get_allocator());
+    decltype(ask_book_) asks(ask_book_.get_allocator());
+    for (std::size_t i = 0; i < snapshot.bid_count_; ++i) {
+        const auto &level = snapshot.bids_[i];
+        if (level.quantity_ < 0.0) {
+            throw std::invalid_argument("Quantity cannot be negative: " +
+                                        std::to_string(level.quantity_));
+        }
+        if (level.price_ <= 0.0 || level.quantity_ == 0.0) continue;
+        // levels arrive best (highest) first, so each one goes at the end
+        bids.emplace_hint(bids.end(),
+                          utils::math::price_to_ticks(level.price_, tick_size_),
+                          level.quantity_);
+    }
+    for (std::size_t i = 0; i < snapshot.ask_count_; ++i) {
+        const auto &level = snapshot.asks_[i];
+        if (level.quantity_ < 0.0) {
+            throw std::invalid_argument("Quantity cannot be negative: " +
+                                        std::to_string(level.quantity_));
+        }
+        if (level.price_ <= 0.0 || level.quantity_ == 0.0) continue;
+        asks.emplace_hint(asks.end(),
+                          utils::math::price_to_ticks(level.price_, tick_size_),
+                          level.quantity_);
+    }
+    if (log_changes_) {
+        log_side_changes(snapshot.local_timestamp_, BookSide::Bid, bid_book_,
+                         bids);
+        log_side_changes(snapshot.local_timestamp_, BookSide::Ask, ask_book_,
+                         asks);
+    }
+    bid_book_.swap(bids);
+    ask_book_.swap(asks);
+    last_update_ = UpdateType::Snapshot;
+}
+
+/**
+ * @brief Copies the best @p depth levels of each side into @p snapshot, the
+ * inverse of load_snapshot(); timestamps are left to the caller.
+ *
+ * @param depth Levels per side, capped at kSnapshotLevels.
+ */
+void OrderBook::top_levels(core::market_data::DepthSnapshot &snapshot,
+                           std::size_t depth) const {
+    depth = std::min(depth, core::market_data::kSnapshotLevels);
+    snapshot.bid_count_ = 0;
+    for (auto it = bid_book_.begin();
+         it != bid_book_.end() && snapshot.bid_count_ < depth; ++it) {
+        snapshot.bids_[snapshot.bid_count_++] = {
+            utils::math::ticks_to_price(it->first, tick_size_), it->second};
+    }
+    snapshot.ask_count_ = 0;
+    for (auto it = ask_book_.begin();
+         it != ask_book_.end() && snapshot.ask_count_ < depth; ++it) {
+        snapshot.asks_[snapshot.ask_count_++] = {
+            utils::math::ticks_to_price(it->first, tick_size_), it->second};
+    }
+}
+
+/**
+ * @brief Logs every level whose quantity differs between two versions of one
+ * side of the book.
+ */
+template <typename Book>
+void OrderBook::log_side_changes(Timestamp local_timestamp, BookSide side,
+                                 const Book &from, const Book &to) {
+    auto comp = from.key_comp();
+    auto a = from.begin();
+    auto b = to.begin();
+    while (a != from.end() || b != to.end()) {
+        if (b == to.end() || (a != from.end() && comp(a->first, b->first))) {
+            log_change(local_timestamp, side, a->first, a->second, 0.0);
+            ++a;
+        } else if (a == from.end() || comp(b->first, a->first)) {
+            log_change(local_timestamp, side, b->first, 0.0, b->second);
+            ++b;
+        } else {
+            log_change(local_timestamp, side, a->first, a->second, b->second);
+            ++a;
+            ++b;
+        }
+    }
+}
+
+/**
+ * @brief Returns the type of the last row applied, which decides whether a
+ * following snapshot row clears the book first.
+ */
+UpdateType OrderBook::last_update_type() const { return last_update_; }
+
 /**
  * @brief Returns the best (highest) bid price currently in the bid book.
  *
@@ -244,6 +534,26 @@ bool OrderBook::is_empty() const {
     return bid_book_.empty() && ask_book_.empty();
 }
 
+/**
+ * @brief Hashes every level of both sides, for replay verification.
+ *
+ * Two books hash alike iff they hold the same levels with bit-identical
+ * quantities (up to hash collisions).
+ */
+std::uint64_t OrderBook::state_hash() const {
+    using utils::hash::combine;
+    using utils::hash::combine_double;
+    std::uint64_t h = combine(0, bid_book_.size());
+    for (const auto &[price, qty] : bid_book_) {
+        h = combine_double(combine(h, price), qty);
+    }
+    h = combine(h, ask_book_.size());
+    for (const auto &[price, qty] : ask_book_) {
+        h = combine_double(combine(h, price), qty);
+    }
+    return h;
+}
+
 /**
  * @brief Prints the top N levels of the order book to the console.
  *
@@ -7,10 +7,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -18,19 +21,29 @@
 
 #include "../../utils/logger/logger.h"
 #include "../market_data/book_update.h"
+#include "../market_data/book_update_batch.h"
+#include "../market_data/depth_snapshot.h"
 #include "../market_data/trade.h"
 #include "../types/enums/book_side.h"
 #include "../types/enums/trade_side.h"
 #include "../types/enums/update_type.h"
 #include "../types/aliases/usings.h"
+#include "level_change.h"
 
 namespace core::orderbook {
 class OrderBook {
   public:
     OrderBook(double tick_size, double lot_size,
-              std::shared_ptr<utils::logger::Logger> logger = nullptr);
+              std::shared_ptr<utils::logger::Logger> logger = nullptr,
+              std::pmr::memory_resource *resource =
+                  std::pmr::get_default_resource());
 
     void apply_book_update(const core::market_data::BookUpdate &update);
+    void apply_book_updates(const core::market_data::BookUpdateBatch &batch);
+    void load_snapshot(const core::market_data::DepthSnapshot &snapshot);
+    void top_levels(
+        core::market_data::DepthSnapshot &snapshot,
+        std::size_t depth = core::market_data::kSnapshotLevels) const;
 
     Price best_bid() const;
     Price best_ask() const;
@@ -42,21 +55,55 @@ class OrderBook {
 
     int bid_levels() const;
     int ask_levels() const;
+    UpdateType last_update_type() const;
 
     std::map<Ticks, Quantity, std::greater<>> bid_book() const;
     std::map<Ticks, Quantity> ask_book() const;
 
     void clear();
 
+    void enable_change_log();
+    void set_row_checks(bool enabled);
+
     void print_top_levels(int depth = 5) const;
     bool is_empty() const;
+    std::uint64_t state_hash() const;
 
   private:
     double tick_size_;
     double lot_size_;
-    std::map<Ticks, Quantity, std::greater<>> bid_book_;
-    std::map<Ticks, Quantity> ask_book_;
+    std::pmr::map<Ticks, Quantity, std::greater<>> bid_book_;
+    std::pmr::map<Ticks, Quantity> ask_book_;
     UpdateType last_update_;
+    bool check_rows_ = true; // off for tapes cleaned by validate_book_tape
+
+    bool log_changes_ = false;
+    std::pmr::deque<LevelChange> change_log_;
+
+    // one row of a batch, sorted into book order by apply_book_updates()
+    struct BatchRow {
+        BookSide side_;
+        Ticks price_;
+        std::uint32_t index_; // position in the batch
+    };
+    std::pmr::vector<BatchRow> batch_rows_; // reused across batches
+
+    void log_change(Timestamp local_timestamp, BookSide side, Ticks price,
+                    Quantity prev_quantity, Quantity new_quantity);
+    void clear(Timestamp local_timestamp);
+    template <typename Book>
+    void log_side_changes(Timestamp local_timestamp, BookSide side,
+                          const Book &from, const Book &to);
+    void apply_batch_rows(
+        const std::vector<core::market_data::BookUpdate> &rows,
+        std::size_t begin, std::size_t end);
+    template <typename Book>
+    std::size_t apply_side_rows(
+        Book &book, BookSide side,
+        const std::vector<core::market_data::BookUpdate> &rows,
+        std::size_t first);
+
+    friend class LaggedBookView;
 
     std::shared_ptr<utils::logger::Logger> logger_;
 };
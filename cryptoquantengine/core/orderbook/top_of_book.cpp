@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "../../utils/math/math_utils.h"
+#include "../market_data/quote.h"
+#include "top_of_book.h"
+
+namespace core::orderbook {
+TopOfBook::TopOfBook(double tick_size, double lot_size)
+    : tick_size_(tick_size), lot_size_(lot_size) {
+    if (tick_size <= 0.0) {
+        throw std::invalid_argument("Tick size must be positive: " +
+                                    std::to_string(tick_size));
+    }
+    if (lot_size <= 0.0) {
+        throw std::invalid_argument("Lot size must be positive: " +
+                                    std::to_string(lot_size));
+    }
+}
+
+/**
+ * @brief Replaces both sides with the prices and sizes of a quote.
+ *
+ * A side with a non-positive price or quantity is treated as empty.
+ *
+ * @param quote The best bid/offer update.
+ * @throws std::invalid_argument if a quantity is negative.
+ */
+void TopOfBook::apply_quote(const core::market_data::Quote &quote) {
+    if (quote.bid_quantity_ < 0.0 || quote.ask_quantity_ < 0.0) {
+        throw std::invalid_argument("Quantity cannot be negative");
+    }
+    if (quote.bid_price_ > 0.0 && quote.bid_quantity_ > 0.0) {
+        bid_price_ = utils::math::price_to_ticks(quote.bid_price_, tick_size_);
+        bid_quantity_ = quote.bid_quantity_;
+    } else {
+        bid_price_ = 0;
+        bid_quantity_ = 0.0;
+    }
+    if (quote.ask_price_ > 0.0 && quote.ask_quantity_ > 0.0) {
+        ask_price_ = utils::math::price_to_ticks(quote.ask_price_, tick_size_);
+        ask_quantity_ = quote.ask_quantity_;
+    } else {
+        ask_price_ = 0;
+        ask_quantity_ = 0.0;
+    }
+}
+
+Price TopOfBook::best_bid() const {
+    return utils::math::ticks_to_price(bid_price_, tick_size_);
+}
+
+Price TopOfBook::best_ask() const {
+    return utils::math::ticks_to_price(ask_price_, tick_size_);
+}
+
+/**
+ * @brief Returns the mid price, or 0.0 if either side is empty.
+ */
+Price TopOfBook::mid_price() const {
+    if (bid_price_ == 0 || ask_price_ == 0) return 0.0;
+    return (best_bid() + best_ask()) / 2.0;
+}
+
+/**
+ * @brief Returns the quantity at @p price if it is the touch, otherwise 0.
+ */
+Quantity TopOfBook::depth_at(const BookSide side, const Ticks price) const {
+    if (side == BookSide::Bid) {
+        return (bid_price_ != 0 && price == bid_price_) ? bid_quantity_ : 0.0;
+    }
+    return (ask_price_ != 0 && price == ask_price_) ? ask_quantity_ : 0.0;
+}
+
+/**
+ * @brief Returns the touch quantity for level 0, otherwise 0.
+ */
+Quantity TopOfBook::depth_at_level(const BookSide side, const int level) const {
+    if (level != 0) return 0.0;
+    return (side == BookSide::Bid) ? bid_quantity_ : ask_quantity_;
+}
+
+/**
+ * @brief Returns the touch price in ticks for level 0, otherwise 0.
+ */
+Ticks TopOfBook::price_at_level(const BookSide side, const int level) const {
+    if (level != 0) return 0;
+    return (side == BookSide::Bid) ? bid_price_ : ask_price_;
+}
+
+int TopOfBook::bid_levels() const { return bid_price_ != 0 ? 1 : 0; }
+
+int TopOfBook::ask_levels() const { return ask_price_ != 0 ? 1 : 0; }
+
+void TopOfBook::clear() {
+    bid_price_ = 0;
+    bid_quantity_ = 0.0;
+    ask_price_ = 0;
+    ask_quantity_ = 0.0;
+}
+
+bool TopOfBook::is_empty() const { return bid_price_ == 0 && ask_price_ == 0; }
+} // namespace core::orderbook
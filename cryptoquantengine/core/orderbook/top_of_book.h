@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include "../market_data/quote.h"
+#include "../types/aliases/usings.h"
+#include "../types/enums/book_side.h"
+
+namespace core::orderbook {
+/**
+ * @brief Best bid and offer only, for assets driven by quote data.
+ *
+ * Exposes the same level accessors as OrderBook, with at most one level per
+ * side, and is updated in O(1) by overwriting both sides from each quote.
+ */
+class TopOfBook {
+  public:
+    TopOfBook(double tick_size, double lot_size);
+
+    void apply_quote(const core::market_data::Quote &quote);
+
+    Price best_bid() const;
+    Price best_ask() const;
+    Price mid_price() const;
+
+    Quantity depth_at(const BookSide side, const Ticks price) const;
+    Quantity depth_at_level(const BookSide side, const int level) const;
+    Ticks price_at_level(const BookSide side, const int level) const;
+
+    int bid_levels() const;
+    int ask_levels() const;
+
+    void clear();
+    bool is_empty() const;
+
+  private:
+    double tick_size_;
+    double lot_size_;
+    Ticks bid_price_ = 0; // 0 = side empty
+    Quantity bid_quantity_ = 0.0;
+    Ticks ask_price_ = 0;
+    Quantity ask_quantity_ = 0.0;
+};
+} // namespace core::orderbook
@@ -34,10 +34,13 @@ namespace core::recorder {
  * @param interval_us The time interval in microseconds for recording equity
  * snapshots.
  * @param logger Optional shared pointer to a Logger instance for logging
+ * @param resource Memory resource backing the recorded snapshots.
  */
 Recorder::Recorder(Microseconds interval_us,
-                   std::shared_ptr<utils::logger::Logger> logger)
-    : interval_us_(interval_us), logger_(logger) {
+                   std::shared_ptr<utils::logger::Logger> logger,
+                   std::pmr::memory_resource *resource)
+    : interval_us_(interval_us), records_(resource), state_records_(resource),
+      logger_(logger) {
     if (logger_) {
         logger_->log("[Recorder] - Initialized with interval: " +
                          std::to_string(interval_us) + " microseconds",
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include "../../utils/logger/logger.h"
@@ -19,7 +20,9 @@ namespace core::recorder {
 class Recorder {
   public:
     Recorder(Microseconds interval_us,
-             std::shared_ptr<utils::logger::Logger> logger = nullptr);
+             std::shared_ptr<utils::logger::Logger> logger = nullptr,
+             std::pmr::memory_resource *resource =
+                 std::pmr::get_default_resource());
 
     void record(const EquitySnapshot &snapshot);
     void record(Timestamp timestamp, double equity);
@@ -36,8 +39,8 @@ class Recorder {
 
   private:
     Microseconds interval_us_;
-    std::vector<EquitySnapshot> records_;
-    std::vector<StateSnapshot> state_records_;
+    std::pmr::vector<EquitySnapshot> records_;
+    std::pmr::vector<StateSnapshot> state_records_;
 
     std::shared_ptr<utils::logger::Logger> logger_;
 };
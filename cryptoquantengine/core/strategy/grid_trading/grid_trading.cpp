@@ -6,10 +6,11 @@
  */
 
 #include <cmath>
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
-#include <unordered_set>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "../../../utils/logger/log_level.h"
@@ -26,6 +27,21 @@
 #include "grid_trading_config.h"
 
 namespace core::strategy {
+namespace {
+// a / b rounded towards negative infinity, for b > 0
+std::int64_t floor_div(std::int64_t a, std::int64_t b) {
+    return a / b - (a % b != 0 && a < 0 ? 1 : 0);
+}
+
+std::int64_t ceil_div(std::int64_t a, std::int64_t b) {
+    return -floor_div(-a, b);
+}
+
+const char *side_name(BookSide side) {
+    return side == BookSide::Bid ? "bid" : "ask";
+}
+} // namespace
+
 GridTrading::GridTrading(int asset_id, int grid_num, Ticks grid_interval,
                          Ticks half_spread, double position_limit,
                          double notional_order_qty,
@@ -39,14 +55,23 @@ GridTrading::GridTrading(int asset_id, int grid_num, Ticks grid_interval,
 GridTrading::GridTrading(int asset_id,
                          const core::strategy::GridTradingConfig &config,
                          std::shared_ptr<utils::logger::Logger> logger)
-    : asset_id_(asset_id), grid_num_(config.grid_num_),
-      grid_interval_(config.grid_interval_), half_spread_(config.half_spread_),
-      position_limit_(config.position_limit_),
-      notional_order_qty_(config.notional_order_qty_), logger_(logger) {
-    initialize();
-}
+    : GridTrading(asset_id, config.grid_num_, config.grid_interval_,
+                  config.half_spread_, config.position_limit_,
+                  config.notional_order_qty_, logger) {}
 
+/**
+ * @brief Sizes both grids, so later calls never allocate. Orders placed
+ * before a second call are no longer managed.
+ *
+ * @throws std::invalid_argument if the grid interval is zero.
+ */
 void GridTrading::initialize() {
+    if (grid_interval_ == 0) {
+        throw std::invalid_argument("Grid interval must be at least one tick");
+    }
+    const std::size_t levels = grid_num_ > 0 ? grid_num_ : 0;
+    bids_ = GridSide{BookSide::Bid, std::vector<Level>(levels)};
+    asks_ = GridSide{BookSide::Ask, std::vector<Level>(levels)};
     if (logger_) {
         logger_->log("[GridTrading] - Strategy initialized for asset ID: " +
                          std::to_string(asset_id_),
@@ -54,176 +79,199 @@ void GridTrading::initialize() {
     }
 }
 
+/**
+ * @brief Moves both grids to the current mid and fills their empty levels.
+ *
+ * The bid grid starts at the first multiple of grid_interval_ at least
+ * half_spread_ ticks below mid, the ask grid at the first one at least
+ * half_spread_ ticks above it. A side whose position limit is reached is
+ * withdrawn.
+ */
 void GridTrading::on_elapse(core::backtest::BacktestEngine &engine) {
     using namespace core::trading;
-    Depth depth = engine.depth(asset_id_);
-    Quantity position = engine.position(asset_id_);
-    const std::vector<Order> orders = engine.orders(asset_id_);
-
-    double tick_size = depth.tick_size_;
-    double lot_size = depth.lot_size_;
-    Price best_bid = utils::math::ticks_to_price(depth.best_bid_, tick_size);
-    Price best_ask = utils::math::ticks_to_price(depth.best_ask_, tick_size);
-
-    if (best_bid <= 0.0 || best_ask <= 0.0 || !std::isfinite(best_bid) ||
-        !std::isfinite(best_ask)) {
+    const Depth depth = engine.top_depth(asset_id_);
+    const double tick_size = depth.tick_size_;
+    if (depth.best_bid_ == 0 || depth.best_ask_ == 0) {
         if (logger_) {
-            logger_->log("[GridTrading] - Skipping grid setup: invalid bid/ask "
-                         "prices for asset ID: " +
-                             std::to_string(asset_id_) +
-                             " (bid=" + std::to_string(best_bid) +
-                             ", ask=" + std::to_string(best_ask) + ")",
-                         utils::logger::LogLevel::Debug);
+            logger_->log(
+                "[GridTrading] - Skipping grid setup: invalid bid/ask prices "
+                "for asset ID: " +
+                    std::to_string(asset_id_) + " (bid=" +
+                    std::to_string(utils::math::ticks_to_price(depth.best_bid_,
+                                                               tick_size)) +
+                    ", ask=" +
+                    std::to_string(utils::math::ticks_to_price(depth.best_ask_,
+                                                               tick_size)) +
+                    ")",
+                utils::logger::LogLevel::Debug);
         }
         return;
     }
 
-    Price mid_price = (best_bid + best_ask) / 2.0;
+    // twice the mid in ticks, so a mid between two ticks stays exact
+    const auto mid2 =
+        static_cast<std::int64_t>(depth.best_bid_ + depth.best_ask_);
+    const auto step = static_cast<std::int64_t>(grid_interval_);
+    const auto spread = static_cast<std::int64_t>(half_spread_);
+    const std::int64_t bid_nearest =
+        floor_div(mid2 - 2 * spread, 2 * step) * step;
+    const std::int64_t ask_nearest =
+        ceil_div(mid2 + 2 * spread, 2 * step) * step;
 
-    Price bid_price = std::floor((mid_price - half_spread_ * tick_size) /
-                                 (grid_interval_ * tick_size)) *
-                      grid_interval_ * tick_size;
-    Price ask_price = std::ceil((mid_price + half_spread_ * tick_size) /
-                                (grid_interval_ * tick_size)) *
-                      grid_interval_ * tick_size;
+    const Price mid_price =
+        (utils::math::ticks_to_price(depth.best_bid_, tick_size) +
+         utils::math::ticks_to_price(depth.best_ask_, tick_size)) /
+        2.0;
+    const Quantity order_qty =
+        std::round(notional_order_qty_ / mid_price / depth.lot_size_) *
+        depth.lot_size_;
+    const Quantity position = engine.position(asset_id_);
 
-    // Create new bid and ask order grids
-    std::unordered_set<Ticks> new_bid_prices;
+    refresh(engine, bids_);
+    refresh(engine, asks_);
     if (position < position_limit_) {
-        for (int i = 0; i < grid_num_; i++) {
-            const Ticks bid_price_ticks =
-                static_cast<Ticks>(std::floor(bid_price / tick_size));
-            new_bid_prices.insert(bid_price_ticks);
-            bid_price -= grid_interval_ * tick_size;
-        }
+        shift(engine, bids_, bid_nearest);
+    } else {
+        withdraw(engine, bids_);
     }
-    std::unordered_set<Ticks> new_ask_prices;
     if (position > -position_limit_) {
-        for (int i = 0; i < grid_num_; ++i) {
-            const Ticks ask_price_ticks =
-                static_cast<Ticks>(std::ceil(ask_price / tick_size));
-            new_ask_prices.insert(ask_price_ticks);
-            ask_price += grid_interval_ * tick_size;
+        shift(engine, asks_, ask_nearest);
+    } else {
+        withdraw(engine, asks_);
+    }
+    for (GridSide *grid : {&bids_, &asks_}) {
+        if (!grid->active_) continue;
+        for (std::size_t i = 0; i < grid->levels_.size(); ++i) {
+            Level &level = grid->at(i);
+            if (!level.live_) place(engine, *grid, level, tick_size, order_qty);
         }
     }
-    // Cancel orders not in the new grid
-    std::unordered_set<Ticks> existing_bid_prices;
-    std::unordered_set<Ticks> existing_ask_prices;
-    for (const Order &order : orders) {
-        if (order.orderStatus_ == OrderStatus::ACTIVE ||
-            order.orderStatus_ == OrderStatus::PARTIALLY_FILLED) {
-            Ticks order_price_ticks =
-                (order.side_ == BookSide::Bid)
-                    ? static_cast<Ticks>(std::floor(order.price_ / tick_size))
-                    : static_cast<Ticks>(std::ceil(order.price_ / tick_size));
-            // add to existing prices
-            if (order.side_ == BookSide::Bid) {
-                existing_bid_prices.insert(order_price_ticks);
-            } else {
-                existing_ask_prices.insert(order_price_ticks);
-            }
-            // cancel orders not in the new grid
-            if ((order.side_ == BookSide::Bid &&
-                 new_bid_prices.find(order_price_ticks) ==
-                     new_bid_prices.end()) ||
-                (order.side_ == BookSide::Ask &&
-                 new_ask_prices.find(order_price_ticks) ==
-                     new_ask_prices.end())) {
-                engine.cancel_order(asset_id_, order.orderId_);
-                if (logger_) {
-                    if (order.side_ == BookSide::Bid) {
-                        logger_->log(
-                            "[GridTrading] - Cancelled bid order at price: " +
-                                std::to_string(order.price_) +
-                                " for asset ID: " + std::to_string(asset_id_),
-                            utils::logger::LogLevel::Info);
-                    } else {
-                        logger_->log(
-                            "[GridTrading] - Cancelled ask order at price: " +
-                                std::to_string(order.price_) +
-                                " for asset ID: " + std::to_string(asset_id_),
-                            utils::logger::LogLevel::Info);
-                    }
-                }
-            }
+}
+
+/**
+ * @brief Marks levels whose order has filled, been cancelled or expired, or
+ * was never acknowledged in time as empty.
+ */
+void GridTrading::refresh(core::backtest::BacktestEngine &engine,
+                          GridSide &grid) {
+    for (Level &level : grid.levels_) {
+        if (!level.live_) continue;
+        const core::trading::Order *order = engine.order(level.order_id_);
+        if (order) {
+            level.seen_ = true;
+            level.live_ = order->orderStatus_ == OrderStatus::NEW ||
+                          order->orderStatus_ == OrderStatus::ACTIVE ||
+                          order->orderStatus_ == OrderStatus::PARTIALLY_FILLED;
+        } else if (level.seen_ || engine.current_time() > level.ack_by_) {
+            // cleared after it finished, or rejected
+            level.live_ = false;
         }
     }
-    // submit new orders for the grid
-    double raw_qty = notional_order_qty_ / mid_price;
-    Quantity order_qty = std::round(raw_qty / lot_size) * lot_size;
-    for (const Ticks &bid_price_ticks : new_bid_prices) {
-        if (existing_bid_prices.find(bid_price_ticks) ==
-            existing_bid_prices.end()) {
-            Price bid_price = bid_price_ticks * tick_size;
-            if (bid_price_ticks <= 0) {
-                if (logger_) {
-                    logger_->log(
-                        "[GridTrading] - Invalid bid price: " +
-                            std::to_string(bid_price) +
-                            " for asset ID: " + std::to_string(asset_id_) +
-                            ". Skipping order submission.",
-                        utils::logger::LogLevel::Info);
-                }
-                continue;
-            }
-            if (order_qty <= 0.0) {
-                if (logger_) {
-                    logger_->log(
-                        "[GridTrading] - Invalid bid order quantity: " +
-                            std::to_string(order_qty) +
-                            " for asset ID: " + std::to_string(asset_id_) +
-                            ". Skipping order submission.",
-                        utils::logger::LogLevel::Info);
-                }
-                continue;
-            }
-            if (logger_) {
-                logger_->log("[GridTrading] - Submitted buy order : asset_id=" +
-                                 std::to_string(asset_id_) +
-                                 ", price=" + std::to_string(bid_price) +
-                                 ", qty=" + std::to_string(order_qty),
-                             utils::logger::LogLevel::Info);
-            }
-            engine.submit_buy_order(asset_id_, bid_price, order_qty,
-                                 TimeInForce::GTC, OrderType::LIMIT);
+}
+
+/**
+ * @brief Moves a grid so its nearest level is @p nearest, cancelling only the
+ * levels that leave it.
+ *
+ * The ring's head is rotated by the number of grid steps moved, so levels
+ * still in the grid keep their slot and order; the vacated slots are reused
+ * for the entering levels, which are left empty for on_elapse() to fill.
+ */
+void GridTrading::shift(core::backtest::BacktestEngine &engine,
+                        GridSide &grid, std::int64_t nearest) {
+    const std::size_t n = grid.levels_.size();
+    if (n == 0 || (grid.active_ && nearest == grid.nearest_)) return;
+    const auto step = static_cast<std::int64_t>(grid_interval_);
+    const std::int64_t outward = grid.side_ == BookSide::Bid ? -step : step;
+    auto price = [&](std::size_t i) {
+        return nearest + static_cast<std::int64_t>(i) * outward;
+    };
+    // grid steps moved towards mid; negative when it moved away from mid
+    const std::int64_t moved =
+        grid.active_ ? (grid.nearest_ - nearest) / outward
+                     : static_cast<std::int64_t>(n);
+    const auto count = static_cast<std::size_t>(moved < 0 ? -moved : moved);
+
+    if (count >= n) {
+        withdraw(engine, grid);
+        grid.head_ = 0;
+        for (std::size_t i = 0; i < n; ++i) grid.at(i).price_ = price(i);
+    } else if (moved > 0) {
+        // the farthest levels leave; their slots become the nearest
+        for (std::size_t i = n - count; i < n; ++i) cancel(engine, grid.at(i));
+        grid.head_ = (grid.head_ + n - count) % n;
+        for (std::size_t i = 0; i < count; ++i) grid.at(i).price_ = price(i);
+    } else {
+        // the nearest levels leave; their slots become the farthest
+        for (std::size_t i = 0; i < count; ++i) cancel(engine, grid.at(i));
+        grid.head_ = (grid.head_ + count) % n;
+        for (std::size_t i = n - count; i < n; ++i) {
+            grid.at(i).price_ = price(i);
         }
     }
-    for (const Ticks &ask_price_ticks : new_ask_prices) {
-        if (existing_ask_prices.find(ask_price_ticks) ==
-            existing_ask_prices.end()) {
-            Price ask_price = ask_price_ticks * tick_size;
-            if (ask_price <= 0.0) {
-                if (logger_) {
-                    logger_->log(
-                        "[GridTrading] - Invalid ask price: " +
-                            std::to_string(bid_price) +
-                            " for asset ID: " + std::to_string(asset_id_) +
-                            ". Skipping order submission.",
-                        utils::logger::LogLevel::Info);
-                }
-                continue;
-            }
-            if (order_qty <= 0.0) {
-                if (logger_) {
-                    logger_->log(
-                        "[GridTrading] - Invalid ask order quantity: " +
-                            std::to_string(order_qty) +
-                            " for asset ID: " + std::to_string(asset_id_) +
-                            ". Skipping order submission.",
-                        utils::logger::LogLevel::Info);
-                }
-                continue;
-            }
-            engine.submit_sell_order(asset_id_, ask_price, order_qty,
-                                  TimeInForce::GTC, OrderType::LIMIT);
-            if (logger_) {
-                logger_->log("[GridTrading] - Submitted sell order : asset_id=" +
-                                 std::to_string(asset_id_) +
-                                 ", price=" + std::to_string(bid_price) +
-                                 ", qty=" + std::to_string(order_qty),
-                             utils::logger::LogLevel::Info);
-            }
+    grid.nearest_ = nearest;
+    grid.active_ = true;
+}
+
+/**
+ * @brief Cancels every order of a grid and deactivates it.
+ */
+void GridTrading::withdraw(core::backtest::BacktestEngine &engine,
+                           GridSide &grid) {
+    for (Level &level : grid.levels_) cancel(engine, level);
+    grid.active_ = false;
+}
+
+void GridTrading::cancel(core::backtest::BacktestEngine &engine,
+                         Level &level) {
+    if (!level.live_) return;
+    engine.cancel_order(asset_id_, level.order_id_);
+    level.live_ = false;
+    if (logger_) {
+        logger_->log("[GridTrading] - Cancelled order " +
+                         std::to_string(level.order_id_) + " for asset ID: " +
+                         std::to_string(asset_id_),
+                     utils::logger::LogLevel::Info);
+    }
+}
+
+/**
+ * @brief Submits a GTC limit order for an empty level, unless its price or
+ * @p quantity is not positive.
+ */
+void GridTrading::place(core::backtest::BacktestEngine &engine,
+                        GridSide &grid, Level &level, double tick_size,
+                        Quantity quantity) {
+    const Price price = utils::math::ticks_to_price(level.price_, tick_size);
+    if (level.price_ <= 0 || quantity <= 0.0) {
+        if (logger_) {
+            logger_->log("[GridTrading] - Invalid " +
+                             std::string(side_name(grid.side_)) +
+                             " order: price=" + std::to_string(price) +
+                             ", qty=" + std::to_string(quantity) +
+                             " for asset ID: " + std::to_string(asset_id_) +
+                             ". Skipping order submission.",
+                         utils::logger::LogLevel::Info);
         }
+        return;
+    }
+    level.order_id_ =
+        grid.side_ == BookSide::Bid
+            ? engine.submit_buy_order(asset_id_, price, quantity,
+                                      TimeInForce::GTC, OrderType::LIMIT)
+            : engine.submit_sell_order(asset_id_, price, quantity,
+                                       TimeInForce::GTC, OrderType::LIMIT);
+    level.live_ = true;
+    level.seen_ = false;
+    level.ack_by_ = engine.current_time() + engine.order_entry_latency() +
+                    engine.order_response_latency();
+    if (logger_) {
+        logger_->log("[GridTrading] - Submitted " +
+                         std::string(side_name(grid.side_)) +
+                         " order : asset_id=" + std::to_string(asset_id_) +
+                         ", price=" + std::to_string(price) +
+                         ", qty=" + std::to_string(quantity),
+                     utils::logger::LogLevel::Info);
     }
 }
-} // namespace core::strategy
\ No newline at end of file
+} // namespace core::strategy
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -15,10 +17,21 @@
 #include "../../backtest_engine/backtest_engine.h"
 #include "../../trading/depth.h"
 #include "../../types/aliases/usings.h"
+#include "../../types/enums/book_side.h"
 #include "../strategy.h"
 #include "grid_trading_config.h"
 
 namespace core::strategy {
+/**
+ * @brief Reference grid market maker: grid_num_ bids and asks spaced
+ * grid_interval_ ticks apart, starting half_spread_ ticks either side of mid.
+ *
+ * Each side's grid is a ring of tick levels. When mid moves by k grid steps,
+ * only the k levels leaving the grid are cancelled and the k entering it are
+ * placed; levels whose order filled or disappeared are placed again. All
+ * grid math is in integer ticks and on_elapse() allocates nothing. Only
+ * orders the strategy submitted itself are managed.
+ */
 class GridTrading : public Strategy {
   public:
     explicit GridTrading(int asset_id, int grid_num, Ticks grid_interval,
@@ -33,12 +46,42 @@ class GridTrading : public Strategy {
     void on_elapse(core::backtest::BacktestEngine &engine) override;
 
   private:
+    // one grid price and the order of ours resting (or in flight) there
+    struct Level {
+        std::int64_t price_ = 0; // ticks
+        OrderId order_id_ = 0;
+        bool live_ = false;
+        bool seen_ = false;    // the order has been visible locally
+        Timestamp ack_by_ = 0; // latest local ack time while not seen
+    };
+    // one side's grid as a ring of grid_num_ levels, nearest to mid first
+    struct GridSide {
+        BookSide side_;
+        std::vector<Level> levels_;
+        std::size_t head_ = 0;
+        std::int64_t nearest_ = 0; // price of at(0), while active_
+        bool active_ = false;
+        Level &at(std::size_t i) {
+            return levels_[(head_ + i) % levels_.size()];
+        }
+    };
+
+    void refresh(core::backtest::BacktestEngine &engine, GridSide &grid);
+    void shift(core::backtest::BacktestEngine &engine, GridSide &grid,
+               std::int64_t nearest);
+    void withdraw(core::backtest::BacktestEngine &engine, GridSide &grid);
+    void cancel(core::backtest::BacktestEngine &engine, Level &level);
+    void place(core::backtest::BacktestEngine &engine, GridSide &grid,
+               Level &level, double tick_size, Quantity quantity);
+
     int asset_id_;
     int grid_num_;
     Ticks grid_interval_;
     Ticks half_spread_;
     double position_limit_;
     double notional_order_qty_;
+    GridSide bids_;
+    GridSide asks_;
 
     std::shared_ptr<utils::logger::Logger> logger_;
 };
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "../../../utils/logger/logger.h"
+#include "../../backtest_engine/backtest_engine.h"
+#include "../../trading/depth.h"
+#include "../../types/aliases/usings.h"
+#include "../strategy.h"
+#include "grid_trading_config.h"
+
+namespace core::strategy {
+/**
+ * @brief Previous GridTrading, which rebuilds both grids as hash sets and
+ * scans every order each interval. Kept as the baseline for the benchmark's
+ * rebuild mode.
+ */
+class RebuildGridTrading : public Strategy {
+  public:
+    explicit RebuildGridTrading(int asset_id, int grid_num,
+                                Ticks grid_interval, Ticks half_spread,
+                                double position_limit,
+                                double notional_order_qty,
+                                std::shared_ptr<utils::logger::Logger> logger);
+    explicit RebuildGridTrading(
+        int asset_id, const core::strategy::GridTradingConfig &config,
+        std::shared_ptr<utils::logger::Logger> logger = nullptr);
+
+    void initialize() override;
+    void on_elapse(core::backtest::BacktestEngine &engine) override;
+
+  private:
+    int asset_id_;
+    int grid_num_;
+    Ticks grid_interval_;
+    Ticks half_spread_;
+    double position_limit_;
+    double notional_order_qty_;
+
+    std::shared_ptr<utils::logger::Logger> logger_;
+};
+} // namespace core::strategy
\ No newline at end of file
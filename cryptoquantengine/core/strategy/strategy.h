@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -23,6 +24,9 @@ class Strategy {
 
     virtual void initialize() = 0;
     virtual void on_elapse(core::backtest::BacktestEngine &engine) = 0;
+    // called for timers set with BacktestEngine::schedule_timer
+    virtual void on_timer(core::backtest::BacktestEngine &,
+                          std::uint64_t /*tag*/) {}
 
   private:
 };
@@ -23,5 +23,14 @@ struct AssetConfig {
     double taker_fee_;
 
     std::string name_;
+
+    // order-level (L3) event file; when set it replaces book_update_file_
+    std::string order_file_;
+    // best bid/offer file; when set the asset is simulated top-of-book only
+    std::string quote_file_;
+    // book checkpoint side-car of book_update_file_ (see book_checkpoint);
+    // with a start time in the engine config, replay starts from the nearest
+    // checkpoint instead of the top of the file
+    std::string book_checkpoint_file_;
 };
 } // namespace core::trading
\ No newline at end of file
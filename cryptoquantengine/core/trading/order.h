@@ -26,5 +26,8 @@ struct Order {
     OrderType orderType_;
     Quantity queueEst_;
     OrderStatus orderStatus_;
+    Price stop_price_ = 0.0;    // STOP_MARKET and STOP_LIMIT orders only
+    Timestamp expire_time_ = 0; // GTD orders only
+    bool queue_known_ = true;   // false behind a top-of-book-only touch
 };
 } 
\ No newline at end of file
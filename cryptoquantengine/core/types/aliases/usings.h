@@ -8,7 +8,6 @@
 #pragma once
 
 #include <cstdint>
-#include <variant>
 
 using Timestamp = std::uint64_t;
 using OrderId = std::uint64_t;
@@ -17,11 +16,3 @@ using Price = double;
 using Quantity = double;
 using Position = double;
 using Microseconds = std::uint64_t;
-
-namespace core::market_data {
-struct BookUpdate;
-struct Trade;
-} // namespace core::market_data
-
-using MarketEvent =
-    std::variant<core::market_data::BookUpdate, core::market_data::Trade>;
\ No newline at end of file
@@ -11,6 +11,7 @@ enum class ActionType {
     SubmitSell,
     Cancel,
     LocalProcessFill,
-    LocalBookUpdate,
-    LocalOrderUpdate
+    LocalOrderUpdate,
+    Timer,
+    Expire // exchange expires a GTD order
 };
\ No newline at end of file
@@ -10,5 +10,8 @@ enum class EventType
 {
     None,
     Trade,
-    BookUpdate
+    BookUpdate,
+    BookUpdateBatch,
+    MboUpdate,
+    Quote
 };
\ No newline at end of file
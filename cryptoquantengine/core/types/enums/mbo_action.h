@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+enum class MboAction
+{
+    Add,
+    Modify,
+    Delete
+};
@@ -7,4 +7,10 @@
 
 #pragma once
 
-enum class OrderEventType { FILL, CANCELLED, REJECTED, ACKNOWLEDGED };
\ No newline at end of file
+enum class OrderEventType {
+    FILL,
+    CANCELLED,
+    REJECTED,
+    ACKNOWLEDGED,
+    EXPIRED
+};
\ No newline at end of file
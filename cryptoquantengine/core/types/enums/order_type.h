@@ -10,5 +10,7 @@
 enum class OrderType
 {
     LIMIT,
-    MARKET
+    MARKET,
+    STOP_MARKET, // market order once the stop price is reached
+    STOP_LIMIT   // limit order once the stop price is reached
 };
\ No newline at end of file
@@ -12,5 +12,6 @@ enum class TimeInForce
     GTC, // good till cancel
     GTX, // good till crossing
     FOK, // fill or kill
-    IOC  // immediate or cancel
+    IOC, // immediate or cancel
+    GTD  // good till date: as GTC until the order's expire time
 };
\ No newline at end of file
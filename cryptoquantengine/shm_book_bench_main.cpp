@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/market_data/book_update.h"
+#include "core/market_data/live/live_book_publisher.h"
+#include "core/market_data/live/shm_book.h"
+#include "core/types/enums/book_side.h"
+#include "core/types/enums/update_type.h"
+
+namespace {
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct ReaderStats {
+    std::vector<std::int64_t> staleness_ns_; // publish to copy completed
+    std::int64_t read_ns_ = 0;               // total time inside read()
+    std::uint64_t reads_ = 0;
+    std::uint64_t failed_attempts_ = 0; // try_read calls that lost a race
+};
+
+std::int64_t percentile(const std::vector<std::int64_t> &sorted, double q) {
+    if (sorted.empty()) return 0;
+    return sorted[static_cast<std::size_t>(q * (sorted.size() - 1))];
+}
+} // namespace
+
+// Publishes a synthetic book through LiveBookPublisher while reader threads,
+// each with its own mapping, copy every new frame. Reports how stale frames
+// are when a reader has them and what a read costs.
+int main(int argc, char *argv[]) {
+    const int readers = (argc > 1) ? std::stoi(argv[1]) : 2;
+    const double seconds = (argc > 2) ? std::stod(argv[2]) : 5.0;
+    const std::int64_t interval_ns = (argc > 3) ? std::stoll(argv[3]) : 10000;
+    const bool top_only = argc > 4 && std::string(argv[4]) == "top";
+    const std::string shm_name = "/cqe_shm_book_bench";
+
+    try {
+        core::market_data::live::LiveBookPublisher publisher(
+            shm_name, "BENCH", 0.0001, 0.1, 10);
+        std::vector<ReaderStats> stats(readers);
+        std::atomic<bool> running{true};
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r] {
+                core::market_data::live::ShmBookReader reader(shm_name);
+                core::market_data::live::ShmBookFrame frame;
+                ReaderStats &mine = stats[r];
+                mine.staleness_ns_.reserve(
+                    static_cast<std::size_t>(seconds * 1e9 / interval_ns));
+                std::uint64_t seen = reader.sequence();
+                while (running.load(std::memory_order_relaxed)) {
+                    const std::uint64_t sequence = reader.sequence();
+                    if (sequence == seen || (sequence & 1)) continue;
+                    const std::int64_t start = now_ns();
+                    bool ok = top_only ? reader.try_read(frame.top_)
+                                       : reader.try_read(frame);
+                    while (!ok) {
+                        ++mine.failed_attempts_;
+                        ok = top_only ? reader.try_read(frame.top_)
+                                      : reader.try_read(frame);
+                    }
+                    const std::int64_t end = now_ns();
+                    mine.read_ns_ += end - start;
+                    ++mine.reads_;
+                    mine.staleness_ns_.push_back(end -
+                                                 frame.top_.published_ns_);
+                    seen = sequence;
+                }
+            });
+        }
+
+        // a random walk around 2.8 with one changed level per message
+        std::vector<core::market_data::BookUpdate> message(1);
+        std::uint64_t published = 0;
+        std::uint64_t state = 88172645463325252ull;
+        const std::int64_t end = now_ns() + static_cast<std::int64_t>(
+                                                seconds * 1e9);
+        for (std::int64_t next = now_ns(); next < end; next += interval_ns) {
+            while (now_ns() < next) {
+            }
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            auto &update = message[0];
+            update.exch_timestamp_ = update.local_timestamp_ =
+                static_cast<Timestamp>(next / 1000);
+            update.update_type_ = UpdateType::Incremental;
+            update.side_ = (state & 1) ? BookSide::Bid : BookSide::Ask;
+            const int offset = 1 + static_cast<int>((state >> 1) % 20);
+            update.price_ = (update.side_ == BookSide::Bid ? 28000 - offset
+                                                           : 28000 + offset) *
+                            0.0001;
+            update.quantity_ = static_cast<double>((state >> 8) % 1000) * 0.1;
+            publisher.publish_book(message);
+            ++published;
+        }
+        running = false;
+        for (auto &thread : threads) thread.join();
+
+        std::cout << "Frames published:      " << published << '\n'
+                  << "Read:                  "
+                  << (top_only ? "top only" : "full frame") << '\n';
+        for (int r = 0; r < readers; ++r) {
+            auto &samples = stats[r].staleness_ns_;
+            std::sort(samples.begin(), samples.end());
+            const double mean_read =
+                stats[r].reads_ > 0
+                    ? static_cast<double>(stats[r].read_ns_) / stats[r].reads_
+                    : 0.0;
+            std::cout << "reader " << r << ": frames=" << stats[r].reads_
+                      << " read_ns=" << mean_read
+                      << " retries=" << stats[r].failed_attempts_
+                      << " staleness_ns p50=" << percentile(samples, 0.5)
+                      << " p99=" << percentile(samples, 0.99)
+                      << " p99.9=" << percentile(samples, 0.999)
+                      << " max=" << percentile(samples, 1.0) << '\n';
+        }
+        return 0;
+    } catch (const std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 2;
+    }
+}
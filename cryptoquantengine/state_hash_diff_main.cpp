@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "core/backtest_engine/state_hasher.h"
+
+// Compares the state hash checkpoints of two runs (see state_hash_interval in
+// backtest_engine_config.txt) and reports where they first diverge.
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: state_hash_diff <baseline.csv> <candidate.csv>\n";
+        return 2;
+    }
+    try {
+        using core::backtest::StateHasher;
+        const auto baseline = StateHasher::read(argv[1]);
+        const auto candidate = StateHasher::read(argv[2]);
+        const auto divergence =
+            StateHasher::first_divergence(baseline, candidate);
+        if (!divergence) {
+            std::cout << "Runs match: " << baseline.size()
+                      << " checkpoints, "
+                      << (baseline.empty() ? 0 : baseline.back().event_)
+                      << " events\n";
+            return 0;
+        }
+        std::cout << "Runs diverge at checkpoint event " << divergence->event_
+                  << " (timestamp " << divergence->timestamp_ << "us)\n"
+                  << "First diverging event is in ("
+                  << divergence->last_matching_event_ << ", "
+                  << divergence->event_
+                  << "]; rerun both with state_hash_interval=1 to pinpoint "
+                     "it.\n";
+        return 1;
+    } catch (const std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 2;
+    }
+}
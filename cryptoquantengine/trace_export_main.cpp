@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "utils/trace/trace_export.h"
+
+// Converts a binary event trace (see trace_file in
+// backtest_engine_config.txt) to Chrome trace JSON, for chrome://tracing or
+// ui.perfetto.dev.
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: trace_export <trace.bin> <trace.json>\n";
+        return 2;
+    }
+    try {
+        const auto records = utils::trace::read_trace(argv[1]);
+        std::ofstream out(argv[2]);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open output file: " << argv[2] << "\n";
+            return 2;
+        }
+        utils::trace::write_chrome_trace(records, out);
+        std::cout << "Exported " << records.size() << " events to "
+                  << argv[2] << "\n";
+        return 0;
+    } catch (const std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 2;
+    }
+}
@@ -17,6 +17,7 @@
 #include "../../core/recorder/recorder_config.h"
 #include "../../core/strategy/grid_trading/grid_trading_config.h"
 #include "../../core/trading/asset_config.h"
+#include "../thread/thread_placement.h"
 #include "config_reader.h"
 
 namespace utils::config {
@@ -96,6 +97,21 @@ int ConfigReader::get_int(const std::string &key) const {
     }
 }
 
+/*
+ * given a key, returns an unsigned 64-bit integer (e.g. a timestamp) from
+ * filename if exists.
+ */
+std::uint64_t ConfigReader::get_uint64(const std::string &key) const {
+    std::string value = get_string(key);
+    try {
+        return std::stoull(value);
+    } catch (const std::exception &ex) {
+        throw std::invalid_argument("Failed to convert key '" + key +
+                                    "' with value '" + value +
+                                    "' to uint64: " + ex.what());
+    }
+}
+
 /*
  * given a key, checks if key exists in the config file
  */
@@ -113,7 +129,12 @@ ConfigReader::get_asset_config(const std::string &filename) {
     clear();
     load(filename);
     AssetConfig config;
-    config.book_update_file_ = get_string("book_update_file");
+    // an order-level (L3) or quote file can stand in for the price-level
+    // book file
+    config.book_update_file_ =
+        ((has("order_file") || has("quote_file")) && !has("book_update_file"))
+            ? ""
+            : get_string("book_update_file");
     config.trade_file_ = get_string("trade_file");
     config.tick_size_ = get_double("tick_size");
     config.lot_size_ = get_double("lot_size");
@@ -123,6 +144,10 @@ ConfigReader::get_asset_config(const std::string &filename) {
     config.maker_fee_ = get_double("maker_fee");
     config.taker_fee_ = get_double("taker_fee");
     config.name_ = has("name") ? get_string("name") : "UNKNOWN_ASSET";
+    config.order_file_ = has("order_file") ? get_string("order_file") : "";
+    config.quote_file_ = has("quote_file") ? get_string("quote_file") : "";
+    config.book_checkpoint_file_ =
+        has("book_checkpoint_file") ? get_string("book_checkpoint_file") : "";
     return config;
 }
 /*
@@ -156,6 +181,19 @@ ConfigReader::get_backtest_engine_config(const std::string &filename) {
     config.order_entry_latency_us_ = get_int("order_entry_latency_us");
     config.order_response_latency_us_ = get_int("order_response_latency_us");
     config.market_feed_latency_us_ = get_int("market_feed_latency_us");
+    config.aggregate_trades_ =
+        has("aggregate_trades") ? get_int("aggregate_trades") != 0 : false;
+    if (has("state_hash_interval")) {
+        config.state_hash_interval_ =
+            static_cast<std::uint64_t>(get_int("state_hash_interval"));
+    }
+    if (has("state_hash_file")) {
+        config.state_hash_file_ = get_string("state_hash_file");
+    }
+    if (has("start_time_us")) {
+        config.start_time_us_ = get_uint64("start_time_us");
+    }
+    if (has("trace_file")) config.trace_file_ = get_string("trace_file");
     return config;
 }
 /*
@@ -182,5 +220,60 @@ ConfigReader::get_backtest_config(const std::string &filename) {
     config.iterations = has("iterations") ? get_int("iterations") : 86400;
     return config;
 }
+/*
+ * @brief Reads the thread placement configuration from a file.
+ *
+ * For each role (sim, logger, ws_io, parser, writer, pool) the keys
+ * <role>_cpus (e.g. 2,3 or 4-7) and <role>_priority (SCHED_FIFO priority,
+ * 1-99) are optional; roles without either are left unplaced.
+ */
+utils::thread::ThreadPlacementConfig
+ConfigReader::get_thread_placement_config(const std::string &filename) {
+    using namespace utils::thread;
+    clear();
+    load(filename);
+    ThreadPlacementConfig config;
+    for (ThreadRole role : kThreadRoles) {
+        const std::string prefix(to_string(role));
+        const std::string cpus_key = prefix + "_cpus";
+        const std::string priority_key = prefix + "_priority";
+        if (!has(cpus_key) && !has(priority_key)) continue;
+
+        ThreadPlacement placement;
+        if (has(cpus_key)) {
+            std::istringstream cpus(get_string(cpus_key));
+            std::string item;
+            while (std::getline(cpus, item, ',')) {
+                try {
+                    const auto dash = item.find('-');
+                    const int first = std::stoi(item.substr(0, dash));
+                    const int last = (dash == std::string::npos)
+                                         ? first
+                                         : std::stoi(item.substr(dash + 1));
+                    if (first < 0 || last < first) {
+                        throw std::out_of_range(item);
+                    }
+                    for (int cpu = first; cpu <= last; ++cpu) {
+                        placement.cpus_.push_back(cpu);
+                    }
+                } catch (const std::exception &) {
+                    throw std::invalid_argument("Invalid CPU list for key '" +
+                                                cpus_key + "': " +
+                                                get_string(cpus_key));
+                }
+            }
+        }
+        if (has(priority_key)) {
+            placement.fifo_priority_ = get_int(priority_key);
+            if (placement.fifo_priority_ < 0 || placement.fifo_priority_ > 99) {
+                throw std::invalid_argument(
+                    "SCHED_FIFO priority must be in [0, 99] for key '" +
+                    priority_key + "'");
+            }
+        }
+        config.placements_[role] = std::move(placement);
+    }
+    return config;
+}
 
 } // namespace utils::config
\ No newline at end of file
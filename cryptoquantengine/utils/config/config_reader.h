@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -15,6 +16,7 @@
 #include "../../core/trading/asset_config.h"
 #include "../../core/backtest_engine/backtest_config.h"
 #include "../../core/backtest_engine/backtest_engine_config.h"
+#include "../thread/thread_placement.h"
 
 namespace utils::config {
 class ConfigReader {
@@ -27,6 +29,8 @@ class ConfigReader {
     get_backtest_engine_config(const std::string &filename);
     RecorderConfig get_recorder_config(const std::string &filename);
     core::backtest::BacktestConfig get_backtest_config(const std::string &filename);
+    utils::thread::ThreadPlacementConfig
+    get_thread_placement_config(const std::string &filename);
 
   private:
     std::unordered_map<std::string, std::string> constants;
@@ -34,6 +38,7 @@ class ConfigReader {
     std::string get_string(const std::string &key) const;
     double get_double(const std::string &key) const;
     int get_int(const std::string &key) const;
+    std::uint64_t get_uint64(const std::string &key) const;
     bool has(const std::string &key) const;
 
     void load(const std::string &filename);
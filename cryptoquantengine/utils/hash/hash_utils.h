@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace utils::hash {
+/**
+ * @brief Scrambles a 64-bit value (splitmix64 finaliser).
+ */
+inline std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Folds a value into a running hash; the result depends on order.
+ */
+inline std::uint64_t combine(std::uint64_t seed, std::uint64_t value) {
+    return mix(seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) +
+                       (seed >> 2)));
+}
+
+/**
+ * @brief Folds the bit pattern of a double; -0.0 and 0.0 hash alike.
+ */
+inline std::uint64_t combine_double(std::uint64_t seed, double value) {
+    // memcpy rather than std::bit_cast: the C++17 stream target includes this
+    std::uint64_t bits;
+    value += 0.0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return combine(seed, bits);
+}
+} // namespace utils::hash
@@ -14,6 +14,7 @@
 #include <string>
 #include <thread>
 
+#include "../thread/thread_placement.h"
 #include "logger.h"
 #include "log_level.h"
 
@@ -69,6 +70,8 @@ void Logger::flush() {
  * Listens for new messages and writes them to the log file until the exit.
  */
 void Logger::process() {
+    utils::thread::place_current_thread(utils::thread::ThreadRole::Logger,
+                                        "logger");
     while (true) {
         std::unique_lock<std::mutex> lock(mutex_);
         cond_var_.wait(lock,
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace utils::memory {
+enum class PageBacking {
+    Explicit,    // MAP_HUGETLB from the reserved huge page pool
+    Transparent, // 2 MB aligned mapping advised with MADV_HUGEPAGE
+    Default      // regular pages (non-Linux fallback)
+};
+
+/**
+ * @brief Memory resource that maps its allocations onto 2 MB huge pages.
+ *
+ * Each allocation is rounded up to a multiple of 2 MB and mapped with
+ * MAP_HUGETLB. When no explicit huge pages are reserved
+ * (/proc/sys/vm/nr_hugepages is 0) the mapping falls back to a 2 MB aligned
+ * anonymous mapping advised with MADV_HUGEPAGE, which transparent huge pages
+ * back when THP is set to "always" or "madvise". Off Linux it forwards to
+ * new/delete.
+ *
+ * Meant as the upstream of a RunArena, which requests few, large blocks; it is
+ * wasteful for small allocations.
+ */
+class HugePageResource : public std::pmr::memory_resource {
+  public:
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    /**
+     * @brief Returns how the most recent allocation was backed.
+     */
+    PageBacking last_backing() const { return last_backing_; }
+
+  private:
+    PageBacking last_backing_ = PageBacking::Default;
+
+    static std::size_t rounded(std::size_t bytes) {
+        return (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    }
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+#if defined(__linux__)
+        (void)alignment; // huge page alignment covers any request
+        const std::size_t size = rounded(bytes);
+        void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            last_backing_ = PageBacking::Explicit;
+            return p;
+        }
+        // over-map by one huge page so the start can be aligned, then trim
+        const std::size_t padded = size + kHugePageSize;
+        p = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        const auto raw = reinterpret_cast<std::uintptr_t>(p);
+        const std::uintptr_t start =
+            (raw + kHugePageSize - 1) & ~(kHugePageSize - 1);
+        if (start > raw) munmap(p, start - raw);
+        const std::uintptr_t tail = raw + padded - (start + size);
+        if (tail > 0) munmap(reinterpret_cast<void *>(start + size), tail);
+        madvise(reinterpret_cast<void *>(start), size, MADV_HUGEPAGE);
+        last_backing_ = PageBacking::Transparent;
+        return reinterpret_cast<void *>(start);
+#else
+        last_backing_ = PageBacking::Default;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+#endif
+    }
+
+    void do_deallocate(void *p, std::size_t bytes,
+                       std::size_t alignment) override {
+#if defined(__linux__)
+        (void)alignment;
+        munmap(p, rounded(bytes));
+#else
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+#endif
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+} // namespace utils::memory
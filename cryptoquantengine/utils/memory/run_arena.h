@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+namespace utils::memory {
+/**
+ * @brief Allocation arena for one backtest run, released wholesale between
+ * runs.
+ *
+ * Allocations go to an unsynchronized pool, so node containers that erase and
+ * re-insert (book levels, maker orders, delayed actions) recycle their nodes.
+ * The pool draws from a monotonic buffer that carves chunks out of a block the
+ * arena owns. reset() drops everything at once and, if the last run spilled
+ * past the block, grows the block to cover it, so a worker running many
+ * similar backtests stops calling the system allocator after its first run.
+ *
+ * Not thread-safe: give each sweep worker its own arena. Every container
+ * using resource() must be destroyed before reset() is called.
+ */
+class RunArena {
+  public:
+    /**
+     * @param initial_bytes Size of the first block.
+     * @param upstream Resource the block and any overflow come from, e.g. a
+     * HugePageResource to back the run with 2 MB pages. Must outlive the
+     * arena.
+     */
+    explicit RunArena(
+        std::size_t initial_bytes = std::size_t{1} << 20,
+        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream), overflow_(upstream) {
+        allocate_block(initial_bytes);
+        rebuild();
+    }
+
+    ~RunArena() {
+        pool_.reset();
+        monotonic_.reset();
+        upstream_->deallocate(block_, block_size_, kBlockAlignment);
+    }
+
+    RunArena(const RunArena &) = delete;
+    RunArena &operator=(const RunArena &) = delete;
+
+    /**
+     * @brief Returns the resource engine containers should allocate from.
+     */
+    std::pmr::memory_resource *resource() { return &*pool_; }
+
+    /**
+     * @brief Releases every allocation made since the last reset.
+     */
+    void reset() {
+        pool_.reset();
+        monotonic_.reset();
+        if (overflow_.bytes_ > 0) {
+            const std::size_t grown = block_size_ + overflow_.bytes_;
+            upstream_->deallocate(block_, block_size_, kBlockAlignment);
+            allocate_block(grown);
+        }
+        overflow_.bytes_ = 0;
+        rebuild();
+    }
+
+    /**
+     * @brief Returns the size of the block owned by the arena.
+     */
+    std::size_t capacity() const { return block_size_; }
+
+    /**
+     * @brief Returns the bytes requested from upstream since the last reset,
+     * i.e. how far the current run has outgrown capacity().
+     */
+    std::size_t overflow_bytes() const { return overflow_.bytes_; }
+
+  private:
+    static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+    // forwards to upstream and counts what the monotonic buffer spills
+    struct OverflowResource : std::pmr::memory_resource {
+        explicit OverflowResource(std::pmr::memory_resource *upstream)
+            : upstream_(upstream) {}
+
+        std::pmr::memory_resource *upstream_;
+        std::size_t bytes_ = 0;
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+            bytes_ += bytes;
+            return upstream_->allocate(bytes, alignment);
+        }
+        void do_deallocate(void *p, std::size_t bytes,
+                           std::size_t alignment) override {
+            upstream_->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(
+            const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    std::pmr::memory_resource *upstream_;
+    void *block_ = nullptr;
+    std::size_t block_size_ = 0;
+    OverflowResource overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+    std::optional<std::pmr::unsynchronized_pool_resource> pool_;
+
+    void allocate_block(std::size_t bytes) {
+        block_ = upstream_->allocate(bytes, kBlockAlignment);
+        block_size_ = bytes;
+    }
+
+    void rebuild() {
+        monotonic_.emplace(block_, block_size_, &overflow_);
+        pool_.emplace(&*monotonic_);
+    }
+};
+} // namespace utils::memory
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace utils::thread {
+struct NumaNode {
+    int id_;
+    std::vector<int> cpus_;
+};
+
+/**
+ * @brief Parses a kernel CPU list such as "0-3,8,10-11".
+ *
+ * Malformed entries are skipped.
+ */
+inline std::vector<int> parse_cpu_list(std::string_view list) {
+    std::vector<int> cpus;
+    while (!list.empty()) {
+        const std::size_t comma = list.find(',');
+        std::string entry(list.substr(0, comma));
+        list = comma == std::string_view::npos ? std::string_view{}
+                                               : list.substr(comma + 1);
+        entry.erase(
+            std::remove_if(entry.begin(), entry.end(),
+                           [](char c) { return c == ' ' || c == '\n'; }),
+            entry.end());
+        if (entry.empty()) continue;
+        try {
+            const std::size_t dash = entry.find('-');
+            const int first = std::stoi(entry.substr(0, dash));
+            const int last = dash == std::string::npos
+                                 ? first
+                                 : std::stoi(entry.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        } catch (const std::exception &) {
+        }
+    }
+    return cpus;
+}
+
+/**
+ * @brief Returns the machine's NUMA nodes and their CPUs, lowest node first.
+ *
+ * Read from /sys/devices/system/node; nodes without CPUs are left out. Where
+ * that is unavailable (non-Linux, containers hiding sysfs) the machine is
+ * reported as a single node 0 holding every hardware thread.
+ */
+inline std::vector<NumaNode> numa_topology() {
+    std::vector<NumaNode> nodes;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(
+             "/sys/devices/system/node", ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+            !std::all_of(name.begin() + 4, name.end(),
+                         [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+        std::ifstream in(entry.path() / "cpulist");
+        std::string list;
+        std::getline(in, list);
+        auto cpus = parse_cpu_list(list);
+        if (!cpus.empty()) {
+            nodes.push_back(
+                NumaNode{std::stoi(name.substr(4)), std::move(cpus)});
+        }
+    }
+    if (nodes.empty()) {
+        NumaNode node{0, {}};
+        const unsigned count =
+            std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu) {
+            node.cpus_.push_back(static_cast<int>(cpu));
+        }
+        nodes.push_back(std::move(node));
+    }
+    std::sort(nodes.begin(), nodes.end(),
+              [](const NumaNode &a, const NumaNode &b) {
+                  return a.id_ < b.id_;
+              });
+    return nodes;
+}
+} // namespace utils::thread
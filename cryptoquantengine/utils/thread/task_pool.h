@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_placement.h"
+
+namespace utils::thread {
+/**
+ * @brief Order in which queued pool tasks are picked up: every High task
+ * anywhere in the pool runs before any Normal task, and so on.
+ */
+enum class TaskPriority : std::uint8_t {
+    High,   // on the simulation's critical path
+    Normal, // file ingestion and decoding
+    Low     // long batch work such as sweep runs
+};
+
+inline constexpr std::size_t kTaskPriorities = 3;
+
+class TaskPool;
+
+namespace detail {
+// set on pool worker threads only
+inline thread_local TaskPool *current_pool = nullptr;
+inline thread_local std::size_t current_worker = 0;
+} // namespace detail
+
+/**
+ * @brief Work-stealing task pool shared by every parallel subsystem.
+ *
+ * Each worker owns one deque per priority. Tasks submitted from a worker go
+ * to the back of its own deque and are popped from there (newest first, while
+ * still cache-hot); idle workers steal from the front of other workers'
+ * deques. Tasks submitted from outside the pool go to a shared injection
+ * queue. Workers are named and placed with ThreadRole::Pool.
+ *
+ * Use instance() rather than creating pools, so the number of busy threads is
+ * bounded in one place. Do not block on a submit() future from inside a pool
+ * task; parallel_for() is safe to nest because its caller runs chunks itself.
+ */
+class TaskPool {
+  public:
+    explicit TaskPool(unsigned threads) {
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.push_back(std::make_unique<Queues>());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            threads_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    /**
+     * @brief Runs every task still queued, then joins the workers.
+     */
+    ~TaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &thread : threads_) thread.join();
+    }
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+
+    /**
+     * @brief The process-wide pool: one worker per hardware thread but one,
+     * since parallel_for() callers work alongside the pool.
+     */
+    static TaskPool &instance() {
+        static TaskPool pool(
+            std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    /**
+     * @brief Number of worker threads, not counting parallel_for() callers.
+     */
+    std::size_t size() const { return threads_.size(); }
+
+    /**
+     * @brief Number of tasks taken from another worker's deque so far.
+     */
+    std::uint64_t steals() const { return steals_.load(); }
+
+    /**
+     * @brief Queues @p fn and returns a future for its result or exception.
+     *
+     * With no worker threads the task runs inline before returning.
+     */
+    template <typename Fn>
+    auto submit(Fn &&fn, TaskPriority priority = TaskPriority::Normal)
+        -> std::future<std::invoke_result_t<Fn>> {
+        using Result = std::invoke_result_t<Fn>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<Fn>(fn));
+        auto future = task->get_future();
+        if (threads_.empty()) {
+            (*task)();
+        } else {
+            push([task] { (*task)(); }, priority);
+        }
+        return future;
+    }
+
+    /**
+     * @brief Calls @p body(i) for every i in [begin, end) and returns once all
+     * calls have finished.
+     *
+     * Indices are claimed in chunks of @p grain by the caller and by up to
+     * size() helper tasks. The caller keeps claiming chunks until none are
+     * left and then only waits for chunks already running, so nested calls
+     * from pool tasks cannot deadlock.
+     *
+     * @throws The first exception thrown by @p body, after every claimed
+     * chunk has finished.
+     */
+    void parallel_for(std::size_t begin, std::size_t end,
+                      const std::function<void(std::size_t)> &body,
+                      TaskPriority priority = TaskPriority::Normal,
+                      std::size_t grain = 1) {
+        if (end <= begin) return;
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks == 1 || threads_.empty()) {
+            for (std::size_t i = begin; i < end; ++i) body(i);
+            return;
+        }
+
+        struct State {
+            std::atomic<std::size_t> next_{0};
+            std::size_t done_ = 0;
+            std::mutex mutex_;
+            std::condition_variable finished_;
+            std::exception_ptr error_;
+        };
+        auto state = std::make_shared<State>();
+        // helpers that start after every chunk is claimed never touch body
+        auto run_chunks = [state, chunks, begin, end, grain, &body] {
+            for (std::size_t chunk = state->next_++; chunk < chunks;
+                 chunk = state->next_++) {
+                std::exception_ptr error;
+                try {
+                    const std::size_t first = begin + chunk * grain;
+                    const std::size_t last = std::min(end, first + grain);
+                    for (std::size_t i = first; i < last; ++i) body(i);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(state->mutex_);
+                if (error && !state->error_) state->error_ = error;
+                if (++state->done_ == chunks) state->finished_.notify_all();
+            }
+        };
+        const std::size_t helpers = std::min(chunks - 1, threads_.size());
+        for (std::size_t h = 0; h < helpers; ++h) push(run_chunks, priority);
+        run_chunks();
+
+        std::unique_lock<std::mutex> lock(state->mutex_);
+        state->finished_.wait(lock, [&] { return state->done_ == chunks; });
+        if (state->error_) std::rethrow_exception(state->error_);
+    }
+
+  private:
+    using Task = std::function<void()>;
+
+    struct Queues {
+        std::mutex mutex_;
+        std::array<std::deque<Task>, kTaskPriorities> tasks_;
+    };
+
+    void push(Task task, TaskPriority priority) {
+        const bool own = detail::current_pool == this;
+        Queues &queues = own ? *workers_[detail::current_worker] : injection_;
+        {
+            std::lock_guard<std::mutex> lock(queues.mutex_);
+            queues.tasks_[static_cast<std::size_t>(priority)].push_back(
+                std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            ++queued_;
+        }
+        wake_.notify_one();
+    }
+
+    static bool take(Queues &queues, std::size_t priority, bool back,
+                     Task &task) {
+        std::lock_guard<std::mutex> lock(queues.mutex_);
+        auto &deque = queues.tasks_[priority];
+        if (deque.empty()) return false;
+        if (back) {
+            task = std::move(deque.back());
+            deque.pop_back();
+        } else {
+            task = std::move(deque.front());
+            deque.pop_front();
+        }
+        return true;
+    }
+
+    // own deque (newest first), then the injection queue, then steals
+    bool try_take(std::size_t self, Task &task) {
+        for (std::size_t p = 0; p < kTaskPriorities; ++p) {
+            if (take(*workers_[self], p, true, task)) return true;
+            if (take(injection_, p, false, task)) return true;
+            for (std::size_t k = 1; k < workers_.size(); ++k) {
+                if (take(*workers_[(self + k) % workers_.size()], p, false,
+                         task)) {
+                    ++steals_;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(std::size_t index) {
+        detail::current_pool = this;
+        detail::current_worker = index;
+        place_current_thread(ThreadRole::Pool,
+                             "pool-" + std::to_string(index));
+        Task task;
+        while (true) {
+            if (try_take(index, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                    --queued_;
+                }
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return queued_ > 0 || stop_; });
+            if (stop_ && queued_ == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queues>> workers_;
+    Queues injection_; // tasks submitted from outside the pool
+    std::vector<std::thread> threads_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::size_t queued_ = 0; // guarded by sleep_mutex_
+    bool stop_ = false;      // guarded by sleep_mutex_
+    std::atomic<std::uint64_t> steals_{0};
+};
+
+/**
+ * @brief Runs @p body(i) for every i in [begin, end) on the process-wide pool.
+ */
+inline void parallel_for(std::size_t begin, std::size_t end,
+                         const std::function<void(std::size_t)> &body,
+                         TaskPriority priority = TaskPriority::Normal,
+                         std::size_t grain = 1) {
+    TaskPool::instance().parallel_for(begin, end, body, priority, grain);
+}
+} // namespace utils::thread
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace utils::thread {
+/**
+ * @brief What a thread does; each role gets its own CPU set and priority.
+ */
+enum class ThreadRole : std::uint8_t {
+    Sim,    // the simulation loop
+    Logger, // asynchronous log writer
+    WsIo,   // websocket and REST network I/O
+    Parser, // websocket message parsing
+    Writer, // capture CSV writer
+    Pool    // shared task pool workers (see task_pool.h)
+};
+
+inline constexpr std::array<ThreadRole, 6> kThreadRoles = {
+    ThreadRole::Sim,    ThreadRole::Logger, ThreadRole::WsIo,
+    ThreadRole::Parser, ThreadRole::Writer, ThreadRole::Pool};
+
+inline std::string_view to_string(ThreadRole role) {
+    switch (role) {
+    case ThreadRole::Sim:
+        return "sim";
+    case ThreadRole::Logger:
+        return "logger";
+    case ThreadRole::WsIo:
+        return "ws_io";
+    case ThreadRole::Parser:
+        return "parser";
+    case ThreadRole::Writer:
+        return "writer";
+    case ThreadRole::Pool:
+        return "pool";
+    }
+    return "unknown";
+}
+
+struct ThreadPlacement {
+    std::vector<int> cpus_; // empty = not pinned
+    int fifo_priority_ = 0; // 1-99 = SCHED_FIFO at that priority, 0 = unchanged
+};
+
+struct ThreadPlacementConfig {
+    std::unordered_map<ThreadRole, ThreadPlacement> placements_;
+};
+
+/**
+ * @brief Where a named thread ended up after place_current_thread().
+ */
+struct PlacedThread {
+    std::string name_;
+    ThreadRole role_;
+    std::vector<int> cpus_;
+    int fifo_priority_;
+    bool pinned_;   // affinity was applied
+    bool realtime_; // SCHED_FIFO was applied (needs CAP_SYS_NICE)
+};
+
+namespace detail {
+struct PlacementState {
+    std::mutex mutex_;
+    ThreadPlacementConfig config_;
+    std::vector<PlacedThread> layout_;
+};
+
+inline PlacementState &placement_state() {
+    static PlacementState state;
+    return state;
+}
+} // namespace detail
+
+/**
+ * @brief Restricts the calling thread to @p cpus.
+ *
+ * @return true if the affinity was applied; false for an empty set, CPUs the
+ * process may not use, or non-Linux platforms.
+ */
+inline bool set_current_thread_cpus(const std::vector<int> &cpus) {
+#if defined(__linux__)
+    if (cpus.empty()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+/**
+ * @brief Returns the CPUs the calling thread may run on (empty where
+ * affinity is unsupported).
+ */
+inline std::vector<int> current_thread_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    return cpus;
+}
+
+/**
+ * @brief Installs the process-wide placement applied by
+ * place_current_thread(). Threads already running keep their placement.
+ */
+inline void set_thread_placement_config(const ThreadPlacementConfig &config) {
+    auto &state = detail::placement_state();
+    std::lock_guard<std::mutex> lock(state.mutex_);
+    state.config_ = config;
+}
+
+/**
+ * @brief Names the calling thread and applies its role's CPU set and
+ * priority.
+ *
+ * Called first thing by every thread the engine and the capture pipeline
+ * start. Failures (unknown CPUs, missing privileges for SCHED_FIFO) leave the
+ * thread running where the OS put it and are reported by thread_layout().
+ * Threads started repeatedly under the same name share one layout entry.
+ *
+ * @param role The thread's role.
+ * @param name Thread name; the OS keeps the first 15 characters.
+ */
+inline void place_current_thread(ThreadRole role, const std::string &name) {
+    auto &state = detail::placement_state();
+    ThreadPlacement placement;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex_);
+        auto it = state.config_.placements_.find(role);
+        if (it != state.config_.placements_.end()) placement = it->second;
+    }
+
+    // positional: this header is also built by the C++17 capture target
+    PlacedThread placed{name, role, placement.cpus_, placement.fifo_priority_,
+                        false, false};
+#if defined(__linux__)
+    pthread_t self = pthread_self();
+    pthread_setname_np(self, name.substr(0, 15).c_str());
+    placed.pinned_ = set_current_thread_cpus(placement.cpus_);
+    if (placement.fifo_priority_ > 0) {
+        sched_param param{};
+        param.sched_priority = placement.fifo_priority_;
+        placed.realtime_ =
+            pthread_setschedparam(self, SCHED_FIFO, &param) == 0;
+    }
+#endif
+
+    std::lock_guard<std::mutex> lock(state.mutex_);
+    auto it = std::find_if(
+        state.layout_.begin(), state.layout_.end(),
+        [&](const PlacedThread &entry) { return entry.name_ == name; });
+    if (it != state.layout_.end()) {
+        *it = std::move(placed);
+    } else {
+        state.layout_.push_back(std::move(placed));
+    }
+}
+
+/**
+ * @brief Returns every thread placed so far, in the order they first started.
+ */
+inline std::vector<PlacedThread> thread_layout() {
+    auto &state = detail::placement_state();
+    std::lock_guard<std::mutex> lock(state.mutex_);
+    return state.layout_;
+}
+
+/**
+ * @brief Formats thread_layout() as one line per thread, for logging.
+ */
+inline std::string format_thread_layout() {
+    std::ostringstream out;
+    for (const auto &entry : thread_layout()) {
+        out << entry.name_ << " [" << to_string(entry.role_) << "] cpus=";
+        if (entry.cpus_.empty()) {
+            out << "any";
+        } else {
+            for (std::size_t i = 0; i < entry.cpus_.size(); ++i) {
+                out << (i ? "," : "") << entry.cpus_[i];
+            }
+            if (!entry.pinned_) out << " (affinity failed)";
+        }
+        if (entry.fifo_priority_ > 0) {
+            out << " fifo=" << entry.fifo_priority_;
+            if (!entry.realtime_) out << " (not permitted)";
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+} // namespace utils::thread
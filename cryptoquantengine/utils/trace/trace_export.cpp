@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "trace_export.h"
+
+namespace utils::trace {
+namespace {
+constexpr char kMagic[8] = {'C', 'Q', 'T', 'R', 'A', 'C', 'E', '1'};
+
+struct TraceFileHeader {
+    char magic_[8];
+    std::uint32_t record_size_;
+    std::uint32_t reserved_;
+    std::uint64_t count_;
+};
+
+// Chrome trace "processes": one timeline per clock
+constexpr int kWallPid = 1;
+constexpr int kSimPid = 2;
+
+void write_common(std::ostream &out, const TraceRecord &record, int pid,
+                  std::uint64_t tid, double ts_us) {
+    out << "\"name\":\"" << to_string(record.type_) << "\",\"cat\":\"engine\""
+        << ",\"pid\":" << pid << ",\"tid\":" << tid << ",\"ts\":" << ts_us;
+}
+
+void write_args(std::ostream &out, const TraceRecord &record) {
+    out << ",\"args\":{\"sim_us\":" << record.sim_us_
+        << ",\"wall_ns\":" << record.wall_ns_;
+    if (record.asset_id_ >= 0) out << ",\"asset\":" << record.asset_id_;
+    if (record.order_id_ != 0) out << ",\"order_id\":" << record.order_id_;
+    out << '}';
+}
+} // namespace
+
+std::string to_string(TraceEventType type) {
+    switch (type) {
+    case TraceEventType::Submit:
+        return "submit";
+    case TraceEventType::ExchangeReceive:
+        return "exchange_receive";
+    case TraceEventType::Ack:
+        return "ack";
+    case TraceEventType::Fill:
+        return "fill";
+    case TraceEventType::LocalDelivery:
+        return "local_delivery";
+    case TraceEventType::StrategyCallback:
+        return "strategy_callback";
+    case TraceEventType::Elapse:
+        return "elapse";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Writes records as a compact binary trace: a 24-byte header followed
+ * by the raw 40-byte records.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void write_trace(const std::vector<TraceRecord> &records,
+                 const std::string &file) {
+    std::ofstream out(file, std::ios::binary);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open trace file: " + file);
+    }
+    TraceFileHeader header{};
+    std::memcpy(header.magic_, kMagic, sizeof(kMagic));
+    header.record_size_ = sizeof(TraceRecord);
+    header.count_ = records.size();
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(records.data()),
+              static_cast<std::streamsize>(records.size() *
+                                           sizeof(TraceRecord)));
+    if (!out) throw std::runtime_error("Failed to write trace file: " + file);
+}
+
+/**
+ * @brief Reads a binary trace written by write_trace().
+ * @throws std::runtime_error if the file is missing, not a trace, written
+ * with a different record layout or truncated.
+ */
+std::vector<TraceRecord> read_trace(const std::string &file) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open trace file: " + file);
+    }
+    TraceFileHeader header{};
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic_, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a trace file: " + file);
+    }
+    if (header.record_size_ != sizeof(TraceRecord)) {
+        throw std::runtime_error("Unsupported trace record size in: " + file);
+    }
+    std::vector<TraceRecord> records(header.count_);
+    in.read(reinterpret_cast<char *>(records.data()),
+            static_cast<std::streamsize>(records.size() *
+                                         sizeof(TraceRecord)));
+    if (!in) throw std::runtime_error("Truncated trace file: " + file);
+    return records;
+}
+
+/**
+ * @brief Exports records as Chrome trace event JSON (chrome://tracing,
+ * Perfetto UI).
+ *
+ * Every record appears twice: on the "wall clock" process, one track per
+ * recording thread, where Begin/End pairs become duration slices; and on the
+ * "simulated time" process, one track per asset, where the events of each
+ * order are linked by flow arrows from submit to local delivery.
+ */
+void write_chrome_trace(const std::vector<TraceRecord> &records,
+                        std::ostream &out) {
+    std::vector<TraceRecord> sorted = records;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const TraceRecord &a, const TraceRecord &b) {
+                         return a.wall_ns_ < b.wall_ns_;
+                     });
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << kWallPid
+        << ",\"args\":{\"name\":\"wall clock\"}},\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << kSimPid
+        << ",\"args\":{\"name\":\"simulated time\"}}";
+
+    std::set<std::uint64_t> flows_started;
+    for (const auto &record : sorted) {
+        const char *phase = record.phase_ == TracePhase::Begin ? "B"
+                            : record.phase_ == TracePhase::End ? "E"
+                                                               : "i";
+        out << ",\n{";
+        write_common(out, record, kWallPid, record.thread_,
+                     static_cast<double>(record.wall_ns_) / 1000.0);
+        out << ",\"ph\":\"" << phase << '"';
+        if (record.phase_ == TracePhase::Instant) out << ",\"s\":\"t\"";
+        write_args(out, record);
+        out << '}';
+
+        if (record.phase_ == TracePhase::End) continue;
+        // sim track: asset id, or a shared track for engine-wide events
+        const std::uint64_t sim_tid =
+            record.asset_id_ >= 0
+                ? static_cast<std::uint64_t>(record.asset_id_)
+                : 1000;
+        const double sim_ts = static_cast<double>(record.sim_us_);
+        out << ",\n{";
+        write_common(out, record, kSimPid, sim_tid, sim_ts);
+        out << ",\"ph\":\"i\",\"s\":\"t\"";
+        write_args(out, record);
+        out << '}';
+
+        if (record.order_id_ == 0) continue;
+        const bool first = flows_started.insert(record.order_id_).second;
+        out << ",\n{";
+        write_common(out, record, kSimPid, sim_tid, sim_ts);
+        out << ",\"ph\":\"" << (first ? 's' : 't') << "\",\"id\":"
+            << record.order_id_ << ",\"bp\":\"e\"}";
+    }
+    out << "\n]}\n";
+}
+} // namespace utils::trace
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "tracer.h"
+
+namespace utils::trace {
+std::string to_string(TraceEventType type);
+
+void write_trace(const std::vector<TraceRecord> &records,
+                 const std::string &file);
+std::vector<TraceRecord> read_trace(const std::string &file);
+void write_chrome_trace(const std::vector<TraceRecord> &records,
+                        std::ostream &out);
+} // namespace utils::trace
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "../../core/types/aliases/usings.h"
+
+namespace utils::trace {
+enum class TraceEventType : std::uint8_t {
+    Submit,          // strategy submitted an order (or cancel) locally
+    ExchangeReceive, // the request reached the exchange
+    Ack,             // the exchange produced an order update
+    Fill,            // the exchange produced a fill
+    LocalDelivery,   // an order update or fill reached the strategy side
+    StrategyCallback,
+    Elapse // one BacktestEngine::elapse() call
+};
+
+enum class TracePhase : std::uint8_t {
+    Instant,
+    Begin, // opens a span closed by the next End of the same type on the thread
+    End
+};
+
+/**
+ * @brief One traced event, stored and dumped as-is (40 bytes).
+ */
+struct TraceRecord {
+    std::uint64_t wall_ns_; // since Tracer::start()
+    Timestamp sim_us_;      // simulated time
+    std::uint64_t order_id_; // 0 = not order related
+    std::uint32_t thread_;   // small per-thread index
+    std::int32_t asset_id_;  // -1 = not asset related
+    TraceEventType type_;
+    TracePhase phase_;
+    std::uint8_t reserved_[6] = {};
+};
+static_assert(std::is_trivially_copyable_v<TraceRecord>);
+static_assert(sizeof(TraceRecord) == 40);
+
+/**
+ * @brief Process-wide event tracer with one append-only buffer per thread.
+ *
+ * Recording is a relaxed flag check and, when enabled, an append to the
+ * calling thread's own buffer: no locks and no atomic read-modify-writes on
+ * the hot path. A thread takes the registry lock once, the first time it
+ * records. records() must only be called while no thread is recording.
+ */
+class Tracer {
+  public:
+    static Tracer &instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    /**
+     * @brief Discards earlier records and starts recording.
+     */
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &buffer : buffers_) buffer->records_.clear();
+        epoch_ = std::chrono::steady_clock::now();
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    void stop() { enabled_.store(false, std::memory_order_release); }
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void record(TraceEventType type, TracePhase phase, Timestamp sim_us,
+                int asset_id = -1, std::uint64_t order_id = 0) {
+        ThreadBuffer &buffer = local_buffer();
+        buffer.records_.push_back(TraceRecord{
+            .wall_ns_ = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - epoch_)
+                    .count()),
+            .sim_us_ = sim_us,
+            .order_id_ = order_id,
+            .thread_ = buffer.thread_,
+            .asset_id_ = asset_id,
+            .type_ = type,
+            .phase_ = phase});
+    }
+
+    /**
+     * @brief Returns every record of every thread, thread by thread in
+     * recording order.
+     */
+    std::vector<TraceRecord> records() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<TraceRecord> all;
+        for (const auto &buffer : buffers_) {
+            all.insert(all.end(), buffer->records_.begin(),
+                       buffer->records_.end());
+        }
+        return all;
+    }
+
+  private:
+    struct ThreadBuffer {
+        std::uint32_t thread_;
+        std::vector<TraceRecord> records_;
+    };
+
+    std::atomic<bool> enabled_{false};
+    std::chrono::steady_clock::time_point epoch_ =
+        std::chrono::steady_clock::now();
+    mutable std::mutex mutex_;
+    // owned here so records survive the threads that wrote them
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    ThreadBuffer &local_buffer() {
+        thread_local ThreadBuffer *buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto owned = std::make_unique<ThreadBuffer>();
+            owned->thread_ = static_cast<std::uint32_t>(buffers_.size());
+            owned->records_.reserve(std::size_t{1} << 16);
+            buffer = owned.get();
+            buffers_.push_back(std::move(owned));
+        }
+        return *buffer;
+    }
+};
+
+/**
+ * @brief Records an instant event if tracing is enabled.
+ */
+inline void trace_event(TraceEventType type, Timestamp sim_us,
+                        int asset_id = -1, std::uint64_t order_id = 0) {
+    Tracer &tracer = Tracer::instance();
+    if (tracer.enabled()) {
+        tracer.record(type, TracePhase::Instant, sim_us, asset_id, order_id);
+    }
+}
+
+/**
+ * @brief Records a Begin event on construction and the matching End on
+ * destruction, measuring the wall time spent in the scope.
+ */
+class TraceScope {
+  public:
+    TraceScope(TraceEventType type, Timestamp sim_us)
+        : type_(type), sim_us_(sim_us),
+          active_(Tracer::instance().enabled()) {
+        if (active_) {
+            Tracer::instance().record(type_, TracePhase::Begin, sim_us_);
+        }
+    }
+    ~TraceScope() {
+        if (active_) Tracer::instance().record(type_, TracePhase::End, sim_us_);
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+  private:
+    TraceEventType type_;
+    Timestamp sim_us_;
+    bool active_;
+};
+} // namespace utils::trace
@@ -5,10 +5,14 @@
  * associated with this software.
  */
 
+#include "core/market_data/live/live_book_publisher.h"
 #include "core/market_data/readers/ws/binance_stream_reader.h"
+#include "utils/config/config_reader.h"
+#include "utils/thread/thread_placement.h"
 #include <atomic>
 #include <csignal>
 #include <iostream>
+#include <memory>
 #include <thread>
 
 std::atomic<bool> running{true};
@@ -18,24 +22,61 @@ int main(int argc, char *argv[]) {
     const std::string symbol = (argc > 1) ? argv[1] : "xrpusdc";
     const std::string book_csv = (argc > 2) ? argv[2] : "xrpusdc_book.csv";
     const std::string trade_csv = (argc > 3) ? argv[3] : "xrpusdc_trade.csv";
+    const std::string trade_stream =
+        (argc > 4 && std::string(argv[4]) == "agg") ? "@aggTrade" : "@trade";
     const bool enable_csv_writer = true;
+    // optional: pins the capture threads (see thread_placement_config.txt)
+    const std::string thread_cfg = (argc > 5) ? argv[5] : "";
+    if (!thread_cfg.empty()) {
+        utils::config::ConfigReader config_reader;
+        utils::thread::set_thread_placement_config(
+            config_reader.get_thread_placement_config(thread_cfg));
+    }
+
+    // optional: publishes the live book to shared memory for local readers
+    // (see shm_book.h); the asset config supplies the tick and lot sizes
+    const std::string asset_cfg = (argc > 6) ? argv[6] : "";
+    // "" keeps the default, so later arguments can be given without them
+    const std::string shm_name =
+        (argc > 7 && *argv[7]) ? argv[7] : "/cqe_book_" + symbol;
+    const std::size_t depth = (argc > 8 && *argv[8]) ? std::stoul(argv[8]) : 10;
+    // optional: also records the bookTicker stream for top-of-book-only
+    // backtests (the asset config's quote_file)
+    const std::string quote_csv = (argc > 9) ? argv[9] : "";
+    using core::market_data::live::LiveBookPublisher;
+    std::shared_ptr<LiveBookPublisher> publisher;
+    if (!asset_cfg.empty()) {
+        utils::config::ConfigReader config_reader;
+        const auto asset = config_reader.get_asset_config(asset_cfg);
+        publisher = std::make_shared<LiveBookPublisher>(
+            shm_name, symbol, asset.tick_size_, asset.lot_size_, depth);
+        std::cout << "Publishing top " << depth << " levels to " << shm_name
+                  << std::endl;
+    }
 
-    const std::string ws_uri =
-        "wss://fstream.binance.com/stream?streams=" + symbol + "@depth@0ms/" +
-        symbol + "@trade";
+    std::string ws_uri = "wss://fstream.binance.com/stream?streams=" + symbol +
+                         "@depth@0ms/" + symbol + trade_stream;
+    if (!quote_csv.empty()) ws_uri += "/" + symbol + "@bookTicker";
     const std::string rest_uri =
         "https://fapi.binance.com/fapi/v1/depth?symbol=" + symbol +
         "&limit=1000";
 
     std::signal(SIGINT, signal_handler);
 
-    core::market_data::BinanceStreamReader reader(ws_uri, rest_uri, book_csv,
-                                                  trade_csv, enable_csv_writer);
+    core::market_data::BinanceStreamReader reader(
+        ws_uri, rest_uri, book_csv, trade_csv, enable_csv_writer, publisher,
+        quote_csv);
 
     std::cout << "Listening to Binance stream for symbol: " << symbol
               << std::endl;
     std::cout << "Book CSV: " << book_csv << "\nTrade CSV: " << trade_csv
               << std::endl;
+    if (!quote_csv.empty())
+        std::cout << "Quote CSV: " << quote_csv << std::endl;
+
+    // the capture threads place themselves as they start
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::cout << "Thread layout:\n" << utils::thread::format_thread_layout();
 
     while (running) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
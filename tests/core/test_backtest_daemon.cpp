@@ -0,0 +1,217 @@
+/*
+ * File: tests/test_backtest_daemon.cpp
+ * Description: Unit tests for the tape cache and the backtest daemon.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-13
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "core/backtest_engine/backtest_daemon.h"
+#include "core/backtest_engine/tape_cache.h"
+#include "core/trading/asset_config.h"
+
+namespace {
+// a book oscillating around 50000 for ten seconds, with a trade each step
+void create_market_data(const std::string &book_file,
+                        const std::string &trade_file, int rows) {
+    std::ofstream book(book_file);
+    std::ofstream trade(trade_file);
+    book << "timestamp,local_timestamp,is_snapshot,side,price,amount\n";
+    trade << "timestamp,local_timestamp,id,side,price,amount\n";
+    for (int i = 0; i < rows; ++i) {
+        const long ts = 1'000'000 + i * 100'000L;
+        const double mid = 50'000.0 + (i % 10 < 5 ? i % 10 : 10 - i % 10);
+        book << ts << ',' << ts + 1000 << ",false,bid," << mid - 0.5 << ",2\n"
+             << ts << ',' << ts + 1000 << ",false,ask," << mid + 0.5 << ",2\n";
+        trade << ts + 50 << ',' << ts + 1050 << ',' << i << ','
+              << (i % 2 == 0 ? "buy," : "sell,")
+              << (i % 2 == 0 ? mid + 0.5 : mid - 0.5) << ",0.5\n";
+    }
+}
+
+core::trading::AssetConfig asset(const std::string &book_file,
+                                 const std::string &trade_file) {
+    return core::trading::AssetConfig{.book_update_file_ = book_file,
+                                      .trade_file_ = trade_file,
+                                      .tick_size_ = 0.5,
+                                      .lot_size_ = 0.001,
+                                      .contract_multiplier_ = 1.0,
+                                      .is_inverse_ = false,
+                                      .maker_fee_ = 0.0,
+                                      .taker_fee_ = 0.0};
+}
+
+void write_file(const std::string &name, const std::string &text) {
+    std::ofstream(name) << text;
+}
+
+// connects without sending anything
+int connect_idle(const std::string &socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE(connect(fd, reinterpret_cast<const sockaddr *>(&address),
+                    sizeof(address)) == 0);
+    return fd;
+}
+
+// everything the daemon sends until it closes the connection
+std::string read_reply(int fd) {
+    std::string reply;
+    char buffer[256];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        reply.append(buffer, static_cast<std::size_t>(n));
+    }
+    close(fd);
+    return reply;
+}
+} // namespace
+
+TEST_CASE("[TapeCache] - evicts least recently used tapes by bytes",
+          "[backtest-daemon]") {
+    using core::backtest::TapeCache;
+    create_market_data("cache_a_book.csv", "cache_a_trade.csv", 200);
+    create_market_data("cache_b_book.csv", "cache_b_trade.csv", 200);
+    const auto a = asset("cache_a_book.csv", "cache_a_trade.csv");
+    const auto b = asset("cache_b_book.csv", "cache_b_trade.csv");
+
+    // measure one tape, then size the cache for just over one
+    std::size_t one_tape;
+    {
+        TapeCache probe(std::size_t{1} << 30);
+        one_tape = probe.get(1, a, false)->bytes();
+    }
+    REQUIRE(one_tape > 0);
+    TapeCache cache(one_tape + one_tape / 2);
+
+    bool hit = true;
+    const auto first = cache.get(1, a, false, &hit);
+    REQUIRE_FALSE(hit);
+    REQUIRE(first->asset(1) != nullptr);
+    REQUIRE(first->asset(1)->book_rows() == 400);
+    REQUIRE(cache.get(1, a, false, &hit) == first);
+    REQUIRE(hit);
+
+    // a second dataset pushes the first one out
+    cache.get(1, b, false, &hit);
+    REQUIRE_FALSE(hit);
+    auto stats = cache.stats();
+    REQUIRE(stats.entries_ == 1);
+    REQUIRE(stats.evictions_ == 1);
+    REQUIRE(stats.bytes_ <= cache.max_bytes());
+    // the evicted tape stays valid for whoever still holds it
+    REQUIRE(first->asset(1)->trades_.size() == 200);
+    cache.get(1, a, false, &hit);
+    REQUIRE_FALSE(hit);
+
+    // other trade aggregation is another dataset; a rewritten file a miss
+    cache.get(1, a, true, &hit);
+    REQUIRE_FALSE(hit);
+    create_market_data("cache_a_book.csv", "cache_a_trade.csv", 100);
+    const auto rewritten = cache.get(1, a, true, &hit);
+    REQUIRE_FALSE(hit);
+    REQUIRE(rewritten->asset(1)->book_rows() == 200);
+
+    stats = cache.stats();
+    REQUIRE(stats.hits_ == 1);
+    REQUIRE(stats.misses_ == 5);
+    REQUIRE_THROWS(cache.get(1, asset("missing.csv", "missing.csv"), false));
+    REQUIRE(cache.stats().entries_ == stats.entries_);
+}
+
+TEST_CASE("[BacktestDaemon] - runs jobs over a socket from the tape cache",
+          "[backtest-daemon]") {
+    using namespace core::backtest;
+    create_market_data("daemon_book.csv", "daemon_trade.csv", 100);
+    write_file("daemon_asset.txt", "book_update_file=daemon_book.csv\n"
+                                   "trade_file=daemon_trade.csv\n"
+                                   "tick_size=0.5\nlot_size=0.001\n"
+                                   "is_inverse=0\nmaker_fee=0.0\n"
+                                   "taker_fee=0.0\n");
+    write_file("daemon_grid.txt", "tick_size=0.5\nlot_size=0.001\n"
+                                  "grid_num=5\ngrid_interval=1\n"
+                                  "half_spread=1\nposition_limit=10.0\n"
+                                  "notional_order_qty=10000.0\n");
+    write_file("daemon_engine.txt", "initial_cash=100000.0\n"
+                                    "order_entry_latency_us=1000\n"
+                                    "order_response_latency_us=1000\n"
+                                    "market_feed_latency_us=1000\n");
+    write_file("daemon_backtest.txt", "elapse_us=100000\niterations=90\n");
+    const std::string job = "asset_config=daemon_asset.txt\n"
+                            "grid_trading_config=daemon_grid.txt\n"
+                            "backtest_engine_config=daemon_engine.txt\n"
+                            "backtest_config=daemon_backtest.txt\n"
+                            "progress_iterations=30\n";
+
+    BacktestDaemonConfig config;
+    config.socket_path_ =
+        "/tmp/cqe_test_daemon_" + std::to_string(getpid()) + ".sock";
+    config.request_timeout_ms_ = 2000;
+    BacktestDaemon daemon(config);
+    std::thread server([&] { daemon.serve(); });
+
+    auto submit = [&](const std::string &text) {
+        std::vector<std::string> lines;
+        submit_backtest_job(
+            config.socket_path_, text,
+            [&](const std::string &line) { lines.push_back(line); });
+        return lines;
+    };
+    auto starts_with = [](const std::string &line, const std::string &head) {
+        return line.rfind(head, 0) == 0;
+    };
+
+    const auto first = submit(job);
+    REQUIRE(first.size() == 7);
+    REQUIRE(starts_with(first[0], "accepted cache=miss"));
+    REQUIRE(starts_with(first[1], "progress iteration=30 "));
+    REQUIRE(starts_with(first[3], "progress iteration=90 "));
+    REQUIRE(starts_with(first[4], "result iterations=90 "));
+    REQUIRE(starts_with(first[5], "elapsed "));
+    REQUIRE(first[6] == "done");
+
+    // the same dataset again replays the cached tape to the same result
+    const auto second = submit(job);
+    REQUIRE(second.size() == 7);
+    REQUIRE(starts_with(second[0], "accepted cache=hit"));
+    REQUIRE(second[4] == first[4]);
+
+    // parameter overrides change the run, not the dataset
+    const auto wider = submit(job + "half_spread=3\n");
+    REQUIRE(starts_with(wider[0], "accepted cache=hit"));
+    REQUIRE(starts_with(wider[4], "result iterations=90 "));
+
+    // a client that never sends its job does not hold up the next one, and
+    // is dropped once its time is up
+    const int idle = connect_idle(config.socket_path_);
+    REQUIRE(starts_with(submit(job)[0], "accepted cache=hit"));
+    pollfd waiting{idle, POLLIN, 0};
+    REQUIRE(poll(&waiting, 1, 0) == 0);
+    REQUIRE(read_reply(idle) == "error Timed out waiting for the job\n");
+
+    const auto bad = submit(job + "no_such_key=1\n");
+    REQUIRE(bad.size() == 1);
+    REQUIRE(bad[0] == "error Unknown job key: no_such_key");
+    const auto missing = submit("asset_config=daemon_asset.txt\n");
+    REQUIRE(starts_with(missing[0], "error Job lacks required key"));
+
+    daemon.stop();
+    server.join();
+    REQUIRE(daemon.cache().stats().entries_ == 1);
+}
@@ -6,16 +6,21 @@
  * License: Proprietary
  */
 
+#include <algorithm>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "core/execution_engine/execution_engine.h"
 #include "core/market_data/book_update.h"
 #include "core/orderbook/orderbook.h"
 #include "core/backtest_engine/backtest_engine.h"
+#include "core/strategy/strategy.h"
 #include "core/types/enums/book_side.h"
 #include "core/types/enums/order_type.h"
 #include "core/types/enums/time_in_force.h"
@@ -24,6 +29,46 @@
 #include "utils/logger/log_level.h"
 #include "utils/logger/logger.h"
 #include "utils/math/math_utils.h"
+#include "utils/memory/run_arena.h"
+#include "utils/trace/trace_export.h"
+
+namespace {
+// records timer callbacks; the requote timer reschedules itself every 5 ms
+class TimerStrategy : public core::strategy::Strategy {
+  public:
+    static constexpr std::uint64_t kRequote = 1;
+    static constexpr std::uint64_t kRisk = 2;
+
+    void initialize() override {}
+    void on_elapse(core::backtest::BacktestEngine &) override {}
+    void on_timer(core::backtest::BacktestEngine &engine,
+                  std::uint64_t tag) override {
+        fired_.emplace_back(engine.current_time(), tag);
+        if (tag == kRequote) {
+            engine.schedule_timer(*this, engine.current_time() + 5000, tag);
+        }
+    }
+
+    std::vector<std::pair<Timestamp, std::uint64_t>> fired_;
+};
+
+// records the local best bid and ask of an asset at each timer callback
+class DepthTimerStrategy : public core::strategy::Strategy {
+  public:
+    explicit DepthTimerStrategy(int asset_id) : asset_id_(asset_id) {}
+
+    void initialize() override {}
+    void on_elapse(core::backtest::BacktestEngine &) override {}
+    void on_timer(core::backtest::BacktestEngine &engine,
+                  std::uint64_t) override {
+        const auto depth = engine.depth(asset_id_);
+        seen_.emplace_back(depth.best_bid_, depth.best_ask_);
+    }
+
+    int asset_id_;
+    std::vector<std::pair<Ticks, Ticks>> seen_;
+};
+} // namespace
 
 namespace TestHelpers {
 void create_trade_csv(const std::string &filename) {
@@ -234,6 +279,127 @@ TEST_CASE("[BacktestEngine] - elapse", "[backtest-engine][elapse]") {
         // Cleanup
         logger->flush();
     }
+    SECTION("Runs from a per-run arena reset between runs") {
+        utils::memory::RunArena arena;
+        for (int run = 0; run < 2; ++run) {
+            {
+                BacktestEngine engine(asset_configs, backtest_engine_config,
+                                      nullptr, arena.resource());
+                REQUIRE(engine.elapse(29500));
+                engine.submit_sell_order(asset_id, 0.0, 1.0, TimeInForce::GTC,
+                                         OrderType::MARKET);
+                REQUIRE(engine.elapse(5000));
+                REQUIRE(engine.position(asset_id) == -1.0);
+                REQUIRE(engine.cash() ==
+                        Catch::Approx(50000.5 * (1 - 0.00045)).margin(1e-8));
+            }
+            REQUIRE(arena.overflow_bytes() == 0);
+            arena.reset();
+        }
+    }
+    SECTION("State hash checkpoints are reproducible") {
+        auto run = [&](const std::string &file, Microseconds entry_latency) {
+            auto config = backtest_engine_config;
+            config.order_entry_latency_us_ = entry_latency;
+            config.state_hash_interval_ = 2;
+            config.state_hash_file_ = file;
+            BacktestEngine engine(asset_configs, config);
+            REQUIRE(engine.elapse(29500));
+            engine.submit_sell_order(asset_id, 0.0, 1.0, TimeInForce::GTC,
+                                     OrderType::MARKET);
+            REQUIRE(engine.elapse(30000));
+        };
+        run("test_state_hash_a.csv", 1000);
+        run("test_state_hash_b.csv", 1000);
+        run("test_state_hash_c.csv", 3000);
+
+        const auto a = StateHasher::read("test_state_hash_a.csv");
+        REQUIRE(a.size() > 2);
+        REQUIRE_FALSE(StateHasher::first_divergence(
+            a, StateHasher::read("test_state_hash_b.csv")));
+        auto divergence = StateHasher::first_divergence(
+            a, StateHasher::read("test_state_hash_c.csv"));
+        REQUIRE(divergence.has_value());
+        REQUIRE(divergence->timestamp_ >= 29500);
+
+        std::filesystem::remove("test_state_hash_a.csv");
+        std::filesystem::remove("test_state_hash_b.csv");
+        std::filesystem::remove("test_state_hash_c.csv");
+    }
+    SECTION("Event trace follows an order from submit to delivery") {
+        {
+            auto config = backtest_engine_config;
+            config.trace_file_ = "test_backtest_engine_trace.bin";
+            BacktestEngine engine(asset_configs, config);
+            REQUIRE(engine.elapse(29500));
+            engine.submit_sell_order(asset_id, 0.0, 1.0, TimeInForce::GTC,
+                                     OrderType::MARKET);
+            REQUIRE(engine.elapse(5000));
+        }
+        using utils::trace::TraceEventType;
+        const auto records =
+            utils::trace::read_trace("test_backtest_engine_trace.bin");
+        std::vector<utils::trace::TraceRecord> order_events;
+        for (const auto &record : records) {
+            if (record.order_id_ != 0) order_events.push_back(record);
+        }
+        REQUIRE(order_events.size() >= 4);
+        REQUIRE(order_events.front().type_ == TraceEventType::Submit);
+        REQUIRE(order_events.front().sim_us_ == 29500);
+        REQUIRE(order_events[1].type_ == TraceEventType::ExchangeReceive);
+        REQUIRE(order_events[1].sim_us_ == 30500);
+        REQUIRE(order_events.back().type_ == TraceEventType::LocalDelivery);
+        REQUIRE(std::any_of(order_events.begin(), order_events.end(),
+                            [](const auto &record) {
+                                return record.type_ == TraceEventType::Fill;
+                            }));
+        for (const auto &record : order_events) {
+            REQUIRE(record.order_id_ == order_events.front().order_id_);
+        }
+        std::filesystem::remove("test_backtest_engine_trace.bin");
+    }
+    SECTION("Strategy timers fire in time order at their own cadence") {
+        BacktestEngine engine(asset_configs, backtest_engine_config);
+        TimerStrategy strategy;
+        // fast 5 ms requote timer rescheduling itself, one 12 ms risk check
+        engine.schedule_timer(strategy, 5000, TimerStrategy::kRequote);
+        engine.schedule_timer(strategy, 12000, TimerStrategy::kRisk);
+
+        REQUIRE(engine.elapse(20000));
+        const std::vector<std::pair<Timestamp, std::uint64_t>> expected = {
+            {5000, TimerStrategy::kRequote},
+            {10000, TimerStrategy::kRequote},
+            {12000, TimerStrategy::kRisk},
+            {15000, TimerStrategy::kRequote}};
+        REQUIRE(strategy.fired_ == expected);
+        REQUIRE_THROWS_AS(engine.schedule_timer(strategy, 19999, 0),
+                          std::invalid_argument);
+        // the 20 ms requote is due at the end of the step, not inside it
+        REQUIRE(engine.elapse(1));
+        REQUIRE(strategy.fired_.size() == 5);
+        REQUIRE(strategy.fired_.back().first == 20000);
+    }
+    SECTION("Strategy timers see the local book as of their own time") {
+        BacktestEngine engine(asset_configs, backtest_engine_config);
+        DepthTimerStrategy strategy(asset_id);
+        // bids at 50000 and 50000.5 reach the exchange at 20000 and 30000
+        // and arrive locally at 21000 and 31000
+        REQUIRE(engine.elapse(20500));
+        engine.schedule_timer(strategy, 20800, 0);
+        engine.schedule_timer(strategy, 25000, 0);
+        engine.schedule_timer(strategy, 30500, 0);
+        engine.schedule_timer(strategy, 35000, 0);
+        REQUIRE(engine.elapse(20000));
+
+        const Ticks ask = utils::math::price_to_ticks(50001.0, tick_size);
+        const Ticks bid = utils::math::price_to_ticks(50000.0, tick_size);
+        const std::vector<std::pair<Ticks, Ticks>> expected = {
+            {0, ask},
+            {bid, ask},
+            {bid, ask},
+            {utils::math::price_to_ticks(50000.5, tick_size), ask}};
+        REQUIRE(strategy.seen_ == expected);
+    }
     SECTION("Limit order executed in correct schedule") {
         auto logger = std::make_shared<utils::logger::Logger>(
             "test_backtest_engine_elapse_limit_schedule.log", utils::logger::LogLevel::Debug);
@@ -259,6 +425,28 @@ TEST_CASE("[BacktestEngine] - elapse", "[backtest-engine][elapse]") {
         logger->flush();
     }
 
+    SECTION("GTD order expires on schedule without strategy involvement") {
+        BacktestEngine engine(asset_configs, backtest_engine_config);
+        REQUIRE(engine.elapse(5000));
+        REQUIRE_THROWS_AS(engine.submit_sell_order(asset_id, 50000.5, 1.0,
+                                                   TimeInForce::GTD,
+                                                   OrderType::LIMIT, 0.0, 5000),
+                          std::invalid_argument);
+        // rests from 6000; the buy trade at 11000 would fill it
+        OrderId order_id = engine.submit_sell_order(
+            asset_id, 50000.5, 1.0, TimeInForce::GTD, OrderType::LIMIT, 0.0,
+            9000);
+        REQUIRE(engine.elapse(3500));
+        REQUIRE(engine.order(order_id)->orderStatus_ == OrderStatus::ACTIVE);
+        // expired at 9000, seen locally at 10000
+        REQUIRE(engine.elapse(2000));
+        REQUIRE(engine.order(order_id)->orderStatus_ == OrderStatus::EXPIRED);
+        REQUIRE(engine.elapse(5500));
+        REQUIRE(engine.position(asset_id) == 0.0);
+        engine.clear_inactive_orders();
+        REQUIRE(engine.order(order_id) == nullptr);
+    }
+
     SECTION("Complex multi-limit order execution with partial fills and "
             "cancellations") {
         auto logger = std::make_shared<utils::logger::Logger>(
@@ -319,4 +507,60 @@ TEST_CASE("[BacktestEngine] - elapse", "[backtest-engine][elapse]") {
     }
     std::filesystem::remove(book_file);
     std::filesystem::remove(trade_file);
-}
\ No newline at end of file
+}
+TEST_CASE("[BacktestEngine] - top-of-book-only assets",
+          "[backtest-engine][bbo]") {
+    using namespace core::trading;
+    using namespace core::backtest;
+
+    const std::string quote_file = "test_bbo_quotes.csv";
+    const std::string trade_file = "test_bbo_trades.csv";
+    {
+        std::ofstream f(quote_file);
+        f << "timestamp,local_timestamp,ask_amount,ask_price,bid_price,"
+             "bid_amount\n"
+          << "1000,2000,1.5,50001.0,50000.0,2.0\n"
+          << "30000,31000,1.0,50001.0,50000.5,0.5\n";
+    }
+    TestHelpers::create_trade_csv(trade_file);
+
+    int asset_id = 1;
+    std::unordered_map<int, AssetConfig> asset_configs = {
+        {asset_id, AssetConfig{.book_update_file_ = "",
+                               .trade_file_ = trade_file,
+                               .tick_size_ = 0.5,
+                               .lot_size_ = 0.001,
+                               .contract_multiplier_ = 1.0,
+                               .is_inverse_ = false,
+                               .maker_fee_ = 0.0,
+                               .taker_fee_ = 0.0,
+                               .name_ = "BTCUSDT",
+                               .order_file_ = "",
+                               .quote_file_ = quote_file}}};
+    auto backtest_engine_config =
+        BacktestEngineConfig{.initial_cash_ = 1000.0,
+                             .order_entry_latency_us_ = 1000,
+                             .order_response_latency_us_ = 1000,
+                             .market_feed_latency_us_ = 1000};
+    BacktestEngine engine(asset_configs, backtest_engine_config);
+
+    // the first quote is at the exchange at 1000us but local only at 2000us
+    REQUIRE(engine.current_time() == 0);
+    engine.elapse(1500);
+    REQUIRE(engine.depth(asset_id).best_bid_ == 0);
+    engine.elapse(1000);
+    auto depth = engine.depth(asset_id);
+    REQUIRE(depth.best_bid_ == 100000);
+    REQUIRE(depth.bid_qty_ == 2.0);
+    REQUIRE(depth.best_ask_ == 100002);
+    REQUIRE(depth.bid_depth_.size() == 1);
+
+    engine.elapse(30000);
+    auto snapshot = engine.book_snapshot(asset_id);
+    REQUIRE(snapshot.best_bid() == 50000.5);
+    REQUIRE(snapshot.depth_at_level(BookSide::Bid, 0) == 0.5);
+    REQUIRE(snapshot.depth_at_level(BookSide::Bid, 1) == 0.0);
+
+    std::filesystem::remove(quote_file);
+    std::filesystem::remove(trade_file);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "core/orderbook/book_snapshot.h"
+#include "core/types/enums/book_side.h"
+
+TEST_CASE("[PagedLevels] - copies are unaffected by later writes",
+          "[book_snapshot][paged_levels]") {
+    using namespace core::orderbook;
+
+    PagedLevels levels;
+    levels.set(100, 1.0);
+    levels.set(164, 2.0);
+    levels.set(1000, 3.0);
+    REQUIRE(levels.page_count() == 3);
+
+    PagedLevels copy = levels;
+    levels.set(100, 5.0);
+    levels.set(164, 0.0);
+    levels.set(101, 4.0);
+
+    REQUIRE(copy.get(100) == 1.0);
+    REQUIRE(copy.get(164) == 2.0);
+    REQUIRE(copy.get(101) == 0.0);
+    REQUIRE(levels.get(100) == 5.0);
+    REQUIRE(levels.get(164) == 0.0);
+    REQUIRE(levels.page_count() == 2);
+
+    std::vector<Ticks> ascending;
+    levels.for_each(false, [&](Ticks price, Quantity) {
+        ascending.push_back(price);
+        return true;
+    });
+    REQUIRE(ascending == std::vector<Ticks>{100, 101, 1000});
+
+    std::vector<Ticks> descending;
+    copy.for_each(true, [&](Ticks price, Quantity) {
+        descending.push_back(price);
+        return true;
+    });
+    REQUIRE(descending == std::vector<Ticks>{1000, 164, 100});
+}
+
+TEST_CASE("[BookSnapshot] - level queries and diff", "[book_snapshot]") {
+    using namespace core::orderbook;
+
+    PagedLevels bids;
+    PagedLevels asks;
+    bids.set(200, 1.0);
+    bids.set(198, 2.0);
+    asks.set(202, 3.0);
+    asks.set(205, 4.0);
+
+    BookSnapshot before(10, 0.5, bids, asks);
+    REQUIRE(before.timestamp() == 10);
+    REQUIRE(before.best_bid() == 100.0);
+    REQUIRE(before.best_ask() == 101.0);
+    REQUIRE(before.mid_price() == 100.5);
+    REQUIRE(before.price_at_level(BookSide::Bid, 1) == 198);
+    REQUIRE(before.depth_at_level(BookSide::Ask, 1) == 4.0);
+    REQUIRE(before.depth_at(BookSide::Bid, 199) == 0.0);
+    REQUIRE(before.bid_book().begin()->first == 200);
+    REQUIRE(before.ask_book().size() == 2);
+
+    SECTION("identical snapshots have no diff") {
+        BookSnapshot same(20, 0.5, bids, asks);
+        REQUIRE(BookSnapshot::diff(before, same).empty());
+    }
+
+    SECTION("diff lists changed, added and removed levels") {
+        bids.set(200, 1.5);
+        asks.set(202, 0.0);
+        asks.set(900, 1.0);
+        BookSnapshot after(20, 0.5, bids, asks);
+
+        auto changes = BookSnapshot::diff(before, after);
+        REQUIRE(changes.size() == 3);
+        REQUIRE(changes[0].side_ == BookSide::Bid);
+        REQUIRE(changes[0].price_ == 200);
+        REQUIRE(changes[0].from_quantity_ == 1.0);
+        REQUIRE(changes[0].to_quantity_ == 1.5);
+        REQUIRE(changes[1].side_ == BookSide::Ask);
+        REQUIRE(changes[1].price_ == 202);
+        REQUIRE(changes[1].to_quantity_ == 0.0);
+        REQUIRE(changes[2].price_ == 900);
+        REQUIRE(changes[2].from_quantity_ == 0.0);
+
+        // the older snapshot still reports its own state
+        REQUIRE(before.best_ask() == 101.0);
+        REQUIRE(after.best_ask() == 102.5);
+    }
+}
@@ -7,12 +7,19 @@
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
 
 #include "core/execution_engine/execution_engine.h"
 #include "core/market_data/book_update.h"
+#include "core/market_data/book_update_batch.h"
+#include "core/market_data/mbo_update.h"
+#include "core/market_data/quote.h"
+#include "core/market_data/trade.h"
 #include "core/orderbook/orderbook.h"
 #include "core/types/enums/book_side.h"
+#include "core/types/enums/mbo_action.h"
 #include "core/types/enums/order_type.h"
 #include "core/types/enums/time_in_force.h"
 #include "core/types/enums/update_type.h"
@@ -1035,4 +1042,555 @@ TEST_CASE("[ExecutionEngine] - processes trades", "[execution-engine][trade]") {
         REQUIRE(buy_order->filled_quantity_ == 0.0);
         REQUIRE(engine.fills().empty());
     }
-}
\ No newline at end of file
+}
+TEST_CASE("[ExecutionEngine] - exact queue position from order-level feed",
+          "[execution-engine][mbo]") {
+    using namespace core::execution_engine;
+    using namespace core::trading;
+    using namespace core::market_data;
+
+    ExecutionEngine engine;
+    engine.add_mbo_asset(0, 1.0, 0.1);
+
+    auto mbo = [](Timestamp ts, std::uint64_t id, MboAction action,
+                  Quantity qty) {
+        return MboUpdate{.exch_timestamp_ = ts,
+                         .local_timestamp_ = ts + 10,
+                         .order_id_ = id,
+                         .action_ = action,
+                         .side_ = BookSide::Bid,
+                         .price_ = 100.0,
+                         .quantity_ = qty};
+    };
+    engine.handle_mbo_update(0, mbo(1, 11, MboAction::Add, 2.0));
+    engine.handle_mbo_update(0, mbo(2, 12, MboAction::Add, 3.0));
+    REQUIRE(engine.orderbook(0).depth_at(BookSide::Bid, 100) == 5.0);
+
+    auto order = std::make_shared<Order>(Order{.exch_timestamp_ = 5,
+                                               .orderId_ = 1,
+                                               .side_ = BookSide::Bid,
+                                               .price_ = 100.0,
+                                               .quantity_ = 1.0,
+                                               .filled_quantity_ = 0.0,
+                                               .tif_ = TimeInForce::GTC,
+                                               .orderType_ = OrderType::LIMIT,
+                                               .queueEst_ = 0.0});
+    REQUIRE(engine.place_maker_order(0, order));
+    REQUIRE(order->queueEst_ == 5.0);
+
+    // orders joining behind ours do not count
+    engine.handle_mbo_update(0, mbo(6, 13, MboAction::Add, 4.0));
+    REQUIRE(order->queueEst_ == 5.0);
+    REQUIRE(engine.orderbook(0).depth_at(BookSide::Bid, 100) == 9.0);
+
+    // cancellations ahead reduce the queue exactly
+    engine.handle_mbo_update(0, mbo(7, 11, MboAction::Delete, 0.0));
+    REQUIRE(order->queueEst_ == 3.0);
+    engine.handle_mbo_update(0, mbo(8, 12, MboAction::Modify, 1.0));
+    REQUIRE(order->queueEst_ == 1.0);
+    engine.handle_mbo_update(0, mbo(9, 12, MboAction::Delete, 0.0));
+    REQUIRE(order->queueEst_ == 0.0);
+
+    engine.handle_trade(0, Trade{.exch_timestamp_ = 10,
+                                 .local_timestamp_ = 20,
+                                 .side_ = TradeSide::Sell,
+                                 .price_ = 100.0,
+                                 .quantity_ = 1.0,
+                                 .orderId_ = 99});
+    REQUIRE(engine.fills().size() == 1);
+    REQUIRE(order->orderStatus_ == OrderStatus::FILLED);
+}
+
+TEST_CASE("[ExecutionEngine] - top-of-book-only assets",
+          "[execution-engine][bbo]") {
+    using namespace core::execution_engine;
+    using namespace core::market_data;
+    using namespace core::trading;
+
+    ExecutionEngine engine;
+    engine.add_bbo_asset(0, 1.0, 0.1);
+
+    auto quote = [](Timestamp ts, Price bid, Quantity bid_qty, Price ask,
+                    Quantity ask_qty) {
+        return Quote{.exch_timestamp_ = ts,
+                     .local_timestamp_ = ts + 10,
+                     .bid_price_ = bid,
+                     .bid_quantity_ = bid_qty,
+                     .ask_price_ = ask,
+                     .ask_quantity_ = ask_qty};
+    };
+    auto bid = [](OrderId id, Price price) {
+        return std::make_shared<Order>(Order{.exch_timestamp_ = 5,
+                                             .orderId_ = id,
+                                             .side_ = BookSide::Bid,
+                                             .price_ = price,
+                                             .quantity_ = 1.0,
+                                             .filled_quantity_ = 0.0,
+                                             .tif_ = TimeInForce::GTC,
+                                             .orderType_ = OrderType::LIMIT,
+                                             .queueEst_ = 0.0,
+                                             .orderStatus_ =
+                                                 OrderStatus::NEW});
+    };
+    engine.handle_quote(0, quote(1, 100.0, 5.0, 101.0, 2.0));
+    REQUIRE(engine.top_of_book(0).best_bid() == 100.0);
+
+    SECTION("queue at the touch follows size decreases") {
+        auto order = bid(1, 100.0);
+        REQUIRE(engine.place_maker_order(0, order));
+        REQUIRE(order->queueEst_ == 5.0);
+        engine.handle_quote(0, quote(2, 100.0, 8.0, 101.0, 2.0));
+        REQUIRE(order->queueEst_ == 5.0);
+        engine.handle_quote(0, quote(3, 100.0, 4.0, 101.0, 2.0));
+        REQUIRE(order->queueEst_ < 5.0);
+        REQUIRE(order->queueEst_ > 0.0);
+    }
+
+    SECTION("touch moving through our price puts us at the front") {
+        auto order = bid(1, 100.0);
+        REQUIRE(engine.place_maker_order(0, order));
+        engine.handle_quote(0, quote(2, 99.0, 3.0, 101.0, 2.0));
+        REQUIRE(order->queueEst_ == 0.0);
+        engine.handle_trade(0, Trade{.exch_timestamp_ = 6,
+                                     .local_timestamp_ = 16,
+                                     .side_ = TradeSide::Sell,
+                                     .price_ = 100.0,
+                                     .quantity_ = 1.0,
+                                     .orderId_ = 99});
+        REQUIRE(order->orderStatus_ == OrderStatus::FILLED);
+    }
+
+    SECTION("orders behind the touch wait until it reaches them") {
+        auto order = bid(1, 99.0);
+        REQUIRE(engine.place_maker_order(0, order));
+        REQUIRE_FALSE(order->queue_known_);
+        engine.handle_trade(0, Trade{.exch_timestamp_ = 6,
+                                     .local_timestamp_ = 16,
+                                     .side_ = TradeSide::Sell,
+                                     .price_ = 99.0,
+                                     .quantity_ = 1.0,
+                                     .orderId_ = 99});
+        REQUIRE(engine.fills().empty());
+        // a size change elsewhere says nothing about our level
+        engine.handle_quote(0, quote(7, 100.0, 2.0, 101.0, 2.0));
+        REQUIRE_FALSE(order->queue_known_);
+        engine.handle_quote(0, quote(8, 99.0, 4.0, 101.0, 2.0));
+        REQUIRE(order->queue_known_);
+        REQUIRE(order->queueEst_ == 4.0);
+    }
+
+    SECTION("orders inside the spread are at the front") {
+        auto order = bid(1, 100.5);
+        REQUIRE(engine.place_maker_order(0, order));
+        REQUIRE(order->queueEst_ == 0.0);
+    }
+
+    SECTION("takers only see the touch") {
+        auto order = std::make_shared<Order>(Order{.exch_timestamp_ = 5,
+                                                   .orderId_ = 2,
+                                                   .side_ = BookSide::Bid,
+                                                   .price_ = 0.0,
+                                                   .quantity_ = 3.0,
+                                                   .filled_quantity_ = 0.0,
+                                                   .tif_ = TimeInForce::GTC,
+                                                   .orderType_ =
+                                                       OrderType::MARKET,
+                                                   .queueEst_ = 0.0,
+                                             .orderStatus_ =
+                                                 OrderStatus::NEW});
+        engine.execute_market_order(0, TradeSide::Buy, order);
+        REQUIRE(order->filled_quantity_ == 2.0);
+        REQUIRE(engine.fills().size() == 1);
+        REQUIRE(engine.fills().front().price_ == 101.0);
+    }
+}
+
+TEST_CASE("[ExecutionEngine] - stop orders trigger at their stop price",
+          "[execution-engine][stop]") {
+    using namespace core::trading;
+    using namespace core::execution_engine;
+    using namespace core::market_data;
+    ExecutionEngine engine;
+    engine.add_asset(0, 0.5, 0.001);
+    auto level = [&](Timestamp ts, BookSide side, Price price, Quantity qty) {
+        engine.handle_book_update(
+            0, BookUpdate{.exch_timestamp_ = ts,
+                          .local_timestamp_ = ts + 10,
+                          .update_type_ = UpdateType::Incremental,
+                          .side_ = side,
+                          .price_ = price,
+                          .quantity_ = qty});
+    };
+    level(1, BookSide::Bid, 100.0, 5.0);
+    level(1, BookSide::Ask, 101.0, 5.0);
+    auto stop = [](OrderId id, BookSide side, OrderType type, Price stop_price,
+                   Price price, TimeInForce tif) {
+        return Order{.exch_timestamp_ = 5,
+                     .orderId_ = id,
+                     .side_ = side,
+                     .price_ = price,
+                     .quantity_ = 2.0,
+                     .filled_quantity_ = 0.0,
+                     .tif_ = tif,
+                     .orderType_ = type,
+                     .queueEst_ = 0.0,
+                     .orderStatus_ = OrderStatus::NEW,
+                     .stop_price_ = stop_price};
+    };
+    auto trade = [&](Timestamp ts, TradeSide side, Price price) {
+        engine.handle_trade(0, Trade{.exch_timestamp_ = ts,
+                                     .local_timestamp_ = ts + 10,
+                                     .side_ = side,
+                                     .price_ = price,
+                                     .quantity_ = 1.0,
+                                     .orderId_ = 99});
+    };
+
+    SECTION("sell stop-market fires when a trade prints at its stop") {
+        REQUIRE(engine.execute_order(
+            0, TradeSide::Sell,
+            stop(1, BookSide::Ask, OrderType::STOP_MARKET, 99.0, 0.0,
+                 TimeInForce::GTC)));
+        REQUIRE(engine.pending_stops(0) == 1);
+        REQUIRE(engine.order_updates().back().event_type_ ==
+                OrderEventType::ACKNOWLEDGED);
+        trade(10, TradeSide::Sell, 99.5);
+        REQUIRE(engine.fills().empty());
+        trade(11, TradeSide::Sell, 99.0);
+        REQUIRE(engine.pending_stops(0) == 0);
+        REQUIRE(engine.fills().size() == 1);
+        REQUIRE(engine.fills()[0].price_ == 100.0);
+        REQUIRE(engine.fills()[0].side_ == TradeSide::Sell);
+        REQUIRE(engine.fills()[0].exch_timestamp_ == 11);
+        REQUIRE(engine.order_updates().back().order_->orderStatus_ ==
+                OrderStatus::FILLED);
+    }
+
+    SECTION("buy stops fire nearest first once the best ask reaches them") {
+        engine.execute_order(0, TradeSide::Buy,
+                             stop(1, BookSide::Bid, OrderType::STOP_MARKET,
+                                  103.0, 0.0, TimeInForce::GTC));
+        engine.execute_order(0, TradeSide::Buy,
+                             stop(2, BookSide::Bid, OrderType::STOP_MARKET,
+                                  102.0, 0.0, TimeInForce::GTC));
+        engine.execute_order(0, TradeSide::Buy,
+                             stop(3, BookSide::Bid, OrderType::STOP_MARKET,
+                                  105.0, 0.0, TimeInForce::GTC));
+        level(20, BookSide::Ask, 101.0, 0.0);
+        level(20, BookSide::Ask, 103.0, 5.0);
+        REQUIRE(engine.pending_stops(0) == 1);
+        REQUIRE(engine.fills().size() == 2);
+        REQUIRE(engine.fills()[0].orderId_ == 2);
+        REQUIRE(engine.fills()[1].orderId_ == 1);
+        REQUIRE(engine.fills()[1].price_ == 103.0);
+    }
+
+    SECTION("a cancelled stop never fires") {
+        engine.execute_order(0, TradeSide::Sell,
+                             stop(1, BookSide::Ask, OrderType::STOP_MARKET,
+                                  99.0, 0.0, TimeInForce::GTC));
+        REQUIRE(engine.cancel_order(0, 1, 6));
+        trade(10, TradeSide::Sell, 98.0);
+        REQUIRE(engine.fills().empty());
+        engine.execute_order(0, TradeSide::Sell,
+                             stop(2, BookSide::Ask, OrderType::STOP_MARKET,
+                                  97.0, 0.0, TimeInForce::GTC));
+        engine.execute_order(0, TradeSide::Sell,
+                             stop(3, BookSide::Ask, OrderType::STOP_MARKET,
+                                  96.0, 0.0, TimeInForce::GTC));
+        engine.cancel_order(0, 2, 11);
+        engine.clear_inactive_orders(0);
+        REQUIRE(engine.pending_stops(0) == 1);
+        REQUIRE_FALSE(engine.order_exists(2));
+        REQUIRE(engine.order_exists(3));
+    }
+
+    SECTION("stop-limit orders take up to their limit price") {
+        level(2, BookSide::Ask, 101.5, 1.0);
+        engine.execute_order(0, TradeSide::Buy,
+                             stop(1, BookSide::Bid, OrderType::STOP_LIMIT,
+                                  101.0, 101.0, TimeInForce::IOC));
+        // the best ask is already at the stop: it fires on arrival
+        REQUIRE(engine.pending_stops(0) == 0);
+        REQUIRE(engine.fills().size() == 1);
+        REQUIRE(engine.fills()[0].quantity_ == 2.0);
+
+        engine.clear_fills();
+        engine.clear_order_updates();
+        engine.execute_order(0, TradeSide::Buy,
+                             stop(2, BookSide::Bid, OrderType::STOP_LIMIT,
+                                  102.0, 102.0, TimeInForce::IOC));
+        level(12, BookSide::Ask, 101.0, 0.0);
+        level(12, BookSide::Ask, 101.5, 0.0);
+        level(12, BookSide::Ask, 102.0, 0.5);
+        REQUIRE(engine.fills().size() == 1);
+        REQUIRE(engine.fills()[0].quantity_ == 0.5);
+        // the rest of a taker stop is cancelled, not left resting
+        REQUIRE(engine.order_updates().back().event_type_ ==
+                OrderEventType::CANCELLED);
+    }
+
+    SECTION("stop-limit GTC orders rest as maker orders once triggered") {
+        engine.execute_order(0, TradeSide::Sell,
+                             stop(1, BookSide::Ask, OrderType::STOP_LIMIT,
+                                  99.5, 102.0, TimeInForce::GTC));
+        trade(10, TradeSide::Sell, 99.5);
+        REQUIRE(engine.pending_stops(0) == 0);
+        REQUIRE(engine.fills().empty());
+        REQUIRE(engine.order_updates().back().event_type_ ==
+                OrderEventType::ACKNOWLEDGED);
+        trade(20, TradeSide::Buy, 102.0);
+        REQUIRE(engine.fills().size() == 1);
+        REQUIRE(engine.fills()[0].is_maker);
+    }
+
+    SECTION("stops without a stop price are rejected") {
+        REQUIRE_FALSE(engine.execute_order(
+            0, TradeSide::Sell,
+            stop(1, BookSide::Ask, OrderType::STOP_MARKET, 0.0, 0.0,
+                 TimeInForce::GTC)));
+        REQUIRE(engine.pending_stops(0) == 0);
+    }
+}
+
+TEST_CASE("[ExecutionEngine] - GTD orders expire", "[execution-engine][gtd]") {
+    using namespace core::trading;
+    using namespace core::execution_engine;
+    using namespace core::market_data;
+    ExecutionEngine engine;
+    engine.add_asset(0, 0.5, 0.001);
+    engine.handle_book_update(0, BookUpdate{.exch_timestamp_ = 1,
+                                            .local_timestamp_ = 11,
+                                            .update_type_ =
+                                                UpdateType::Incremental,
+                                            .side_ = BookSide::Ask,
+                                            .price_ = 101.0,
+                                            .quantity_ = 5.0});
+    auto gtd = [](OrderId id, Timestamp expire_time) {
+        return Order{.exch_timestamp_ = 5,
+                     .orderId_ = id,
+                     .side_ = BookSide::Bid,
+                     .price_ = 100.0,
+                     .quantity_ = 1.0,
+                     .filled_quantity_ = 0.0,
+                     .tif_ = TimeInForce::GTD,
+                     .orderType_ = OrderType::LIMIT,
+                     .queueEst_ = 0.0,
+                     .orderStatus_ = OrderStatus::NEW,
+                     .expire_time_ = expire_time};
+    };
+
+    SECTION("resting orders stop filling once expired") {
+        REQUIRE(engine.execute_order(0, TradeSide::Buy, gtd(1, 50)));
+        REQUIRE(engine.expire_order(0, 1, 50));
+        REQUIRE_FALSE(engine.expire_order(0, 1, 51));
+        const auto &update = engine.order_updates().back();
+        REQUIRE(update.event_type_ == OrderEventType::EXPIRED);
+        REQUIRE(update.exch_timestamp_ == 50);
+        REQUIRE(update.order_->orderStatus_ == OrderStatus::EXPIRED);
+        engine.handle_trade(0, Trade{.exch_timestamp_ = 60,
+                                     .local_timestamp_ = 70,
+                                     .side_ = TradeSide::Sell,
+                                     .price_ = 100.0,
+                                     .quantity_ = 1.0,
+                                     .orderId_ = 99});
+        REQUIRE(engine.fills().empty());
+        engine.clear_inactive_orders(0);
+        REQUIRE_FALSE(engine.order_exists(1));
+    }
+
+    SECTION("orders arriving after their expire time never rest") {
+        REQUIRE_FALSE(engine.execute_order(0, TradeSide::Buy, gtd(2, 5)));
+        REQUIRE_FALSE(engine.order_exists(2));
+        REQUIRE(engine.order_updates().back().event_type_ ==
+                OrderEventType::EXPIRED);
+    }
+}
+
+TEST_CASE("[ExecutionEngine] - taker fills consume displayed depth",
+          "[execution-engine][shadow-liquidity]") {
+    using namespace core::trading;
+    using namespace core::execution_engine;
+    using namespace core::market_data;
+    ExecutionEngine engine;
+    engine.add_asset(0, 0.5, 0.001);
+    auto ask = [&](Timestamp ts, Price price, Quantity qty, UpdateType type) {
+        engine.handle_book_update(0, BookUpdate{.exch_timestamp_ = ts,
+                                                .local_timestamp_ = ts + 10,
+                                                .update_type_ = type,
+                                                .side_ = BookSide::Ask,
+                                                .price_ = price,
+                                                .quantity_ = qty});
+    };
+    ask(1, 101.0, 2.0, UpdateType::Incremental);
+    ask(1, 102.0, 3.0, UpdateType::Incremental);
+    auto buy = [](OrderId id, OrderType type, TimeInForce tif, Price price,
+                  Quantity qty) {
+        return Order{.exch_timestamp_ = 5,
+                     .orderId_ = id,
+                     .side_ = BookSide::Bid,
+                     .price_ = price,
+                     .quantity_ = qty,
+                     .filled_quantity_ = 0.0,
+                     .tif_ = tif,
+                     .orderType_ = type};
+    };
+
+    // the second order only finds what the first one left at 101
+    engine.execute_order(0, TradeSide::Buy,
+                         buy(1, OrderType::MARKET, TimeInForce::GTC, 0.0, 1.5));
+    engine.execute_order(0, TradeSide::Buy,
+                         buy(2, OrderType::MARKET, TimeInForce::GTC, 0.0, 1.0));
+    REQUIRE(engine.fills().size() == 3);
+    REQUIRE(engine.fills()[1].price_ == 101.0);
+    REQUIRE(engine.fills()[1].quantity_ == 0.5);
+    REQUIRE(engine.fills()[2].price_ == 102.0);
+    REQUIRE(engine.fills()[2].quantity_ == 0.5);
+    // the replayed book itself is untouched
+    REQUIRE(engine.orderbook(0).depth_at_level(BookSide::Ask, 0) == 2.0);
+
+    // 101 is exhausted: an IOC limited to it gets nothing
+    engine.clear_fills();
+    REQUIRE_FALSE(engine.execute_order(
+        0, TradeSide::Buy, buy(3, OrderType::LIMIT, TimeInForce::IOC, 101.0,
+                               1.0)));
+    REQUIRE(engine.fills().empty());
+
+    // a real update for 101 restates it; 102 still has 0.5 taken
+    ask(10, 101.0, 2.0, UpdateType::Incremental);
+    REQUIRE(engine.execute_order(
+        0, TradeSide::Buy, buy(4, OrderType::LIMIT, TimeInForce::IOC, 101.0,
+                               2.0)));
+    REQUIRE(engine.fills().back().quantity_ == 2.0);
+    REQUIRE_FALSE(engine.execute_order(
+        0, TradeSide::Buy, buy(5, OrderType::LIMIT, TimeInForce::FOK, 102.0,
+                               3.0)));
+
+    // a snapshot replaces every level
+    ask(20, 102.0, 3.0, UpdateType::Snapshot);
+    engine.clear_fills();
+    REQUIRE(engine.execute_order(
+        0, TradeSide::Buy, buy(6, OrderType::LIMIT, TimeInForce::FOK, 102.0,
+                               3.0)));
+    REQUIRE(engine.fills().size() == 1);
+    REQUIRE(engine.fills()[0].price_ == 102.0);
+}
+
+namespace {
+// counts the allocations of at least min_bytes_, passing all of them on to
+// the global heap
+class CountingResource : public std::pmr::memory_resource {
+  public:
+    explicit CountingResource(std::size_t min_bytes) : min_bytes_(min_bytes) {}
+    std::size_t allocations_ = 0;
+
+  private:
+    std::size_t min_bytes_;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (bytes >= min_bytes_) ++allocations_;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, std::size_t bytes,
+                       std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other)
+        const noexcept override {
+        return this == &other;
+    }
+};
+} // namespace
+
+TEST_CASE("[ExecutionEngine] - orders come from the engine's resource",
+          "[execution-engine][arena]") {
+    using namespace core::execution_engine;
+    using namespace core::trading;
+
+    // only an order (with its shared_ptr control block) is this large
+    CountingResource resource(sizeof(Order));
+    ExecutionEngine engine(nullptr, &resource);
+    engine.add_asset(0, 0.01, 0.00001);
+    auto bid = [](OrderId id, Price price) {
+        return Order{.exch_timestamp_ = 10,
+                     .orderId_ = id,
+                     .side_ = BookSide::Bid,
+                     .price_ = price,
+                     .quantity_ = 1.0,
+                     .tif_ = TimeInForce::GTC,
+                     .orderType_ = OrderType::LIMIT};
+    };
+    // the first order also sizes the lookup tables
+    REQUIRE(engine.execute_order(0, TradeSide::Buy, bid(1, 100.0)));
+    const std::size_t before = resource.allocations_;
+    REQUIRE(engine.execute_order(0, TradeSide::Buy, bid(2, 99.0)));
+    REQUIRE(engine.order_exists(2));
+    REQUIRE(resource.allocations_ == before + 1);
+}
+
+TEST_CASE("[ExecutionEngine] - book update batches match row updates",
+          "[execution-engine][batch]") {
+    using namespace core::trading;
+    using namespace core::execution_engine;
+    using namespace core::market_data;
+
+    ExecutionEngine batched;
+    ExecutionEngine per_row;
+    auto bid = [](OrderId id, Price price) {
+        return std::make_shared<Order>(Order{.exch_timestamp_ = 5,
+                                             .orderId_ = id,
+                                             .side_ = BookSide::Bid,
+                                             .price_ = price,
+                                             .quantity_ = 1.0,
+                                             .filled_quantity_ = 0.0,
+                                             .tif_ = TimeInForce::GTC,
+                                             .orderType_ = OrderType::LIMIT,
+                                             .queueEst_ = 0.0});
+    };
+    auto row = [](UpdateType type, BookSide side, Price price,
+                  Quantity quantity) {
+        return BookUpdate{.exch_timestamp_ = 10,
+                          .local_timestamp_ = 20,
+                          .update_type_ = type,
+                          .side_ = side,
+                          .price_ = price,
+                          .quantity_ = quantity};
+    };
+    BookUpdateBatch setup{1, 2, {}};
+    setup.updates_ = {row(UpdateType::Incremental, BookSide::Bid, 99.0, 8.0),
+                      row(UpdateType::Incremental, BookSide::Bid, 98.0, 6.0),
+                      row(UpdateType::Incremental, BookSide::Ask, 101.0, 4.0)};
+    std::shared_ptr<Order> orders[2][2];
+    for (auto *engine : {&batched, &per_row}) {
+        engine->add_asset(0, 1.0, 0.1);
+        engine->handle_book_update_batch(0, setup);
+    }
+    for (int e = 0; e < 2; ++e) {
+        auto &engine = e ? per_row : batched;
+        orders[e][0] = bid(1, 99.0);
+        orders[e][1] = bid(2, 98.0);
+        REQUIRE(engine.place_maker_order(0, orders[e][0]));
+        REQUIRE(engine.place_maker_order(0, orders[e][1]));
+    }
+
+    // our levels shrink twice within one batch, and a snapshot row clears
+    // the book before 98 shrinks again
+    BookUpdateBatch batch{10, 20, {}};
+    batch.updates_ = {row(UpdateType::Incremental, BookSide::Bid, 99.0, 5.0),
+                      row(UpdateType::Incremental, BookSide::Ask, 101.0, 2.0),
+                      row(UpdateType::Incremental, BookSide::Bid, 99.0, 2.0),
+                      row(UpdateType::Incremental, BookSide::Bid, 98.0, 4.0),
+                      row(UpdateType::Snapshot, BookSide::Bid, 97.0, 1.0),
+                      row(UpdateType::Snapshot, BookSide::Bid, 98.0, 3.0),
+                      row(UpdateType::Snapshot, BookSide::Ask, 102.0, 1.0)};
+    batched.handle_book_update_batch(0, batch);
+    for (const auto &update : batch.updates_) {
+        per_row.handle_book_update(0, update);
+    }
+
+    REQUIRE(orders[0][0]->queueEst_ < 8.0);
+    REQUIRE(orders[0][0]->queueEst_ == orders[1][0]->queueEst_);
+    REQUIRE(orders[0][1]->queueEst_ == orders[1][1]->queueEst_);
+    REQUIRE(batched.orderbook(0).bid_book() == per_row.orderbook(0).bid_book());
+    REQUIRE(batched.state_hash(0) == per_row.state_hash(0));
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "core/market_data/book_update.h"
+#include "core/market_data/book_update_batch.h"
+#include "core/market_data/depth_snapshot.h"
+#include "core/orderbook/lagged_book_view.h"
+#include "core/orderbook/orderbook.h"
+#include "core/types/enums/book_side.h"
+#include "core/types/enums/update_type.h"
+#include "utils/math/math_utils.h"
+
+TEST_CASE("[LaggedBookView] - hides changes until their local timestamp",
+          "[lagged_book_view]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+
+    double tick_size = 0.01;
+    OrderBook book(tick_size, 0.01);
+    LaggedBookView view(book);
+
+    book.apply_book_update(
+        {0, 100, UpdateType::Incremental, BookSide::Bid, 100.0, 5.0});
+    book.apply_book_update(
+        {0, 100, UpdateType::Incremental, BookSide::Ask, 101.0, 3.0});
+    view.advance(50);
+
+    REQUIRE(book.best_bid() == 100.0);
+    REQUIRE(view.best_bid() == 0.0);
+    REQUIRE(view.mid_price() == 0.0);
+    REQUIRE(view.bid_book().empty());
+    REQUIRE(view.pending_changes() == 2);
+
+    view.advance(101);
+    REQUIRE(view.best_bid() == 100.0);
+    REQUIRE(view.best_ask() == 101.0);
+    REQUIRE(view.depth_at_level(BookSide::Ask, 0) == 3.0);
+    REQUIRE(view.pending_changes() == 0);
+
+    // a level removed on the exchange stays visible until delivered
+    book.apply_book_update(
+        {200, 300, UpdateType::Incremental, BookSide::Bid, 100.0, 0.0});
+    book.apply_book_update(
+        {200, 300, UpdateType::Incremental, BookSide::Bid, 99.0, 1.0});
+    view.advance(250);
+    REQUIRE(book.best_bid() == 99.0);
+    REQUIRE(view.best_bid() == 100.0);
+    REQUIRE(view.depth_at(BookSide::Bid,
+                          utils::math::price_to_ticks(99.0, tick_size)) == 0.0);
+    REQUIRE(view.bid_book().size() == 1);
+
+    view.advance(301);
+    REQUIRE(view.best_bid() == 99.0);
+    REQUIRE(view.depth_at_level(BookSide::Bid, 0) == 1.0);
+    REQUIRE(view.price_at_level(BookSide::Bid, 1) == 0);
+}
+
+TEST_CASE("[LaggedBookView] - matches a delayed full book",
+          "[lagged_book_view][equivalence]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+
+    double tick_size = 0.5;
+    OrderBook exchange_book(tick_size, 0.01);
+    OrderBook reference_book(tick_size, 0.01);
+    LaggedBookView view(exchange_book);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> level_dist(0, 15);
+    std::uniform_int_distribution<int> qty_dist(0, 4);
+    std::vector<BookUpdate> updates;
+    Timestamp ts = 1000;
+    for (int i = 0; i < 2000; ++i) {
+        if (i % 7 == 0) ts += 100;
+        bool snapshot = (i >= 900 && i < 920);
+        BookSide side = (level_dist(rng) % 2) ? BookSide::Bid : BookSide::Ask;
+        Price price = (side == BookSide::Bid)
+                          ? 100.0 - level_dist(rng) * tick_size
+                          : 100.5 + level_dist(rng) * tick_size;
+        Quantity qty = snapshot ? 1.0 + qty_dist(rng) : qty_dist(rng);
+        const auto type =
+            snapshot ? UpdateType::Snapshot : UpdateType::Incremental;
+        updates.push_back(BookUpdate{ts, ts + 350, type, side, price, qty});
+    }
+
+    std::size_t applied = 0;
+    std::size_t delivered = 0;
+    for (Timestamp now = 1000; now <= ts + 500; now += 130) {
+        while (applied < updates.size() &&
+               updates[applied].exch_timestamp_ < now) {
+            exchange_book.apply_book_update(updates[applied++]);
+        }
+        while (delivered < applied &&
+               updates[delivered].local_timestamp_ < now) {
+            reference_book.apply_book_update(updates[delivered++]);
+        }
+        view.advance(now);
+
+        REQUIRE(view.bid_book() == reference_book.bid_book());
+        REQUIRE(view.ask_book() == reference_book.ask_book());
+        REQUIRE(view.mid_price() == reference_book.mid_price());
+        for (int level = 0; level < 3; ++level) {
+            REQUIRE(view.price_at_level(BookSide::Bid, level) ==
+                    reference_book.price_at_level(BookSide::Bid, level));
+            REQUIRE(view.depth_at_level(BookSide::Ask, level) ==
+                    reference_book.depth_at_level(BookSide::Ask, level));
+        }
+    }
+    REQUIRE(view.pending_changes() == 0);
+}
+
+TEST_CASE("[LaggedBookView] - snapshots track the visible book",
+          "[lagged_book_view][snapshot]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+
+    OrderBook book(0.01, 0.01);
+    LaggedBookView view(book);
+
+    book.apply_book_update(
+        {0, 100, UpdateType::Incremental, BookSide::Bid, 100.0, 5.0});
+    view.advance(101);
+    auto first = view.snapshot(101);
+
+    book.apply_book_update(
+        {200, 300, UpdateType::Incremental, BookSide::Bid, 100.0, 2.0});
+    view.advance(250);
+    REQUIRE(BookSnapshot::diff(first, view.snapshot(250)).empty());
+
+    view.advance(301);
+    auto second = view.snapshot(301);
+    REQUIRE(first.depth_at_level(BookSide::Bid, 0) == 5.0);
+    REQUIRE(second.depth_at_level(BookSide::Bid, 0) == 2.0);
+    REQUIRE(second.bid_book() == view.bid_book());
+
+    auto changes = BookSnapshot::diff(first, second);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].from_quantity_ == 5.0);
+    REQUIRE(changes[0].to_quantity_ == 2.0);
+}
+
+TEST_CASE("[LaggedBookView] - snapshot loads reach the view as level changes",
+          "[lagged_book_view][snapshot]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+
+    OrderBook book(1.0, 0.01);
+    LaggedBookView view(book);
+    book.apply_book_update(
+        {0, 10, UpdateType::Incremental, BookSide::Bid, 100.0, 5.0});
+    book.apply_book_update(
+        {0, 10, UpdateType::Incremental, BookSide::Bid, 99.0, 1.0});
+    view.advance(11);
+
+    DepthSnapshot snapshot{};
+    snapshot.local_timestamp_ = 20;
+    snapshot.bid_count_ = 2;
+    snapshot.bids_[0] = {100.0, 5.0}; // unchanged
+    snapshot.bids_[1] = {98.0, 2.0};  // replaces 99
+    snapshot.ask_count_ = 1;
+    snapshot.asks_[0] = {101.0, 3.0};
+    book.load_snapshot(snapshot);
+
+    // only the three levels that differ are pending
+    view.advance(15);
+    REQUIRE(view.pending_changes() == 3);
+    REQUIRE(view.depth_at_level(BookSide::Bid, 1) == 1.0);
+
+    view.advance(21);
+    REQUIRE(view.bid_book() == book.bid_book());
+    REQUIRE(view.ask_book() == book.ask_book());
+}
+
+TEST_CASE("[LaggedBookView] - batched updates reach the view as rows do",
+          "[lagged_book_view][batch]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+
+    double tick_size = 0.5;
+    OrderBook batched(tick_size, 0.01);
+    OrderBook per_row(tick_size, 0.01);
+    LaggedBookView batched_view(batched);
+    LaggedBookView per_row_view(per_row);
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> level(0, 30);
+    std::uniform_int_distribution<int> size(0, 3);
+    for (Timestamp ts = 1; ts <= 200; ++ts) {
+        BookUpdateBatch batch{ts, ts + 5, {}};
+        int rows = 1 + level(rng) % 8;
+        for (int i = 0; i < rows; ++i) {
+            BookSide side = (level(rng) % 2) ? BookSide::Bid : BookSide::Ask;
+            double base = (side == BookSide::Bid) ? 80.0 : 96.0;
+            batch.updates_.push_back({ts, ts + 5, UpdateType::Incremental,
+                                      side, base + 0.5 * level(rng),
+                                      static_cast<Quantity>(size(rng))});
+        }
+        batched.apply_book_updates(batch);
+        for (const auto &row : batch.updates_) per_row.apply_book_update(row);
+        batched_view.advance(ts + 2);
+        per_row_view.advance(ts + 2);
+        REQUIRE(batched_view.bid_book() == per_row_view.bid_book());
+        REQUIRE(batched_view.ask_book() == per_row_view.ask_book());
+    }
+}
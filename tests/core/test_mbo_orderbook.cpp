@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+
+#include "core/market_data/mbo_update.h"
+#include "core/orderbook/mbo_orderbook.h"
+#include "core/types/enums/book_side.h"
+#include "core/types/enums/mbo_action.h"
+
+namespace {
+core::market_data::MboUpdate mbo(std::uint64_t id, MboAction action,
+                                 BookSide side, Price price, Quantity qty) {
+    return core::market_data::MboUpdate{.exch_timestamp_ = 0,
+                                        .local_timestamp_ = 0,
+                                        .order_id_ = id,
+                                        .action_ = action,
+                                        .side_ = side,
+                                        .price_ = price,
+                                        .quantity_ = qty};
+}
+} // namespace
+
+TEST_CASE("[MboOrderBook] - per-order add, modify and delete",
+          "[mbo_orderbook]") {
+    using namespace core::orderbook;
+
+    MboOrderBook book(1.0, 0.1);
+    std::array<MboOrderBook::LevelKey, 2> touched;
+
+    REQUIRE(book.apply(mbo(1, MboAction::Add, BookSide::Bid, 100, 2.0),
+                       touched) == 1);
+    book.apply(mbo(2, MboAction::Add, BookSide::Bid, 100, 3.0), touched);
+    book.apply(mbo(3, MboAction::Add, BookSide::Ask, 101, 1.0), touched);
+
+    REQUIRE(book.depth_at(BookSide::Bid, 100) == 5.0);
+    REQUIRE(book.order_count_at(BookSide::Bid, 100) == 2);
+    REQUIRE(book.best_bid() == 100.0);
+    REQUIRE(book.best_ask() == 101.0);
+    REQUIRE(book.order_count() == 3);
+
+    SECTION("size reduction keeps priority") {
+        std::uint64_t ours = book.next_sequence();
+        book.apply(mbo(4, MboAction::Add, BookSide::Bid, 100, 1.0), touched);
+        book.apply(mbo(1, MboAction::Modify, BookSide::Bid, 100, 1.5),
+                   touched);
+        REQUIRE(book.depth_at(BookSide::Bid, 100) == 5.5);
+        REQUIRE(book.volume_ahead(BookSide::Bid, 100, ours) == 4.5);
+    }
+
+    SECTION("size increase loses priority") {
+        std::uint64_t ours = book.next_sequence();
+        book.apply(mbo(1, MboAction::Modify, BookSide::Bid, 100, 4.0),
+                   touched);
+        REQUIRE(book.depth_at(BookSide::Bid, 100) == 7.0);
+        REQUIRE(book.volume_ahead(BookSide::Bid, 100, ours) == 3.0);
+    }
+
+    SECTION("price change touches both levels") {
+        REQUIRE(book.apply(mbo(2, MboAction::Modify, BookSide::Bid, 99, 3.0),
+                           touched) == 2);
+        REQUIRE(touched[0].price_ == 100);
+        REQUIRE(touched[1].price_ == 99);
+        REQUIRE(book.depth_at(BookSide::Bid, 100) == 2.0);
+        REQUIRE(book.depth_at(BookSide::Bid, 99) == 3.0);
+    }
+
+    SECTION("delete removes the order and empty levels") {
+        REQUIRE(book.apply(mbo(3, MboAction::Delete, BookSide::Ask, 0, 0),
+                           touched) == 1);
+        REQUIRE(book.best_ask() == 0.0);
+        REQUIRE(book.order_count_at(BookSide::Ask, 101) == 0);
+        // unknown ids are ignored
+        REQUIRE(book.apply(mbo(42, MboAction::Delete, BookSide::Ask, 0, 0),
+                           touched) == 0);
+        REQUIRE(book.order_count() == 2);
+    }
+}
+
+TEST_CASE("[MboOrderBook] - order index survives growth and churn",
+          "[mbo_orderbook][index]") {
+    using namespace core::orderbook;
+
+    MboOrderBook book(1.0, 0.1);
+    std::array<MboOrderBook::LevelKey, 2> touched;
+    for (std::uint64_t id = 1; id <= 5000; ++id) {
+        book.apply(mbo(id * 7919, MboAction::Add, BookSide::Bid,
+                       100 + static_cast<double>((id / 2) % 10), 1.0),
+                   touched);
+    }
+    for (std::uint64_t id = 1; id <= 5000; id += 2) {
+        book.apply(mbo(id * 7919, MboAction::Delete, BookSide::Bid, 0, 0),
+                   touched);
+    }
+    REQUIRE(book.order_count() == 2500);
+    for (int level = 0; level < 10; ++level) {
+        REQUIRE(book.order_count_at(BookSide::Bid, 100 + level) == 250);
+        REQUIRE(book.depth_at(BookSide::Bid, 100 + level) == 250.0);
+    }
+    for (std::uint64_t id = 2; id <= 5000; id += 2) {
+        book.apply(mbo(id * 7919, MboAction::Delete, BookSide::Bid, 0, 0),
+                   touched);
+    }
+    REQUIRE(book.order_count() == 0);
+    REQUIRE(book.best_bid() == 0.0);
+}
@@ -6,8 +6,11 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+#include <random>
 
 #include "core/market_data/book_update.h"
+#include "core/market_data/book_update_batch.h"
+#include "core/market_data/depth_snapshot.h"
 #include "core/orderbook/orderbook.h"
 #include "core/types/enums/book_side.h"
 #include "core/types/enums/update_type.h"
@@ -176,4 +179,101 @@ TEST_CASE("[OrderBook] - Edge Cases", "[orderbook][edge]") {
         REQUIRE_THROWS(book.apply_book_update(
             {0, 0, UpdateType::Snapshot, BookSide::Ask, -1.0, 100.0}));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("[OrderBook] - Snapshot Loading", "[orderbook][snapshot]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+
+    double tick_size = 0.5;
+    OrderBook book(tick_size, 0.01);
+    book.apply_book_update(
+        {0, 0, UpdateType::Incremental, BookSide::Bid, 90.0, 7.0});
+    book.apply_book_update(
+        {0, 0, UpdateType::Incremental, BookSide::Ask, 120.0, 7.0});
+
+    DepthSnapshot snapshot{};
+    snapshot.bid_count_ = 3;
+    snapshot.bids_[0] = {100.0, 1.0};
+    snapshot.bids_[1] = {99.5, 2.0};
+    snapshot.bids_[2] = {98.0, 3.0};
+    snapshot.ask_count_ = 2;
+    snapshot.asks_[0] = {100.5, 4.0};
+    snapshot.asks_[1] = {101.0, 5.0};
+    book.load_snapshot(snapshot);
+
+    REQUIRE(book.bid_levels() == 3);
+    REQUIRE(book.ask_levels() == 2);
+    REQUIRE(book.best_bid() == 100.0);
+    REQUIRE(book.best_ask() == 100.5);
+    REQUIRE(book.depth_at_level(BookSide::Bid, 2) == 3.0);
+    REQUIRE(book.depth_at_level(BookSide::Ask, 1) == 5.0);
+    // levels absent from the snapshot are gone
+    REQUIRE(book.depth_at(BookSide::Bid,
+                          utils::math::price_to_ticks(90.0, tick_size)) == 0.0);
+    REQUIRE(book.depth_at(BookSide::Ask,
+                          utils::math::price_to_ticks(120.0, tick_size)) ==
+            0.0);
+
+    SECTION("incremental updates apply on top of a snapshot") {
+        book.apply_book_update(
+            {1, 1, UpdateType::Incremental, BookSide::Ask, 100.5, 0.0});
+        REQUIRE(book.best_ask() == 101.0);
+    }
+
+    SECTION("negative quantities are rejected") {
+        snapshot.bids_[1].quantity_ = -1.0;
+        REQUIRE_THROWS(book.load_snapshot(snapshot));
+    }
+}
+
+TEST_CASE("[OrderBook] - Batch Updates", "[orderbook][batch]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+
+    double tick_size = 0.5;
+    OrderBook batched(tick_size, 0.01);
+    OrderBook per_row(tick_size, 0.01);
+
+    SECTION("batches leave the book as row-by-row updates do") {
+        // repeated levels, deletes of missing levels and snapshot rows
+        // following incremental ones within one batch
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> level(0, 40);
+        std::uniform_int_distribution<int> size(0, 4);
+        std::uniform_int_distribution<int> kind(0, 19);
+        for (Timestamp ts = 1; ts <= 300; ++ts) {
+            BookUpdateBatch batch{ts, ts, {}};
+            int rows = 1 + level(rng) % 12;
+            for (int i = 0; i < rows; ++i) {
+                BookSide side =
+                    (level(rng) % 2) ? BookSide::Bid : BookSide::Ask;
+                double base = (side == BookSide::Bid) ? 80.0 : 101.0;
+                batch.updates_.push_back(
+                    {ts, ts,
+                     kind(rng) == 0 ? UpdateType::Snapshot
+                                    : UpdateType::Incremental,
+                     side, base + 0.5 * level(rng),
+                     static_cast<Quantity>(size(rng))});
+            }
+            batched.apply_book_updates(batch);
+            for (const auto &row : batch.updates_) {
+                per_row.apply_book_update(row);
+            }
+            REQUIRE(batched.bid_book() == per_row.bid_book());
+            REQUIRE(batched.ask_book() == per_row.ask_book());
+        }
+        REQUIRE(batched.state_hash() == per_row.state_hash());
+    }
+
+    SECTION("a bad row rejects the whole batch") {
+        batched.apply_book_update(
+            {0, 0, UpdateType::Incremental, BookSide::Bid, 90.0, 1.0});
+        BookUpdateBatch batch{1, 1, {}};
+        batch.updates_.push_back(
+            {1, 1, UpdateType::Incremental, BookSide::Bid, 90.0, 2.0});
+        batch.updates_.push_back(
+            {1, 1, UpdateType::Incremental, BookSide::Bid, 89.0, -1.0});
+        REQUIRE_THROWS(batched.apply_book_updates(batch));
+        REQUIRE(batched.depth_at_level(BookSide::Bid, 0) == 1.0);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * File: tests/test_state_hasher.cpp
+ * Description: Unit tests for state hash checkpoints and divergence search.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-02
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/backtest_engine/state_hasher.h"
+
+namespace {
+// folds the same event values into a hasher, with one value swapped at
+// event `changed_event` (0 = none)
+void write_run(const std::string &file, std::uint64_t changed_event) {
+    core::backtest::StateHasher hasher(4, file);
+    for (std::uint64_t event = 1; event <= 10; ++event) {
+        hasher.fold(event == changed_event ? 1000 + event : event);
+        if (hasher.end_event()) hasher.checkpoint(event * 10, 42);
+    }
+    if (hasher.has_pending_events()) hasher.checkpoint(100, 42);
+}
+} // namespace
+
+TEST_CASE("[StateHasher] - checkpoints and divergence", "[state-hasher]") {
+    using core::backtest::StateHasher;
+    const std::string base = "test_state_hash_base.csv";
+    const std::string same = "test_state_hash_same.csv";
+    const std::string changed = "test_state_hash_changed.csv";
+    write_run(base, 0);
+    write_run(same, 0);
+    write_run(changed, 6);
+
+    const auto a = StateHasher::read(base);
+    REQUIRE(a.size() == 3);
+    REQUIRE(a[0].event_ == 4);
+    REQUIRE(a[0].timestamp_ == 40);
+    REQUIRE(a[1].event_ == 8);
+    REQUIRE(a[2].event_ == 10); // final partial interval
+
+    SECTION("Identical runs match") {
+        REQUIRE_FALSE(
+            StateHasher::first_divergence(a, StateHasher::read(same)));
+    }
+    SECTION("A changed event is bracketed by checkpoints") {
+        auto divergence =
+            StateHasher::first_divergence(a, StateHasher::read(changed));
+        REQUIRE(divergence.has_value());
+        REQUIRE(divergence->last_matching_event_ == 4);
+        REQUIRE(divergence->event_ == 8);
+        REQUIRE(divergence->timestamp_ == 80);
+    }
+    SECTION("A run with more checkpoints diverges after the common ones") {
+        auto shorter = a;
+        shorter.pop_back();
+        auto divergence = StateHasher::first_divergence(shorter, a);
+        REQUIRE(divergence.has_value());
+        REQUIRE(divergence->last_matching_event_ == 8);
+        REQUIRE(divergence->event_ == 10);
+    }
+    SECTION("Invalid input") {
+        REQUIRE_THROWS_AS(StateHasher(0, "unused.csv"), std::invalid_argument);
+        REQUIRE_THROWS_AS(StateHasher::read("missing_state_hash.csv"),
+                          std::runtime_error);
+    }
+
+    std::filesystem::remove(base);
+    std::filesystem::remove(same);
+    std::filesystem::remove(changed);
+}
@@ -0,0 +1,162 @@
+/*
+ * File: tests/test_sweep_runner.cpp
+ * Description: Unit tests for event tapes and NUMA-aware parameter sweeps.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-08
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/backtest_engine/backtest_engine.h"
+#include "core/backtest_engine/sweep_runner.h"
+#include "core/market_data/event_tape.h"
+#include "core/market_data/market_data_feed.h"
+#include "core/market_data/market_event.h"
+#include "core/types/enums/order_type.h"
+#include "core/types/enums/time_in_force.h"
+
+namespace {
+void create_book_csv(const std::string &filename) {
+    std::ofstream f(filename);
+    f << "timestamp,local_timestamp,is_snapshot,side,price,amount\n"
+      << "1000,2000,false,ask,50001.0,1.5\n"
+      << "1000,2000,false,bid,49999.0,1.5\n"
+      << "20000,21000,false,bid,50000.0,2.0\n"
+      << "30000,31000,false,bid,50000.5,2.0\n"
+      << "40000,41000,false,ask,50001.0,1.5\n"
+      << "50000,51000,false,ask,50001.0,2.5\n";
+}
+
+void create_trade_csv(const std::string &filename) {
+    std::ofstream f(filename);
+    f << "timestamp,local_timestamp,id,side,price,amount\n"
+      << "10000,11000,1,buy,50000.0,1.0\n"
+      << "35000,36000,2,sell,49999.0,1.0\n"
+      << "45000,46000,3,sell,49998.0,2.0\n";
+}
+
+// sells a run-dependent quantity at market into the 2.0 bid at 50000.5
+double run_backtest(core::backtest::BacktestEngine &engine, std::size_t run) {
+    engine.elapse(35'000);
+    engine.submit_sell_order(1, 0.0, 0.5 * (1 + run % 4), TimeInForce::GTC,
+                             OrderType::MARKET);
+    for (int i = 0; i < 10; ++i) engine.elapse(10'000);
+    return engine.position(1) * 100'000.0 + engine.cash();
+}
+} // namespace
+
+TEST_CASE("[SweepRunner] - sweeps over a shared tape match file-backed runs",
+          "[sweep-runner]") {
+    using namespace core::backtest;
+    using namespace core::trading;
+    const std::string book_file = "test_sweep_book.csv";
+    const std::string trade_file = "test_sweep_trade.csv";
+    create_book_csv(book_file);
+    create_trade_csv(trade_file);
+    const std::unordered_map<int, AssetConfig> asset_configs = {
+        {1, AssetConfig{.book_update_file_ = book_file,
+                        .trade_file_ = trade_file,
+                        .tick_size_ = 0.5,
+                        .lot_size_ = 0.001,
+                        .contract_multiplier_ = 1.0,
+                        .is_inverse_ = false,
+                        .maker_fee_ = 0.0,
+                        .taker_fee_ = 0.0}}};
+    const BacktestEngineConfig engine_config{.initial_cash_ = 100'000.0,
+                                             .order_entry_latency_us_ = 1000,
+                                             .order_response_latency_us_ =
+                                                 1000,
+                                             .market_feed_latency_us_ = 1000};
+
+    SECTION("A tape replays the files' events in the same order") {
+        core::market_data::EventTape tape;
+        tape.add_asset(1, book_file, trade_file, false);
+        REQUIRE(tape.events() == 9);
+        REQUIRE(tape.asset(2) == nullptr);
+
+        core::market_data::MarketDataFeed from_files;
+        from_files.add_stream(1, book_file, trade_file);
+        core::market_data::MarketDataFeed from_tape;
+        from_tape.add_tape_stream(1, *tape.asset(1));
+        core::market_data::MarketEvent file_event, tape_event;
+        while (from_files.next_event(file_event)) {
+            REQUIRE(from_tape.next_event(tape_event));
+            REQUIRE(tape_event.event_type_ == file_event.event_type_);
+            if (file_event.event_type_ == EventType::BookUpdateBatch) {
+                const auto &file_rows = file_event.book_batch_.updates_;
+                const auto &tape_rows = tape_event.book_batch_.updates_;
+                REQUIRE(tape_rows.size() == file_rows.size());
+                for (std::size_t i = 0; i < file_rows.size(); ++i) {
+                    REQUIRE(tape_rows[i].exch_timestamp_ ==
+                            file_rows[i].exch_timestamp_);
+                    REQUIRE(tape_rows[i].local_timestamp_ ==
+                            file_rows[i].local_timestamp_);
+                    REQUIRE(tape_rows[i].price_ == file_rows[i].price_);
+                }
+            } else {
+                REQUIRE(tape_event.trade_.local_timestamp_ ==
+                        file_event.trade_.local_timestamp_);
+            }
+        }
+        REQUIRE_FALSE(from_tape.next_event(tape_event));
+    }
+
+    SECTION("Every run's result matches a run read from the files") {
+        const std::size_t runs = 12;
+        std::vector<double> expected;
+        for (std::size_t run = 0; run < runs; ++run) {
+            BacktestEngine engine(asset_configs, engine_config);
+            expected.push_back(run_backtest(engine, run));
+        }
+        REQUIRE(expected[0] != expected[3]); // the parameter matters
+
+        for (bool numa : {true, false}) {
+            SweepRunner sweep(asset_configs, engine_config,
+                              SweepConfig{.workers_per_node_ = 2,
+                                          .numa_ = numa,
+                                          .arena_bytes_ = 1 << 16,
+                                          .compress_tape_ = numa});
+            REQUIRE(sweep.run(runs, run_backtest) == expected);
+            REQUIRE(sweep.tape_bytes() > 0);
+
+            std::size_t total = 0;
+            for (const auto &node : sweep.node_stats()) {
+                REQUIRE(node.workers_ == 2);
+                total += node.runs_;
+            }
+            REQUIRE(total == runs);
+            REQUIRE(sweep.node_stats().size() == sweep.nodes().size());
+            REQUIRE(sweep.format_node_stats().find("node ") == 0);
+        }
+    }
+
+    SECTION("Job exceptions are rethrown after the workers stop") {
+        SweepRunner sweep(asset_configs, engine_config,
+                          SweepConfig{.workers_per_node_ = 2});
+        REQUIRE_THROWS_AS(
+            sweep.run(8,
+                      [](BacktestEngine &, std::size_t run) -> double {
+                          if (run == 3) throw std::runtime_error("bad run");
+                          return 0.0;
+                      }),
+            std::runtime_error);
+    }
+
+    SECTION("Configs with shared output files are rejected") {
+        auto traced = engine_config;
+        traced.trace_file_ = "sweep.trace";
+        REQUIRE_THROWS_AS(SweepRunner(asset_configs, traced),
+                          std::invalid_argument);
+    }
+
+    std::filesystem::remove(book_file);
+    std::filesystem::remove(trade_file);
+}
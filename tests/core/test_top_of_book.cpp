@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+#include "core/market_data/quote.h"
+#include "core/orderbook/top_of_book.h"
+#include "core/types/enums/book_side.h"
+
+namespace {
+core::market_data::Quote quote(Price bid, Quantity bid_qty, Price ask,
+                               Quantity ask_qty) {
+    return core::market_data::Quote{.exch_timestamp_ = 0,
+                                    .local_timestamp_ = 0,
+                                    .bid_price_ = bid,
+                                    .bid_quantity_ = bid_qty,
+                                    .ask_price_ = ask,
+                                    .ask_quantity_ = ask_qty};
+}
+} // namespace
+
+TEST_CASE("[TopOfBook] - exposes the touch as a one-level book",
+          "[top_of_book]") {
+    using namespace core::orderbook;
+
+    TopOfBook book(0.5, 0.1);
+    REQUIRE(book.is_empty());
+    REQUIRE(book.mid_price() == 0.0);
+
+    book.apply_quote(quote(100.0, 2.0, 101.0, 3.0));
+    REQUIRE(book.best_bid() == 100.0);
+    REQUIRE(book.best_ask() == 101.0);
+    REQUIRE(book.mid_price() == 100.5);
+    REQUIRE(book.bid_levels() == 1);
+    REQUIRE(book.ask_levels() == 1);
+    REQUIRE(book.price_at_level(BookSide::Bid, 0) == 200);
+    REQUIRE(book.price_at_level(BookSide::Ask, 0) == 202);
+    REQUIRE(book.depth_at_level(BookSide::Ask, 0) == 3.0);
+    REQUIRE(book.depth_at(BookSide::Bid, 200) == 2.0);
+
+    SECTION("levels behind the touch are invisible") {
+        REQUIRE(book.depth_at(BookSide::Bid, 199) == 0.0);
+        REQUIRE(book.depth_at_level(BookSide::Bid, 1) == 0.0);
+        REQUIRE(book.price_at_level(BookSide::Ask, 1) == 0);
+    }
+
+    SECTION("each quote replaces both sides") {
+        book.apply_quote(quote(99.5, 1.0, 0.0, 0.0));
+        REQUIRE(book.best_bid() == 99.5);
+        REQUIRE(book.depth_at(BookSide::Bid, 200) == 0.0);
+        REQUIRE(book.ask_levels() == 0);
+        REQUIRE(book.mid_price() == 0.0);
+    }
+
+    SECTION("clear empties the book") {
+        book.clear();
+        REQUIRE(book.is_empty());
+    }
+
+    SECTION("negative sizes are rejected") {
+        REQUIRE_THROWS_AS(book.apply_quote(quote(100.0, -1.0, 101.0, 1.0)),
+                          std::invalid_argument);
+    }
+}
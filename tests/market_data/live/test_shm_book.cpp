@@ -0,0 +1,216 @@
+/*
+ * File: tests/market_data/live/test_shm_book.cpp
+ * Description: Unit tests for the shared-memory live book and its seqlock.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-12
+ * License: Proprietary
+ */
+
+#include <atomic>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "core/market_data/book_update.h"
+#include "core/market_data/live/live_book_publisher.h"
+#include "core/market_data/live/shm_book.h"
+#include "core/market_data/trade.h"
+
+namespace {
+using core::market_data::BookUpdate;
+using core::market_data::live::DepthDiff;
+using core::market_data::live::LiveBookPublisher;
+using core::market_data::live::ShmBookFrame;
+using core::market_data::live::ShmBookReader;
+using core::market_data::live::ShmBookTop;
+using core::market_data::live::ShmBookWriter;
+
+std::string unique_name(const std::string &test) {
+    return "/cqe_test_" + test + "_" + std::to_string(getpid());
+}
+} // namespace
+
+TEST_CASE("LiveBookPublisher publishes best levels, BBO and last trade",
+          "[shm_book]") {
+    const std::string name = unique_name("publisher");
+    {
+        LiveBookPublisher publisher(name, "XRPUSDC", 0.0001, 0.1, 2);
+        ShmBookReader reader(name);
+        REQUIRE(reader.symbol() == "XRPUSDC");
+        REQUIRE(reader.depth() == 2);
+
+        ShmBookTop top;
+        REQUIRE(reader.try_read(top));
+        REQUIRE(top.updates_ == 0);
+
+        publisher.publish_book({
+            BookUpdate{100, 110, UpdateType::Snapshot, BookSide::Bid, 2.8700,
+                       10.0},
+            BookUpdate{100, 110, UpdateType::Snapshot, BookSide::Bid, 2.8699,
+                       20.0},
+            BookUpdate{100, 110, UpdateType::Snapshot, BookSide::Bid, 2.8698,
+                       30.0},
+            BookUpdate{100, 110, UpdateType::Snapshot, BookSide::Ask, 2.8702,
+                       15.0},
+            BookUpdate{100, 110, UpdateType::Snapshot, BookSide::Ask, 2.8703,
+                       25.0},
+        });
+        const std::uint64_t sequence = reader.sequence();
+        ShmBookFrame frame;
+        reader.read(frame);
+        REQUIRE(frame.top_.updates_ == 1);
+        REQUIRE(frame.top_.exch_timestamp_ == 100);
+        REQUIRE(frame.top_.local_timestamp_ == 110);
+        REQUIRE(frame.top_.best_bid_.price_ ==
+                Catch::Approx(2.8700).margin(1e-9));
+        REQUIRE(frame.top_.best_bid_.quantity_ == 10.0);
+        REQUIRE(frame.top_.best_ask_.price_ ==
+                Catch::Approx(2.8702).margin(1e-9));
+        REQUIRE(frame.bid_count_ == 2); // capped at the depth
+        REQUIRE(frame.ask_count_ == 2);
+        REQUIRE(frame.bids_[1].price_ == Catch::Approx(2.8699).margin(1e-9));
+        REQUIRE(frame.asks_[1].quantity_ == 25.0);
+
+        // a deleted best bid moves the BBO down a level
+        publisher.publish_book({BookUpdate{200, 210, UpdateType::Incremental,
+                                           BookSide::Bid, 2.8700, 0.0}});
+        core::market_data::Trade trade{205, 215, TradeSide::Sell, 2.8699,
+                                       4.0, 77};
+        publisher.publish_trade(trade);
+        REQUIRE(reader.sequence() != sequence);
+        reader.read(top);
+        REQUIRE(top.updates_ == 3);
+        REQUIRE(top.best_bid_.price_ == Catch::Approx(2.8699).margin(1e-9));
+        REQUIRE(top.trade_price_ == 2.8699);
+        REQUIRE(top.trade_quantity_ == 4.0);
+        REQUIRE(top.trade_side_ == TradeSide::Sell);
+        REQUIRE(top.trade_local_timestamp_ == 215);
+    }
+    // the writer unlinks the region when it goes away
+    REQUIRE_THROWS_AS(ShmBookReader(name), std::runtime_error);
+    REQUIRE_THROWS_AS(ShmBookReader("no_slash"), std::invalid_argument);
+    REQUIRE_THROWS_AS(ShmBookWriter(name, "XRPUSDC", 0),
+                      std::invalid_argument);
+}
+
+TEST_CASE("LiveBookPublisher applies depth diffs in update-id order",
+          "[shm_book][sequence]") {
+    const std::string name = unique_name("sequence");
+    LiveBookPublisher publisher(name, "XRPUSDC", 0.5, 0.1, 5);
+    ShmBookReader reader(name);
+    ShmBookTop top;
+    auto bid = [](Timestamp ts, double price, double quantity) {
+        return BookUpdate{ts, ts, UpdateType::Incremental, BookSide::Bid,
+                          price, quantity};
+    };
+    auto diff = [](std::uint64_t first, std::uint64_t final,
+                   std::uint64_t prev, std::vector<BookUpdate> rows) {
+        return DepthDiff{first, final, prev, std::move(rows)};
+    };
+    const std::vector<BookUpdate> snapshot = {
+        BookUpdate{100, 100, UpdateType::Snapshot, BookSide::Bid, 10.0, 1.0},
+        BookUpdate{100, 100, UpdateType::Snapshot, BookSide::Ask, 11.0, 1.0}};
+
+    // diffs arriving before the snapshot wait for it
+    REQUIRE(publisher.needs_snapshot());
+    publisher.publish_diff(diff(90, 95, 89, {bid(95, 10.0, 5.0)}));
+    publisher.publish_diff(diff(96, 105, 95, {bid(105, 10.5, 2.0)}));
+    reader.read(top);
+    REQUIRE(top.updates_ == 0);
+
+    // 90..95 is older than the snapshot and dropped; 96..105 straddles it
+    publisher.publish_snapshot(snapshot, 100);
+    REQUIRE_FALSE(publisher.needs_snapshot());
+    reader.read(top);
+    REQUIRE(top.best_bid_.price_ == 10.5);
+    REQUIRE(top.exch_timestamp_ == 105);
+
+    SECTION("continuing diffs apply") {
+        publisher.publish_diff(diff(106, 110, 105, {bid(110, 10.5, 0.0)}));
+        reader.read(top);
+        REQUIRE(top.best_bid_.price_ == 10.0);
+        REQUIRE(top.best_bid_.quantity_ == 1.0);
+        // an older snapshot does not roll the book back
+        publisher.publish_snapshot(snapshot, 108);
+        publisher.publish_diff(diff(111, 112, 110, {bid(112, 9.5, 3.0)}));
+        reader.read(top);
+        REQUIRE(top.exch_timestamp_ == 112);
+        REQUIRE_FALSE(publisher.needs_snapshot());
+    }
+
+    SECTION("a gap waits for the next snapshot") {
+        publisher.publish_diff(diff(120, 125, 119, {bid(125, 10.5, 0.0)}));
+        REQUIRE(publisher.needs_snapshot());
+        reader.read(top);
+        REQUIRE(top.best_bid_.price_ == 10.5);
+
+        publisher.publish_diff(diff(126, 130, 125, {bid(130, 9.0, 7.0)}));
+        publisher.publish_snapshot(snapshot, 127);
+        REQUIRE_FALSE(publisher.needs_snapshot());
+        reader.read(top);
+        // 120..125 is covered by the snapshot, 126..130 applies on top
+        REQUIRE(top.best_bid_.price_ == 10.0);
+        REQUIRE(top.exch_timestamp_ == 130);
+    }
+
+    SECTION("an invalid row resyncs instead of throwing") {
+        REQUIRE_NOTHROW(publisher.publish_diff(
+            diff(106, 110, 105, {bid(110, 10.0, -1.0)})));
+        REQUIRE(publisher.needs_snapshot());
+        reader.read(top);
+        REQUIRE(top.best_bid_.price_ == 10.5);
+    }
+}
+
+TEST_CASE("Concurrent readers never see a torn frame", "[shm_book]") {
+    const std::string name = unique_name("seqlock");
+    ShmBookWriter writer(name, "TEST", 25);
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<std::uint64_t> reads{0};
+    std::atomic<int> attached{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            ShmBookReader reader(name);
+            ShmBookFrame frame;
+            ++attached;
+            while (!done.load()) {
+                if (!reader.try_read(frame)) continue;
+                // every field of frame n holds n
+                const auto n = static_cast<double>(frame.top_.updates_);
+                bool consistent = frame.top_.best_bid_.price_ == n &&
+                                  frame.bid_count_ == frame.top_.updates_;
+                for (const auto &level : frame.asks_) {
+                    consistent = consistent && level.quantity_ == n;
+                }
+                if (!consistent) ++torn;
+                ++reads;
+            }
+        });
+    }
+    while (attached.load() < 2) {
+    }
+    ShmBookFrame frame{};
+    for (std::uint64_t n = 1; n <= 200'000; ++n) {
+        const auto value = static_cast<double>(n);
+        frame.top_.updates_ = n;
+        frame.top_.best_bid_ = {value, value};
+        frame.bid_count_ = n;
+        for (auto &level : frame.asks_) level = {value, value};
+        writer.publish(frame);
+    }
+    done = true;
+    for (auto &reader : readers) reader.join();
+
+    REQUIRE(torn.load() == 0);
+    REQUIRE(reads.load() > 0);
+}
@@ -0,0 +1,122 @@
+/*
+ * File: tests/test_book_checkpoint.cpp
+ * Description: Unit tests for book checkpoint side-car files and resuming a
+ * MarketDataFeed from them.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-04
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/market_data/book_checkpoint.h"
+#include "core/market_data/book_update_batch.h"
+#include "core/market_data/market_data_feed.h"
+#include "core/market_data/market_event.h"
+#include "core/orderbook/orderbook.h"
+#include "core/types/enums/event_type.h"
+
+namespace {
+void create_book_csv(const std::string &filename) {
+    std::ofstream f(filename);
+    f << "timestamp,local_timestamp,is_snapshot,side,price,amount\n"
+      << "100,110,true,bid,100.0,1.0\n"
+      << "100,110,true,ask,101.0,1.0\n"
+      << "200,210,false,bid,100.5,2.0\n"
+      << "300,310,false,ask,101.0,0\n"
+      << "300,310,false,ask,101.5,3.0\n"
+      << "400,410,false,bid,100.0,0\n"
+      << "500,510,false,bid,99.0,4.0\n"
+      << "600,610,false,ask,102.0,1.0\n";
+}
+
+void create_trade_csv(const std::string &filename) {
+    std::ofstream f(filename);
+    f << "timestamp,local_timestamp,id,side,price,amount\n"
+      << "150,160,1,buy,101.0,0.1\n"
+      << "300,310,2,sell,100.5,0.2\n"
+      << "350,360,3,buy,101.5,0.3\n"
+      << "550,560,4,sell,100.5,0.4\n";
+}
+
+struct Event {
+    EventType type_;
+    Timestamp timestamp_;
+    bool operator==(const Event &) const = default;
+};
+
+// drains the feed, applying its book batches to @p book
+std::vector<Event> drain(core::market_data::MarketDataFeed &feed,
+                         core::orderbook::OrderBook &book) {
+    using namespace core::market_data;
+    std::vector<Event> events;
+    MarketEvent event;
+    while (feed.next_event(event)) {
+        if (event.event_type_ == EventType::BookUpdateBatch) {
+            book.apply_book_updates(event.book_batch_);
+            events.push_back(
+                {event.event_type_, event.book_batch_.exch_timestamp_});
+        } else {
+            events.push_back({event.event_type_, event.trade_.exch_timestamp_});
+        }
+    }
+    return events;
+}
+} // namespace
+
+TEST_CASE("[BookCheckpoint] - resumes a feed mid-file as a full replay would",
+          "[book-checkpoint]") {
+    using namespace core::market_data;
+    const std::string book_file = "test_ckpt_book.csv";
+    const std::string trade_file = "test_ckpt_trade.csv";
+    const std::string ckpt_file = "test_ckpt_book.csv.ckpt";
+    create_book_csv(book_file);
+    create_trade_csv(trade_file);
+
+    // due every 150us: taken after the rows at 200, 300 and 500
+    REQUIRE(write_book_checkpoints(book_file, trade_file, 0.5, 0.1, 150,
+                                   ckpt_file) == 3);
+    REQUIRE_FALSE(find_book_checkpoint(ckpt_file, 199).has_value());
+
+    const auto checkpoint = find_book_checkpoint(ckpt_file, 450);
+    REQUIRE(checkpoint.has_value());
+    REQUIRE(checkpoint->exch_timestamp_ == 300);
+    REQUIRE(checkpoint->local_timestamp_ == 310);
+    REQUIRE(checkpoint->bids_ ==
+            std::vector<std::pair<Price, Quantity>>{{100.5, 2.0},
+                                                    {100.0, 1.0}});
+    REQUIRE(checkpoint->asks_ ==
+            std::vector<std::pair<Price, Quantity>>{{101.5, 3.0}});
+
+    MarketDataFeed full;
+    full.add_stream(1, book_file, trade_file);
+    core::orderbook::OrderBook full_book(0.5, 0.1);
+    const auto full_events = drain(full, full_book);
+
+    MarketDataFeed seeded;
+    seeded.add_stream(1, book_file, trade_file, *checkpoint);
+    core::orderbook::OrderBook seeded_book(0.5, 0.1);
+    const auto seeded_events = drain(seeded, seeded_book);
+
+    // the seed arrives as one snapshot batch, then the stream continues
+    // exactly where the full replay was after its book batch at 300
+    REQUIRE(seeded_events.front() ==
+            Event{EventType::BookUpdateBatch, 300});
+    const std::vector<Event> full_tail(full_events.begin() + 4,
+                                       full_events.end());
+    REQUIRE(full_events[3] == Event{EventType::BookUpdateBatch, 300});
+    REQUIRE(std::vector<Event>(seeded_events.begin() + 1,
+                               seeded_events.end()) == full_tail);
+    REQUIRE(seeded_book.bid_book() == full_book.bid_book());
+    REQUIRE(seeded_book.ask_book() == full_book.ask_book());
+
+    std::filesystem::remove(book_file);
+    std::filesystem::remove(trade_file);
+    std::filesystem::remove(ckpt_file);
+}
@@ -0,0 +1,133 @@
+/*
+ * File: tests/test_compressed_book_tape.cpp
+ * Description: Unit tests for the block-compressed columnar book tape.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-10
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/market_data/book_update.h"
+#include "core/market_data/compressed_book_tape.h"
+
+namespace {
+using core::market_data::BookUpdate;
+using core::market_data::CompressedBookTape;
+
+// a liquid book: bursts of updates a few ticks around a drifting mid
+std::vector<BookUpdate> make_rows(std::size_t count) {
+    std::mt19937_64 rng(42);
+    std::vector<BookUpdate> rows;
+    Timestamp exch = 1'700'000'000'000'000;
+    std::int64_t mid = 5'000'000; // in 0.01 ticks
+    for (std::size_t i = 0; i < count; ++i) {
+        if (rng() % 4 == 0) exch += rng() % 5'000;
+        if (rng() % 16 == 0) mid += static_cast<std::int64_t>(rng() % 5) - 2;
+        const bool bid = rng() % 2 == 0;
+        const std::int64_t offset = static_cast<std::int64_t>(rng() % 20);
+        const std::int64_t ticks = bid ? mid - 1 - offset : mid + 1 + offset;
+        const std::uint64_t lots = rng() % 3 == 0 ? 0 : rng() % 50'000;
+        rows.push_back(BookUpdate{
+            exch, exch + 800 + rng() % 400,
+            i < 100 ? UpdateType::Snapshot : UpdateType::Incremental,
+            bid ? BookSide::Bid : BookSide::Ask, ticks / 100.0,
+            lots / 1000.0});
+    }
+    return rows;
+}
+
+bool same_bits(const BookUpdate &a, const BookUpdate &b) {
+    return a.exch_timestamp_ == b.exch_timestamp_ &&
+           a.local_timestamp_ == b.local_timestamp_ &&
+           a.update_type_ == b.update_type_ && a.side_ == b.side_ &&
+           std::memcmp(&a.price_, &b.price_, sizeof(Price)) == 0 &&
+           std::memcmp(&a.quantity_, &b.quantity_, sizeof(Quantity)) == 0;
+}
+
+std::vector<BookUpdate> replay(const CompressedBookTape &tape) {
+    std::vector<BookUpdate> rows;
+    auto cursor = tape.cursor();
+    BookUpdate row;
+    while (cursor.next(row)) rows.push_back(row);
+    return rows;
+}
+} // namespace
+
+TEST_CASE("[CompressedBookTape] - rows replay bit for bit",
+          "[compressed-book-tape]") {
+    const auto rows = make_rows(10'000);
+
+    SECTION("Across full blocks, a short block and pending rows") {
+        CompressedBookTape tape(0.01, 0.001, 1024);
+        for (std::size_t i = 0; i < 9'000; ++i) tape.append(rows[i]);
+        tape.flush();
+        for (std::size_t i = 9'000; i < rows.size(); ++i) tape.append(rows[i]);
+        REQUIRE(tape.size() == rows.size());
+        REQUIRE(tape.escapes() == 0);
+
+        const auto replayed = replay(tape);
+        REQUIRE(replayed.size() == rows.size());
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            REQUIRE(same_bits(replayed[i], rows[i]));
+        }
+    }
+
+    SECTION("Compresses a liquid book at least four times") {
+        CompressedBookTape tape(0.01, 0.001);
+        for (const auto &row : rows) tape.append(row);
+        tape.flush();
+        REQUIRE(tape.compression_ratio() >= 4.0);
+    }
+
+    SECTION("Off-grid values and out-of-order timestamps are kept exactly") {
+        auto odd = rows;
+        odd.resize(50);
+        odd[3].price_ = 50'000.123456789;
+        odd[7].quantity_ = 0.0000001;
+        odd[9].quantity_ = -1.0;
+        odd[12].exch_timestamp_ -= 10'000;
+        odd[13].local_timestamp_ = odd[13].exch_timestamp_ - 5;
+        CompressedBookTape tape(0.01, 0.001, 16);
+        for (const auto &row : odd) tape.append(row);
+        tape.flush();
+        REQUIRE(tape.escapes() == 3);
+
+        const auto replayed = replay(tape);
+        REQUIRE(replayed.size() == odd.size());
+        for (std::size_t i = 0; i < odd.size(); ++i) {
+            REQUIRE(same_bits(replayed[i], odd[i]));
+        }
+    }
+
+    SECTION("Non-decimal tick sizes round-trip") {
+        CompressedBookTape tape(0.5, 1.0);
+        const BookUpdate row{1, 2, UpdateType::Incremental, BookSide::Ask,
+                             50'000.5, 3.0};
+        tape.append(row);
+        tape.flush();
+        REQUIRE(tape.escapes() == 0);
+        REQUIRE(same_bits(replay(tape).at(0), row));
+    }
+
+    SECTION("An empty tape has no rows") {
+        CompressedBookTape tape(0.01, 0.001);
+        REQUIRE(tape.empty());
+        REQUIRE(replay(tape).empty());
+    }
+
+    SECTION("Invalid grids are rejected") {
+        REQUIRE_THROWS_AS(CompressedBookTape(0.0, 0.001),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(CompressedBookTape(0.01, -1.0),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(CompressedBookTape(0.01, 0.001, 0),
+                          std::invalid_argument);
+    }
+}
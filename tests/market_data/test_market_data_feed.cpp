@@ -15,7 +15,11 @@
 #include <vector>
 
 #include "core/market_data/book_update.h"
+#include "core/market_data/book_update_batch.h"
+#include "core/market_data/mbo_update.h"
 #include "core/market_data/market_data_feed.h"
+#include "core/market_data/market_event.h"
+#include "core/market_data/quote.h"
 #include "core/market_data/readers/book_stream_reader.h"
 #include "core/market_data/readers/trade_stream_reader.h"
 #include "core/market_data/trade.h"
@@ -57,12 +61,9 @@ TEST_CASE("[MarketDataFeed] - initializes with empty input",
     using namespace core::market_data;
 
     MarketDataFeed feed({}, {});
-    EventType type;
-    BookUpdate book_update;
-    Trade trade;
-    int asset_id;
+    MarketEvent event;
 
-    REQUIRE_FALSE(feed.next_event(asset_id, type, book_update, trade));
+    REQUIRE_FALSE(feed.next_event(event));
 }
 
 TEST_CASE("[MarketDataFeed] - add_stream single asset",
@@ -77,15 +78,12 @@ TEST_CASE("[MarketDataFeed] - add_stream single asset",
     MarketDataFeed feed;
     feed.add_stream(1, book_file, trade_file);
 
-    EventType event_type;
-    BookUpdate book_update;
-    Trade trade;
-    int asset_id;
+    MarketEvent event;
 
-    REQUIRE(feed.next_event(asset_id, event_type, book_update, trade));
-    REQUIRE(asset_id == 1);
-    REQUIRE(event_type == EventType::Trade);
-    REQUIRE(trade.exch_timestamp_ == 100);
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.asset_id_ == 1);
+    REQUIRE(event.event_type_ == EventType::Trade);
+    REQUIRE(event.trade_.exch_timestamp_ == 100);
 
     std::filesystem::remove(book_file);
     std::filesystem::remove(trade_file);
@@ -105,38 +103,35 @@ TEST_CASE("[MarketDataFeed] - processes multi-asset events in timestamp order",
 
     MarketDataFeed feed(book_files, trade_files);
 
-    EventType type;
-    BookUpdate book_update;
-    Trade trade;
-    int asset_id;
+    MarketEvent event;
 
     SECTION("Correct order of events for asset 0") {
-        REQUIRE(feed.next_event(asset_id, type, book_update, trade));
-        REQUIRE(asset_id == 0);
-        REQUIRE(type == EventType::Trade);
-        REQUIRE(trade.exch_timestamp_ == 100);
-
-        REQUIRE(feed.next_event(asset_id, type, book_update, trade));
-        REQUIRE(asset_id == 0);
-        REQUIRE(type == EventType::BookUpdate);
-        REQUIRE(book_update.exch_timestamp_ == 200);
-
-        REQUIRE(feed.next_event(asset_id, type, book_update, trade));
-        REQUIRE(asset_id == 0);
-        REQUIRE(type == EventType::Trade);
-        REQUIRE(trade.exch_timestamp_ == 300);
-
-        REQUIRE(feed.next_event(asset_id, type, book_update, trade));
-        REQUIRE(asset_id == 0);
-        REQUIRE(type == EventType::BookUpdate);
-        REQUIRE(book_update.exch_timestamp_ == 400);
-
-        REQUIRE(feed.next_event(asset_id, type, book_update, trade));
-        REQUIRE(asset_id == 0);
-        REQUIRE(type == EventType::BookUpdate);
-        REQUIRE(book_update.exch_timestamp_ == 500);
-
-        REQUIRE_FALSE(feed.next_event(asset_id, type, book_update, trade));
+        REQUIRE(feed.next_event(event));
+        REQUIRE(event.asset_id_ == 0);
+        REQUIRE(event.event_type_ == EventType::Trade);
+        REQUIRE(event.trade_.exch_timestamp_ == 100);
+
+        REQUIRE(feed.next_event(event));
+        REQUIRE(event.asset_id_ == 0);
+        REQUIRE(event.event_type_ == EventType::BookUpdateBatch);
+        REQUIRE(event.book_batch_.exch_timestamp_ == 200);
+
+        REQUIRE(feed.next_event(event));
+        REQUIRE(event.asset_id_ == 0);
+        REQUIRE(event.event_type_ == EventType::Trade);
+        REQUIRE(event.trade_.exch_timestamp_ == 300);
+
+        REQUIRE(feed.next_event(event));
+        REQUIRE(event.asset_id_ == 0);
+        REQUIRE(event.event_type_ == EventType::BookUpdateBatch);
+        REQUIRE(event.book_batch_.exch_timestamp_ == 400);
+
+        REQUIRE(feed.next_event(event));
+        REQUIRE(event.asset_id_ == 0);
+        REQUIRE(event.event_type_ == EventType::BookUpdateBatch);
+        REQUIRE(event.book_batch_.exch_timestamp_ == 500);
+
+        REQUIRE_FALSE(feed.next_event(event));
     }
 
     std::filesystem::remove(book_file);
@@ -161,12 +156,9 @@ TEST_CASE("[MarketDataFeed] - handles header-only files",
 
     MarketDataFeed feed({{0, book_file}}, {{0, trade_file}});
 
-    EventType type;
-    BookUpdate book_update;
-    Trade trade;
-    int asset_id;
+    MarketEvent event;
 
-    REQUIRE_FALSE(feed.next_event(asset_id, type, book_update, trade));
+    REQUIRE_FALSE(feed.next_event(event));
 
     std::filesystem::remove(book_file);
     std::filesystem::remove(trade_file);
@@ -195,24 +187,21 @@ TEST_CASE("[MarketDataFeed] - multi-asset event sequencing",
     MarketDataFeed feed(book_files, trade_files);
 
     std::vector<std::tuple<int, EventType, Timestamp>> observed_events;
-    BookUpdate book_update;
-    Trade trade;
-    EventType event_type;
-    int asset_id;
+    MarketEvent event;
 
     // Collect all events
-    while (feed.next_event(asset_id, event_type, book_update, trade)) {
-        Timestamp ts;
-        (event_type == EventType::Trade) ? ts = trade.exch_timestamp_
-                                         : ts = book_update.exch_timestamp_;
-        observed_events.emplace_back(asset_id, event_type, ts);
+    while (feed.next_event(event)) {
+        const Timestamp ts = (event.event_type_ == EventType::Trade)
+                                 ? event.trade_.exch_timestamp_
+                                 : event.book_batch_.exch_timestamp_;
+        observed_events.emplace_back(event.asset_id_, event.event_type_, ts);
     }
     REQUIRE(std::get<1>(observed_events[0]) == EventType::Trade);
     REQUIRE(std::get<2>(observed_events[0]) == 100);
     REQUIRE(std::get<1>(observed_events[1]) == EventType::Trade);
     REQUIRE(std::get<2>(observed_events[1]) == 150);
-    REQUIRE(std::get<1>(observed_events[2]) == EventType::BookUpdate);
-    REQUIRE(std::get<1>(observed_events[3]) == EventType::BookUpdate);
+    REQUIRE(std::get<1>(observed_events[2]) == EventType::BookUpdateBatch);
+    REQUIRE(std::get<1>(observed_events[3]) == EventType::BookUpdateBatch);
 
     // Check global timestamp ordering
     for (size_t i = 1; i < observed_events.size(); ++i) {
@@ -263,22 +252,16 @@ TEST_CASE("[MarketDataFeed] - peek timestamp", "[feed][peek]") {
     SECTION("peek does not affect the next_event") {
         auto ts_opt = feed.peek_timestamp();
         // Advance one event (trade at 100)
-        int asset_id;
-        EventType type;
-        BookUpdate book_update;
-        Trade trade;
-        REQUIRE(feed.next_event(asset_id, type, book_update, trade));
+        MarketEvent event;
+        REQUIRE(feed.next_event(event));
         // ensure the timestamp is not affected by the peak
-        REQUIRE(type == EventType::Trade);
-        REQUIRE(trade.exch_timestamp_ == 100);
+        REQUIRE(event.event_type_ == EventType::Trade);
+        REQUIRE(event.trade_.exch_timestamp_ == 100);
     }
     SECTION("peak after next_event") {
         auto ts_opt = feed.peek_timestamp();
-        int asset_id;
-        EventType type;
-        BookUpdate book_update;
-        Trade trade;
-        feed.next_event(asset_id, type, book_update, trade);
+        MarketEvent event;
+        feed.next_event(event);
         // Now earliest should be trade at 150 for asset 1
         ts_opt = feed.peek_timestamp();
         REQUIRE(ts_opt.has_value());
@@ -313,21 +296,160 @@ TEST_CASE("[MarketDataFeed] - set_market_feed_latency applies to all streams",
     feed.set_market_feed_latency(20000);
     feed.add_stream(1, book_file, trade_file);
 
-    EventType event_type;
-    BookUpdate book_update;
-    Trade trade;
-    int asset_id;
+    MarketEvent event;
 
-    REQUIRE(feed.next_event(asset_id, event_type, book_update, trade));
-    REQUIRE(event_type == EventType::Trade);
-    REQUIRE(trade.exch_timestamp_ == 100);
-    REQUIRE(trade.local_timestamp_ == 20100);
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::Trade);
+    REQUIRE(event.trade_.exch_timestamp_ == 100);
+    REQUIRE(event.trade_.local_timestamp_ == 20100);
 
-    REQUIRE(feed.next_event(asset_id, event_type, book_update, trade));
-    REQUIRE(event_type == EventType::BookUpdate);
-    REQUIRE(book_update.exch_timestamp_ == 200);
-    REQUIRE(book_update.local_timestamp_ == 20200);
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::BookUpdateBatch);
+    REQUIRE(event.book_batch_.exch_timestamp_ == 200);
+    REQUIRE(event.book_batch_.local_timestamp_ == 20200);
 
     std::remove(book_file.c_str());
     std::remove(trade_file.c_str());
-}
\ No newline at end of file
+}
+TEST_CASE("[MarketDataFeed] - groups same-timestamp book rows into batches",
+          "[MarketDataFeed][batch]") {
+    using namespace core::market_data;
+
+    const std::string book_file = "test_book_batch.csv";
+    const std::string trade_file = "test_trade_batch.csv";
+    {
+        std::ofstream out(book_file);
+        out << "timestamp,local_timestamp,is_snapshot,side,price,amount\n";
+        out << "100,110,false,bid,100.0,1.0\n";
+        out << "100,110,false,bid,99.0,2.0\n";
+        out << "100,110,false,ask,101.0,3.0\n";
+        out << "200,210,false,ask,101.0,0.0\n";
+        out << "200,215,false,ask,102.0,1.0\n";
+    }
+    {
+        std::ofstream out(trade_file);
+        out << "timestamp,local_timestamp,id,side,price,amount\n";
+        out << "100,110,1,buy,101.0,0.5\n";
+    }
+
+    MarketDataFeed feed;
+    feed.add_stream(1, book_file, trade_file);
+
+    MarketEvent event;
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::BookUpdateBatch);
+    REQUIRE(event.asset_id_ == 1);
+    REQUIRE(event.book_batch_.exch_timestamp_ == 100);
+    REQUIRE(event.book_batch_.local_timestamp_ == 110);
+    REQUIRE(event.book_batch_.updates_.size() == 3);
+    REQUIRE(event.book_batch_.updates_[1].price_ == 99.0);
+    REQUIRE(event.book_batch_.updates_[2].side_ == BookSide::Ask);
+
+    // book rows win ties against trades
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::Trade);
+    REQUIRE(event.trade_.exch_timestamp_ == 100);
+
+    // rows with a different local timestamp are not merged
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::BookUpdateBatch);
+    REQUIRE(event.book_batch_.updates_.size() == 1);
+    REQUIRE(event.book_batch_.local_timestamp_ == 210);
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.book_batch_.updates_.size() == 1);
+    REQUIRE(event.book_batch_.local_timestamp_ == 215);
+
+    REQUIRE_FALSE(feed.next_event(event));
+
+    std::remove(book_file.c_str());
+    std::remove(trade_file.c_str());
+}
+
+TEST_CASE("[MarketDataFeed] - merges order-level streams with trades",
+          "[MarketDataFeed][mbo]") {
+    using namespace core::market_data;
+
+    const std::string order_file = "test_feed_mbo_orders.csv";
+    const std::string trade_file = "test_feed_mbo_trades.csv";
+    {
+        std::ofstream out(order_file);
+        out << "timestamp,local_timestamp,order_id,action,side,price,amount\n";
+        out << "100,110,1,add,bid,99.0,1.0\n";
+        out << "300,310,1,delete,bid,99.0,0\n";
+    }
+    {
+        std::ofstream out(trade_file);
+        out << "timestamp,local_timestamp,id,side,price,amount\n";
+        out << "200,210,1,sell,99.0,0.5\n";
+    }
+
+    MarketDataFeed feed;
+    feed.add_mbo_stream(3, order_file, trade_file);
+    REQUIRE(feed.peek_timestamp() == 100);
+
+    MarketEvent event;
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.asset_id_ == 3);
+    REQUIRE(event.event_type_ == EventType::MboUpdate);
+    REQUIRE(event.mbo_update_.action_ == MboAction::Add);
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::Trade);
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::MboUpdate);
+    REQUIRE(event.mbo_update_.action_ == MboAction::Delete);
+    REQUIRE(event.mbo_update_.exch_timestamp_ == 300);
+
+    REQUIRE_FALSE(feed.next_event(event));
+
+    std::remove(order_file.c_str());
+    std::remove(trade_file.c_str());
+}
+
+TEST_CASE("[MarketDataFeed] - merges quote streams with trades",
+          "[MarketDataFeed][quote]") {
+    using namespace core::market_data;
+
+    const std::string quote_file = "test_feed_quotes.csv";
+    const std::string trade_file = "test_feed_quote_trades.csv";
+    {
+        std::ofstream out(quote_file);
+        out << "timestamp,local_timestamp,ask_amount,ask_price,bid_price,"
+               "bid_amount\n";
+        out << "100,110,1.0,100.0,99.0,2.0\n";
+        out << "300,310,1.5,100.0,99.5,0.5\n";
+    }
+    {
+        std::ofstream out(trade_file);
+        out << "timestamp,local_timestamp,id,side,price,amount\n";
+        out << "200,210,1,sell,99.0,0.5\n";
+    }
+
+    MarketDataFeed feed;
+    feed.add_quote_stream(4, quote_file, trade_file);
+    REQUIRE(feed.peek_timestamp() == 100);
+
+    MarketEvent event;
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.asset_id_ == 4);
+    REQUIRE(event.event_type_ == EventType::Quote);
+    REQUIRE(event.quote_.bid_price_ == 99.0);
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::Trade);
+
+    REQUIRE(feed.next_event(event));
+    REQUIRE(event.event_type_ == EventType::Quote);
+    REQUIRE(event.quote_.exch_timestamp_ == 300);
+    REQUIRE(event.quote_.bid_quantity_ == 0.5);
+
+    REQUIRE_FALSE(feed.next_event(event));
+
+    std::remove(quote_file.c_str());
+    std::remove(trade_file.c_str());
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "core/market_data/mbo_update.h"
+#include "core/market_data/readers/mbo_stream_reader.h"
+#include "core/types/enums/book_side.h"
+#include "core/types/enums/mbo_action.h"
+
+TEST_CASE("[MboStreamReader] - parses order-level rows", "[mbo_reader]") {
+    using namespace core::market_data;
+
+    const std::string file = "test_mbo_reader.csv";
+    {
+        std::ofstream out(file);
+        out << "timestamp,local_timestamp,order_id,action,side,price,amount\n"
+            << "100,110,7,add,bid,50000.5,1.25\n"
+            << "200,210,7,replace,bid,50000.5,1.0\n"
+            << "300,310,7,modify,bid,50000.5,0.5\n"
+            << "400,410,7,delete,bid,50000.5,0\n";
+    }
+
+    MboStreamReader reader(file);
+    MboUpdate update;
+
+    REQUIRE(reader.parse_next(update));
+    REQUIRE(update.exch_timestamp_ == 100);
+    REQUIRE(update.local_timestamp_ == 110);
+    REQUIRE(update.order_id_ == 7);
+    REQUIRE(update.action_ == MboAction::Add);
+    REQUIRE(update.side_ == BookSide::Bid);
+    REQUIRE(update.price_ == 50000.5);
+    REQUIRE(update.quantity_ == 1.25);
+
+    // the unknown action row is skipped
+    REQUIRE(reader.parse_next(update));
+    REQUIRE(update.action_ == MboAction::Modify);
+    REQUIRE(update.quantity_ == 0.5);
+
+    REQUIRE(reader.parse_next(update));
+    REQUIRE(update.action_ == MboAction::Delete);
+    REQUIRE_FALSE(reader.parse_next(update));
+
+    std::remove(file.c_str());
+}
+
+TEST_CASE("[MboStreamReader] - applies feed latency without local timestamps",
+          "[mbo_reader][latency]") {
+    using namespace core::market_data;
+
+    const std::string file = "test_mbo_reader_latency.csv";
+    {
+        std::ofstream out(file);
+        out << "timestamp,order_id,action,side,price,amount\n"
+            << "100,1,add,ask,10.0,2.0\n";
+    }
+
+    MboStreamReader reader;
+    reader.set_market_feed_latency_us(500);
+    reader.open(file);
+    MboUpdate update;
+    REQUIRE(reader.parse_next(update));
+    REQUIRE(update.local_timestamp_ == 600);
+    REQUIRE(update.side_ == BookSide::Ask);
+
+    std::remove(file.c_str());
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "core/market_data/quote.h"
+#include "core/market_data/readers/quote_stream_reader.h"
+
+TEST_CASE("[QuoteStreamReader] - parses Tardis quotes rows",
+          "[quote_reader]") {
+    using namespace core::market_data;
+
+    const std::string file = "test_quote_reader.csv";
+    {
+        std::ofstream out(file);
+        out << "exchange,symbol,timestamp,local_timestamp,ask_amount,"
+               "ask_price,bid_price,bid_amount\n"
+            << "binance-futures,BTCUSDT,100,110,1.5,50001.0,50000.0,2.5\n"
+            << "binance-futures,BTCUSDT,200,210,,,50000.5,0.75\n";
+    }
+
+    QuoteStreamReader reader(file);
+    Quote quote;
+
+    REQUIRE(reader.parse_next(quote));
+    REQUIRE(quote.exch_timestamp_ == 100);
+    REQUIRE(quote.local_timestamp_ == 110);
+    REQUIRE(quote.bid_price_ == 50000.0);
+    REQUIRE(quote.bid_quantity_ == 2.5);
+    REQUIRE(quote.ask_price_ == 50001.0);
+    REQUIRE(quote.ask_quantity_ == 1.5);
+
+    // an empty side is read as price 0
+    REQUIRE(reader.parse_next(quote));
+    REQUIRE(quote.bid_price_ == 50000.5);
+    REQUIRE(quote.ask_price_ == 0.0);
+    REQUIRE(quote.ask_quantity_ == 0.0);
+
+    REQUIRE_FALSE(reader.parse_next(quote));
+
+    std::remove(file.c_str());
+}
+
+TEST_CASE("[QuoteStreamReader] - applies feed latency without local "
+          "timestamps",
+          "[quote_reader][latency]") {
+    using namespace core::market_data;
+
+    const std::string file = "test_quote_reader_latency.csv";
+    {
+        std::ofstream out(file);
+        out << "timestamp,ask_amount,ask_price,bid_price,bid_amount\n"
+            << "100,1.0,11.0,10.0,2.0\n";
+    }
+
+    QuoteStreamReader reader;
+    reader.set_market_feed_latency_us(500);
+    reader.open(file);
+    Quote quote;
+    REQUIRE(reader.parse_next(quote));
+    REQUIRE(quote.local_timestamp_ == 600);
+    REQUIRE(quote.bid_price_ == 10.0);
+
+    std::remove(file.c_str());
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 arvindkrv@protonmail.com
+ *
+ * Please see the LICENSE file for the terms and conditions
+ * associated with this software.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "core/market_data/depth_snapshot.h"
+#include "core/market_data/readers/snapshot_stream_reader.h"
+
+namespace {
+void write_header(std::ofstream &out, int levels, bool local_timestamp) {
+    out << "exchange,symbol,timestamp";
+    if (local_timestamp) out << ",local_timestamp";
+    for (int i = 0; i < levels; ++i) {
+        out << ",asks[" << i << "].price,asks[" << i << "].amount,bids[" << i
+            << "].price,bids[" << i << "].amount";
+    }
+    out << "\n";
+}
+} // namespace
+
+TEST_CASE("[SnapshotStreamReader] - parses book_snapshot rows",
+          "[snapshot_reader]") {
+    using namespace core::market_data;
+
+    const std::string file = "test_snapshot_reader.csv";
+    {
+        std::ofstream out(file);
+        write_header(out, 3, true);
+        out << "binance,BTCUSDT,100,110,"
+            << "101.0,1.5,100.0,2.0,"
+            << "101.5,2.5,99.5,3.0,"
+            << "102.0,3.5,99.0,4.0\n"
+            // thin book: the last level of each side is empty
+            << "binance,BTCUSDT,200,210,"
+            << "101.0,1.0,100.0,1.0,"
+            << "101.5,1.0,,,"
+            << ",,,\n";
+    }
+
+    SnapshotStreamReader reader(file);
+    DepthSnapshot snapshot;
+
+    REQUIRE(reader.parse_next(snapshot));
+    REQUIRE(snapshot.exch_timestamp_ == 100);
+    REQUIRE(snapshot.local_timestamp_ == 110);
+    REQUIRE(snapshot.bid_count_ == 3);
+    REQUIRE(snapshot.ask_count_ == 3);
+    REQUIRE(snapshot.asks_[0].price_ == 101.0);
+    REQUIRE(snapshot.asks_[0].quantity_ == 1.5);
+    REQUIRE(snapshot.bids_[2].price_ == 99.0);
+    REQUIRE(snapshot.bids_[2].quantity_ == 4.0);
+
+    REQUIRE(reader.parse_next(snapshot));
+    REQUIRE(snapshot.exch_timestamp_ == 200);
+    REQUIRE(snapshot.ask_count_ == 2);
+    REQUIRE(snapshot.bid_count_ == 1);
+
+    REQUIRE_FALSE(reader.parse_next(snapshot));
+
+    std::remove(file.c_str());
+}
+
+TEST_CASE("[SnapshotStreamReader] - applies feed latency without local "
+          "timestamps",
+          "[snapshot_reader][latency]") {
+    using namespace core::market_data;
+
+    const std::string file = "test_snapshot_reader_latency.csv";
+    {
+        std::ofstream out(file);
+        write_header(out, 1, false);
+        out << "binance,BTCUSDT,100,11.0,1.0,10.0,2.0\n";
+    }
+
+    SnapshotStreamReader reader;
+    reader.set_market_feed_latency_us(500);
+    reader.open(file);
+    DepthSnapshot snapshot;
+    REQUIRE(reader.parse_next(snapshot));
+    REQUIRE(snapshot.local_timestamp_ == 600);
+    REQUIRE(snapshot.bids_[0].price_ == 10.0);
+    REQUIRE(snapshot.bid_count_ == 1);
+
+    std::remove(file.c_str());
+}
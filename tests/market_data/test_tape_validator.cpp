@@ -0,0 +1,99 @@
+/*
+ * File: tests/test_tape_validator.cpp
+ * Description: Unit tests for the book tape validation and cleaning pass.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-06
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "core/market_data/book_update.h"
+#include "core/market_data/readers/book_stream_reader.h"
+#include "core/market_data/tape_validator.h"
+#include "core/orderbook/orderbook.h"
+
+namespace {
+void create_dirty_book_csv(const std::string &filename) {
+    std::ofstream f(filename);
+    f << "timestamp,local_timestamp,is_snapshot,side,price,amount\n"
+      << "100,110,true,bid,100.0,1.0\n"
+      << "100,110,true,ask,101.0,1.0\n"
+      << "200,210,false,bid,100.5,2.0\n"
+      << "200,210,false,bid,100.5,2.0\n"  // duplicate
+      << "250,260,false,bid,abc,1.0\n"    // malformed
+      << "260,270,false,ask,-1.0,1.0\n"   // non-positive price
+      << "270,280,false,ask,101.5,-2.0\n" // negative quantity
+      << "300,310,false,bid,101.5,1.0\n"  // crosses the stale ask at 101.0
+      << "290,305,false,ask,102.0,1.0\n"  // out of order
+      << "400,410,false,ask,103.0,1.0\n"
+      << "500,510,false,ask,104.0,1.0\n"
+      << "600,610,false,bid,99.0,1.0\n";
+}
+
+std::string read_file(const std::string &filename) {
+    std::ifstream f(filename);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+} // namespace
+
+TEST_CASE("[TapeValidator] - cleans a dirty book tape and marks it verified",
+          "[tape-validator]") {
+    using namespace core::market_data;
+    const std::string input = "test_dirty_book.csv";
+    const std::string output = "test_clean_book.csv";
+    create_dirty_book_csv(input);
+
+    // tiny chunks so rows are split across chunks and parser threads
+    const auto report = validate_book_tape(
+        input, output,
+        TapeValidationConfig{
+            .threads_ = 2, .chunk_rows_ = 3, .crossed_batches_ = 3});
+    REQUIRE(report.rows_in_ == 12);
+    REQUIRE(report.rows_out_ == 9);
+    REQUIRE(report.malformed_ == 1);
+    REQUIRE(report.non_positive_price_ == 1);
+    REQUIRE(report.negative_quantity_ == 1);
+    REQUIRE(report.duplicates_ == 1);
+    REQUIRE(report.out_of_order_ == 1);
+    REQUIRE(report.crossed_repairs_ == 1);
+
+    // crossed after the batches at 300, 400 and 500: the older ask is deleted
+    REQUIRE(read_file(output) ==
+            "timestamp,local_timestamp,is_snapshot,side,price,amount\n"
+            "100,110,true,bid,100.0,1.0\n"
+            "100,110,true,ask,101.0,1.0\n"
+            "200,210,false,bid,100.5,2.0\n"
+            "300,310,false,bid,101.5,1.0\n"
+            "300,310,false,ask,102.0,1.0\n"
+            "400,410,false,ask,103.0,1.0\n"
+            "500,510,false,ask,104.0,1.0\n"
+            "500,510,false,ask,101.0,0\n"
+            "600,610,false,bid,99.0,1.0\n");
+
+    REQUIRE(BookStreamReader::is_verified(output));
+    REQUIRE_FALSE(BookStreamReader::is_verified(input));
+
+    BookStreamReader reader(output);
+    REQUIRE(reader.verified());
+    core::orderbook::OrderBook book(0.5, 0.1);
+    book.set_row_checks(false);
+    BookUpdate update;
+    while (reader.parse_next(update)) book.apply_book_update(update);
+    REQUIRE(book.best_bid() == 101.5);
+    REQUIRE(book.best_ask() == 102.0);
+
+    // any change to the cleaned tape invalidates the side-car
+    std::ofstream(output, std::ios::app) << "700,710,false,bid,98.0,1.0\n";
+    REQUIRE_FALSE(BookStreamReader::is_verified(output));
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+    std::filesystem::remove(BookStreamReader::verified_marker(output));
+}
@@ -86,4 +86,62 @@ TEST_CASE("[TradeStreamReader] - market feed latency applied when "
     REQUIRE(trade.local_timestamp_ == 10100); 
 
     std::remove(test_file.c_str());
-}
\ No newline at end of file
+}
+TEST_CASE("[TradeStreamReader] - aggregates identical-timestamp trades",
+          "[trade][aggregate]") {
+    using namespace core::market_data;
+
+    const std::string test_file = "test_trade_aggregate.csv";
+    {
+        std::ofstream out(test_file);
+        out << "timestamp,local_timestamp,id,side,price,amount\n";
+        out << "100,110,1,buy,2.7347,1.0\n";
+        out << "100,110,2,buy,2.7347,2.5\n";
+        out << "100,110,3,buy,2.7348,4.0\n";
+        out << "100,110,4,sell,2.7348,0.5\n";
+        out << "200,210,5,sell,2.7348,0.5\n";
+        out << "200,210,6,sell,2.7348,1.5\n";
+    }
+
+    SECTION("Merges same timestamp, side and price") {
+        TradeStreamReader reader;
+        reader.set_aggregate_trades(true);
+        reader.open(test_file);
+        Trade trade;
+
+        REQUIRE(reader.parse_next(trade));
+        REQUIRE(trade.exch_timestamp_ == 100);
+        REQUIRE(trade.orderId_ == 1);
+        REQUIRE(trade.side_ == TradeSide::Buy);
+        REQUIRE(trade.price_ == 2.7347);
+        REQUIRE(trade.quantity_ == 3.5);
+
+        REQUIRE(reader.parse_next(trade));
+        REQUIRE(trade.orderId_ == 3);
+        REQUIRE(trade.price_ == 2.7348);
+        REQUIRE(trade.quantity_ == 4.0);
+
+        REQUIRE(reader.parse_next(trade));
+        REQUIRE(trade.orderId_ == 4);
+        REQUIRE(trade.side_ == TradeSide::Sell);
+        REQUIRE(trade.quantity_ == 0.5);
+
+        REQUIRE(reader.parse_next(trade));
+        REQUIRE(trade.exch_timestamp_ == 200);
+        REQUIRE(trade.orderId_ == 5);
+        REQUIRE(trade.quantity_ == 2.0);
+
+        REQUIRE_FALSE(reader.parse_next(trade));
+    }
+
+    SECTION("Disabled by default") {
+        TradeStreamReader reader;
+        reader.open(test_file);
+        Trade trade;
+        int rows = 0;
+        while (reader.parse_next(trade)) ++rows;
+        REQUIRE(rows == 6);
+    }
+
+    std::remove(test_file.c_str());
+}
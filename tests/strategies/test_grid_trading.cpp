@@ -11,9 +11,13 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
 
 #include "core/execution_engine/execution_engine.h"
 #include "core/strategy/grid_trading/grid_trading.h"
+#include "core/strategy/grid_trading/rebuild_grid_trading.h"
 #include "core/backtest_engine/backtest_engine.h"
 #include "utils/logger/log_level.h"
 #include "utils/logger/logger.h"
@@ -299,4 +303,144 @@ TEST_CASE("[GridTrading] - handles position limits correctly",
     // Cleanup
     std::filesystem::remove(book_file);
     std::filesystem::remove(trade_file);
-}
\ No newline at end of file
+}
+
+TEST_CASE("[GridTrading] - a one-step mid move changes one level per side",
+          "[grid-trading][incremental]") {
+    using namespace core::trading;
+    using namespace core::backtest;
+    using namespace core::strategy;
+
+    const std::string book_file = "test_grid_shift_book.csv";
+    const std::string trade_file = "test_grid_shift_trade.csv";
+    {
+        std::ofstream f(book_file);
+        f << "timestamp,local_timestamp,is_snapshot,side,price,amount\n"
+          << "1000,2000,false,bid,50000.00,5.0\n"
+          << "1000,2000,false,ask,50000.10,5.0\n"
+          << "60000,61000,false,ask,50000.20,5.0\n"
+          << "60000,61000,false,ask,50000.10,0.0\n"
+          << "60000,61000,false,bid,50000.10,5.0\n"
+          << "60000,61000,false,bid,50000.00,0.0\n";
+        std::ofstream t(trade_file);
+        t << "timestamp,local_timestamp,id,side,price,amount\n"
+          << "500,1500,1,buy,50000.10,1.0\n";
+    }
+    const double tick_size = 0.01;
+    std::unordered_map<int, AssetConfig> asset_configs = {
+        {1, AssetConfig{.book_update_file_ = book_file,
+                        .trade_file_ = trade_file,
+                        .tick_size_ = tick_size,
+                        .lot_size_ = 0.00001,
+                        .contract_multiplier_ = 1.0,
+                        .is_inverse_ = false,
+                        .maker_fee_ = 0.0,
+                        .taker_fee_ = 0.0}}};
+    const auto engine_config =
+        BacktestEngineConfig{.initial_cash_ = 1000.0,
+                             .order_entry_latency_us_ = 1000,
+                             .order_response_latency_us_ = 1000,
+                             .market_feed_latency_us_ = 1000};
+    BacktestEngine engine(asset_configs, engine_config);
+    GridTrading strat(1, 3, 10, 20, 10.0, 100.0, nullptr);
+
+    auto prices = [&](BookSide side) {
+        std::set<Ticks> ticks;
+        for (const auto &order : engine.orders(1)) {
+            if (order.side_ == side) {
+                ticks.insert(utils::math::price_to_ticks(order.price_,
+                                                         tick_size));
+            }
+        }
+        return ticks;
+    };
+
+    REQUIRE(engine.elapse(42000));
+    strat.on_elapse(engine);
+    REQUIRE(engine.elapse(10000));
+    REQUIRE(prices(BookSide::Bid) == std::set<Ticks>{4999960, 4999970,
+                                                     4999980});
+    REQUIRE(prices(BookSide::Ask) == std::set<Ticks>{5000030, 5000040,
+                                                     5000050});
+    std::set<OrderId> before;
+    for (const auto &order : engine.orders(1)) before.insert(order.orderId_);
+
+    // mid moves up by one grid interval
+    REQUIRE(engine.elapse(10000));
+    engine.clear_inactive_orders();
+    strat.on_elapse(engine);
+    REQUIRE(engine.elapse(10000));
+    engine.clear_inactive_orders();
+    REQUIRE(prices(BookSide::Bid) == std::set<Ticks>{4999970, 4999980,
+                                                     4999990});
+    REQUIRE(prices(BookSide::Ask) == std::set<Ticks>{5000040, 5000050,
+                                                     5000060});
+    int kept = 0;
+    for (const auto &order : engine.orders(1)) {
+        kept += before.count(order.orderId_) ? 1 : 0;
+    }
+    REQUIRE(kept == 4);
+
+    // an unchanged mid leaves every order in place
+    strat.on_elapse(engine);
+    REQUIRE(engine.elapse(10000));
+    std::set<OrderId> after;
+    for (const auto &order : engine.orders(1)) after.insert(order.orderId_);
+    REQUIRE(after.size() == 6);
+    strat.on_elapse(engine);
+    REQUIRE(engine.elapse(10000));
+    for (const auto &order : engine.orders(1)) {
+        REQUIRE(after.count(order.orderId_) == 1);
+    }
+
+    std::filesystem::remove(book_file);
+    std::filesystem::remove(trade_file);
+}
+
+TEST_CASE("[GridTrading] - trades like the grid-rebuilding implementation",
+          "[grid-trading][incremental]") {
+    using namespace core::trading;
+    using namespace core::backtest;
+    using namespace core::strategy;
+
+    const std::string book_file = "test_grid_book.csv";
+    const std::string trade_file = "test_grid_trade.csv";
+    TestHelpers::create_book_update_csv(book_file);
+    TestHelpers::create_trade_csv(trade_file);
+    std::unordered_map<int, AssetConfig> asset_configs = {
+        {1, AssetConfig{.book_update_file_ = book_file,
+                        .trade_file_ = trade_file,
+                        .tick_size_ = 0.01,
+                        .lot_size_ = 0.01,
+                        .contract_multiplier_ = 1.0,
+                        .is_inverse_ = false,
+                        .maker_fee_ = 0.0,
+                        .taker_fee_ = 0.0}}};
+    const auto engine_config =
+        BacktestEngineConfig{.initial_cash_ = 1000.0,
+                             .order_entry_latency_us_ = 1000,
+                             .order_response_latency_us_ = 1000,
+                             .market_feed_latency_us_ = 1000};
+    BacktestEngine incremental_engine(asset_configs, engine_config);
+    BacktestEngine rebuild_engine(asset_configs, engine_config);
+    GridTrading incremental(1, 3, 10, 20, 5.0, 100000.0, nullptr);
+    RebuildGridTrading rebuild(1, 3, 10, 20, 5.0, 100000.0, nullptr);
+
+    // intervals longer than an order round trip, so both see every ack
+    for (int step = 0; step < 20; ++step) {
+        incremental_engine.elapse(5000);
+        rebuild_engine.elapse(5000);
+        incremental_engine.clear_inactive_orders();
+        rebuild_engine.clear_inactive_orders();
+        incremental.on_elapse(incremental_engine);
+        rebuild.on_elapse(rebuild_engine);
+        REQUIRE(incremental_engine.orders(1).size() ==
+                rebuild_engine.orders(1).size());
+    }
+    REQUIRE(incremental_engine.position(1) != 0.0);
+    REQUIRE(incremental_engine.position(1) == rebuild_engine.position(1));
+    REQUIRE(incremental_engine.cash() == rebuild_engine.cash());
+
+    std::filesystem::remove(book_file);
+    std::filesystem::remove(trade_file);
+}
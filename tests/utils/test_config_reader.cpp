@@ -175,7 +175,8 @@ TEST_CASE("[ConfigReader] - get_backtest_engine_config returns correct "
         out << "initial_cash=5000.0\n"
             << "order_entry_latency_us=12345\n"
             << "order_response_latency_us=23456\n"
-            << "market_feed_latency_us=34567\n";
+            << "market_feed_latency_us=34567\n"
+            << "start_time_us=1735689600000000\n";
     }
 
     ConfigReader reader;
@@ -186,6 +187,7 @@ TEST_CASE("[ConfigReader] - get_backtest_engine_config returns correct "
     REQUIRE(config.order_entry_latency_us_ == 12345);
     REQUIRE(config.order_response_latency_us_ == 23456);
     REQUIRE(config.market_feed_latency_us_ == 34567);
+    REQUIRE(config.start_time_us_ == 1735689600000000ull);
 
     std::filesystem::remove(config_file);
 }
@@ -292,4 +294,47 @@ TEST_CASE("[ConfigReader] - get_backtest_config uses defaults if missing",
     REQUIRE(config.iterations == 86400); // default value
 
     std::filesystem::remove(config_file);
-}
\ No newline at end of file
+}
+TEST_CASE("[ConfigReader] - get_thread_placement_config reads CPU sets and "
+          "priorities",
+          "[config][thread_placement_config]") {
+    using namespace utils::config;
+    using utils::thread::ThreadRole;
+
+    const std::string config_file = "test_thread_placement_config.tmp";
+    {
+        std::ofstream out(config_file);
+        out << "# sim on an isolated core\n"
+            << "sim_cpus=3\n"
+            << "sim_priority=80\n"
+            << "ws_io_cpus=4-6,8\n"
+            << "logger_cpus=0\n";
+    }
+
+    ConfigReader reader;
+    const auto config = reader.get_thread_placement_config(config_file);
+
+    REQUIRE(config.placements_.size() == 3);
+    REQUIRE(config.placements_.at(ThreadRole::Sim).cpus_ ==
+            std::vector<int>{3});
+    REQUIRE(config.placements_.at(ThreadRole::Sim).fifo_priority_ == 80);
+    REQUIRE(config.placements_.at(ThreadRole::WsIo).cpus_ ==
+            std::vector<int>{4, 5, 6, 8});
+    REQUIRE(config.placements_.at(ThreadRole::Logger).fifo_priority_ == 0);
+    REQUIRE_FALSE(config.placements_.contains(ThreadRole::Parser));
+
+    {
+        std::ofstream out(config_file);
+        out << "parser_cpus=7-5\n";
+    }
+    REQUIRE_THROWS_AS(reader.get_thread_placement_config(config_file),
+                      std::invalid_argument);
+    {
+        std::ofstream out(config_file);
+        out << "writer_priority=120\n";
+    }
+    REQUIRE_THROWS_AS(reader.get_thread_placement_config(config_file),
+                      std::invalid_argument);
+
+    std::filesystem::remove(config_file);
+}
@@ -0,0 +1,120 @@
+/*
+ * File: tests/test_run_arena.cpp
+ * Description: Unit tests for the per-run allocation arena.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-08-30
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+#include "core/market_data/book_update.h"
+#include "core/orderbook/orderbook.h"
+#include "core/types/enums/book_side.h"
+#include "core/types/enums/update_type.h"
+#include "utils/memory/huge_page_resource.h"
+#include "utils/memory/run_arena.h"
+
+TEST_CASE("[RunArena] - allocation and reset", "[run-arena]") {
+    using utils::memory::RunArena;
+
+    SECTION("Small runs fit in the initial block") {
+        RunArena arena;
+        {
+            std::pmr::vector<int> values(arena.resource());
+            for (int i = 0; i < 1000; ++i) values.push_back(i);
+            REQUIRE(values.back() == 999);
+        }
+        REQUIRE(arena.overflow_bytes() == 0);
+        arena.reset();
+        REQUIRE(arena.capacity() == (std::size_t{1} << 20));
+    }
+
+    SECTION("A run that spills grows the block for the next run") {
+        RunArena arena(1024);
+        auto run = [&arena]() {
+            std::pmr::map<int, double> levels(arena.resource());
+            for (int i = 0; i < 5000; ++i) levels[i] = i * 0.5;
+            REQUIRE(levels.size() == 5000);
+        };
+        run();
+        const std::size_t spilled = arena.overflow_bytes();
+        REQUIRE(spilled > 0);
+        arena.reset();
+        REQUIRE(arena.capacity() == 1024 + spilled);
+        REQUIRE(arena.overflow_bytes() == 0);
+
+        run();
+        REQUIRE(arena.overflow_bytes() == 0);
+    }
+}
+
+TEST_CASE("[RunArena] - order book backed by an arena",
+          "[run-arena][orderbook]") {
+    using namespace core::orderbook;
+    using namespace core::market_data;
+    utils::memory::RunArena arena;
+
+    auto run = [&arena]() {
+        OrderBook book(0.01, 0.001, nullptr, arena.resource());
+        book.apply_book_update(
+            BookUpdate{.exch_timestamp_ = 1,
+                       .local_timestamp_ = 2,
+                       .update_type_ = UpdateType::Incremental,
+                       .side_ = BookSide::Bid,
+                       .price_ = 100.0,
+                       .quantity_ = 1.5});
+        book.apply_book_update(
+            BookUpdate{.exch_timestamp_ = 1,
+                       .local_timestamp_ = 2,
+                       .update_type_ = UpdateType::Incremental,
+                       .side_ = BookSide::Ask,
+                       .price_ = 100.5,
+                       .quantity_ = 2.0});
+        REQUIRE(book.best_bid() == 100.0);
+        REQUIRE(book.best_ask() == 100.5);
+        REQUIRE(book.bid_book().size() == 1);
+        REQUIRE(book.ask_book().begin()->second == 2.0);
+        REQUIRE(arena.overflow_bytes() == 0);
+    };
+    // each book is destroyed before its levels are released
+    run();
+    arena.reset();
+    run();
+    arena.reset();
+}
+
+TEST_CASE("[RunArena] - huge page backed arena", "[run-arena][huge-pages]") {
+    using namespace utils::memory;
+    HugePageResource huge_pages;
+
+    SECTION("Allocations are 2 MB aligned and writable") {
+        void *p = huge_pages.allocate(3 << 20);
+#if defined(__linux__)
+        REQUIRE(huge_pages.last_backing() != PageBacking::Default);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) %
+                    HugePageResource::kHugePageSize ==
+                0);
+#endif
+        auto *bytes = static_cast<unsigned char *>(p);
+        bytes[0] = 1;
+        bytes[(3 << 20) - 1] = 2;
+        REQUIRE(bytes[0] + bytes[(3 << 20) - 1] == 3);
+        huge_pages.deallocate(p, 3 << 20);
+    }
+
+    SECTION("Arena draws its block from the huge page resource") {
+        RunArena arena(std::size_t{1} << 20, &huge_pages);
+        {
+            std::pmr::map<int, double> levels(arena.resource());
+            for (int i = 0; i < 1000; ++i) levels[i] = i;
+            REQUIRE(levels.rbegin()->second == 999.0);
+        }
+        arena.reset();
+        REQUIRE(arena.capacity() == (std::size_t{1} << 20));
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * File: tests/test_task_pool.cpp
+ * Description: Unit tests for the shared work-stealing task pool.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-10
+ * License: Proprietary
+ */
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/thread/task_pool.h"
+
+TEST_CASE("[TaskPool] - submitted tasks return results by priority",
+          "[task-pool]") {
+    using namespace utils::thread;
+    TaskPool pool(1);
+    REQUIRE(pool.size() == 1);
+
+    // hold the only worker so the next tasks queue up together
+    std::promise<void> release;
+    auto blocker =
+        pool.submit([gate = release.get_future().share()] { gate.wait(); });
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](std::string name) {
+        return [&, name] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name);
+            return name.size();
+        };
+    };
+    auto low = pool.submit(record("low"), TaskPriority::Low);
+    auto normal = pool.submit(record("normal"), TaskPriority::Normal);
+    auto high = pool.submit(record("high"), TaskPriority::High);
+    release.set_value();
+
+    REQUIRE(low.get() == 3);
+    REQUIRE(normal.get() == 6);
+    REQUIRE(high.get() == 4);
+    blocker.get();
+    REQUIRE(order == std::vector<std::string>{"high", "normal", "low"});
+
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("x"); });
+    REQUIRE_THROWS_AS(failing.get(), std::runtime_error);
+}
+
+TEST_CASE("[TaskPool] - parallel_for visits every index once, nested too",
+          "[task-pool]") {
+    using namespace utils::thread;
+    TaskPool pool(3);
+
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for(0, visits.size(), [&](std::size_t i) { ++visits[i]; },
+                      TaskPriority::Normal, 7);
+    for (const auto &count : visits) REQUIRE(count == 1);
+
+    // every outer index runs its own inner loop on the same pool
+    std::atomic<int> inner{0};
+    pool.parallel_for(0, 8, [&](std::size_t) {
+        pool.parallel_for(0, 50, [&](std::size_t) { ++inner; });
+    });
+    REQUIRE(inner == 400);
+
+    REQUIRE_THROWS_AS(pool.parallel_for(0, 100,
+                                        [](std::size_t i) {
+                                            if (i == 42) {
+                                                throw std::runtime_error("42");
+                                            }
+                                        }),
+                      std::runtime_error);
+
+    // an empty range and a pool without workers run inline
+    pool.parallel_for(5, 5, [](std::size_t) { FAIL("no indices"); });
+    TaskPool inline_pool(0);
+    int sum = 0;
+    inline_pool.parallel_for(0, 4, [&](std::size_t i) { sum += i; });
+    REQUIRE(sum == 6);
+    REQUIRE(inline_pool.submit([] { return 7; }).get() == 7);
+}
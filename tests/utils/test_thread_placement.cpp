@@ -0,0 +1,96 @@
+/*
+ * File: tests/test_thread_placement.cpp
+ * Description: Unit tests for thread naming, pinning and the layout report.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-01
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "utils/thread/numa_topology.h"
+#include "utils/thread/thread_placement.h"
+
+TEST_CASE("[ThreadPlacement] - threads are named, pinned and reported",
+          "[thread-placement]") {
+    using namespace utils::thread;
+
+    ThreadPlacementConfig config;
+    config.placements_[ThreadRole::Parser] = ThreadPlacement{{0}, 0};
+    set_thread_placement_config(config);
+
+    std::string name;
+    int cpu_count = -1;
+    std::thread worker([&] {
+        place_current_thread(ThreadRole::Parser, "test-parser-thread");
+#if defined(__linux__)
+        char buf[16] = {};
+        pthread_getname_np(pthread_self(), buf, sizeof(buf));
+        name = buf;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        cpu_count = CPU_COUNT(&set);
+#endif
+    });
+    worker.join();
+
+#if defined(__linux__)
+    REQUIRE(name == "test-parser-thr"); // kernel keeps 15 characters
+    REQUIRE(cpu_count == 1);
+#endif
+
+    // a second thread under the same name reuses the layout entry
+    std::thread again(
+        [] { place_current_thread(ThreadRole::Parser, "test-parser-thread"); });
+    again.join();
+    std::thread unplaced(
+        [] { place_current_thread(ThreadRole::Writer, "test-writer"); });
+    unplaced.join();
+
+    const auto layout = thread_layout();
+    int parser_entries = 0;
+    for (const auto &entry : layout) {
+        if (entry.name_ == "test-parser-thread") {
+            ++parser_entries;
+            REQUIRE(entry.role_ == ThreadRole::Parser);
+            REQUIRE(entry.cpus_ == std::vector<int>{0});
+            REQUIRE(entry.pinned_);
+        }
+        if (entry.name_ == "test-writer") {
+            REQUIRE(entry.cpus_.empty());
+            REQUIRE_FALSE(entry.pinned_);
+        }
+    }
+    REQUIRE(parser_entries == 1);
+
+    const std::string report = format_thread_layout();
+    REQUIRE(report.find("test-parser-thread [parser] cpus=0\n") !=
+            std::string::npos);
+    REQUIRE(report.find("test-writer [writer] cpus=any\n") !=
+            std::string::npos);
+
+    set_thread_placement_config(ThreadPlacementConfig{});
+}
+
+TEST_CASE("[NumaTopology] - CPU lists are parsed and every CPU has a node",
+          "[thread-placement]") {
+    using namespace utils::thread;
+
+    REQUIRE(parse_cpu_list("0-3,8,10-11\n") ==
+            std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    REQUIRE(parse_cpu_list("").empty());
+    REQUIRE(parse_cpu_list("x,2") == std::vector<int>{2});
+
+    const auto nodes = numa_topology();
+    REQUIRE_FALSE(nodes.empty());
+    for (const auto &node : nodes) REQUIRE_FALSE(node.cpus_.empty());
+}
@@ -0,0 +1,81 @@
+/*
+ * File: tests/test_tracer.cpp
+ * Description: Unit tests for the event tracer, binary trace files and the
+ * Chrome trace export.
+ * Author: Arvind Rathnashyam
+ * Date: 2025-09-03
+ * License: Proprietary
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "utils/trace/trace_export.h"
+#include "utils/trace/tracer.h"
+
+TEST_CASE("[Tracer] - records per thread and round-trips through a file",
+          "[tracer]") {
+    using namespace utils::trace;
+    Tracer &tracer = Tracer::instance();
+
+    // nothing is recorded while disabled
+    tracer.stop();
+    trace_event(TraceEventType::Submit, 1, 0, 7);
+    tracer.start();
+    REQUIRE(tracer.records().empty());
+
+    trace_event(TraceEventType::Submit, 100, 0, 7);
+    {
+        TraceScope scope(TraceEventType::StrategyCallback, 100);
+    }
+    std::thread worker([] { trace_event(TraceEventType::Fill, 200, 0, 7); });
+    worker.join();
+    tracer.stop();
+
+    const auto records = tracer.records();
+    REQUIRE(records.size() == 4);
+    std::set<std::uint32_t> threads;
+    for (const auto &record : records) threads.insert(record.thread_);
+    REQUIRE(threads.size() == 2);
+
+    write_trace(records, "test_tracer.bin");
+    const auto read = read_trace("test_tracer.bin");
+    REQUIRE(read.size() == records.size());
+    for (std::size_t i = 0; i < read.size(); ++i) {
+        REQUIRE(read[i].wall_ns_ == records[i].wall_ns_);
+        REQUIRE(read[i].sim_us_ == records[i].sim_us_);
+        REQUIRE(read[i].order_id_ == records[i].order_id_);
+        REQUIRE(read[i].type_ == records[i].type_);
+        REQUIRE(read[i].phase_ == records[i].phase_);
+    }
+
+    std::ostringstream json;
+    write_chrome_trace(read, json);
+    const std::string out = json.str();
+    REQUIRE(out.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(out.find("\"name\":\"submit\"") != std::string::npos);
+    REQUIRE(out.find("\"ph\":\"B\"") != std::string::npos);
+    REQUIRE(out.find("\"ph\":\"E\"") != std::string::npos);
+    // the order's events are linked by a flow starting at submit
+    REQUIRE(out.find("\"ph\":\"s\",\"id\":7") != std::string::npos);
+    REQUIRE(out.find("\"ph\":\"t\",\"id\":7") != std::string::npos);
+
+    std::filesystem::remove("test_tracer.bin");
+}
+
+TEST_CASE("[Tracer] - rejects files that are not traces", "[tracer]") {
+    using namespace utils::trace;
+    REQUIRE_THROWS_AS(read_trace("missing_trace.bin"), std::runtime_error);
+    {
+        std::ofstream out("test_not_a_trace.bin", std::ios::binary);
+        out << "definitely not a trace file";
+    }
+    REQUIRE_THROWS_AS(read_trace("test_not_a_trace.bin"), std::runtime_error);
+    std::filesystem::remove("test_not_a_trace.bin");
+}